@@ -0,0 +1,51 @@
+#pragma once
+// Host benchmark harness shared by the bench_*.cpp sections.
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+
+struct BenchClock {
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  double ns() const { return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count(); }
+};
+
+// Keeps the optimizer from discarding a result.
+template <typename T> inline void benchKeep(const T& v){ asm volatile("" : : "r,m"(v) : "memory"); }
+
+// A check's verdict for its table cell: pass when ok, else fail, which is
+// counted. main() exits nonzero if any check failed.
+extern int gBenchFailures;
+inline const char* benchCheck(bool ok, const char* pass = "ok", const char* fail = "FAIL"){
+  if (!ok) gBenchFailures++;
+  return ok ? pass : fail;
+}
+
+// Frame f of mode m on a virtual 60 fps clock, composited the way loop() does
+// it (ripple overlay included); returns the output buffer.
+struct CRGB;
+const CRGB* benchFrame(uint8_t mode, uint32_t f);
+uint8_t benchMode(const char* name);   // mode number by /metrics name
+
+// Sections; each prints its own table.
+void benchModes();
+void benchEnvelope();
+void benchPipeline();
+void benchParams();
+void benchSegments();
+void benchPalette();
+void benchNoise();
+void benchCtrl();
+void benchPreview();
+void benchRealtime();
+void benchAssets();
+void benchSchedJson();
+void benchWifi();
+void benchPersist();
+void benchMetrics();
+void benchPower();
+void benchReplay();
+void benchMap();
+void benchEngine();
+void benchCompose();
+void benchAccum();
+void benchPace();
@@ -0,0 +1,115 @@
+// 16-bit accumulation for the firefly trails. A lone trail fading at 240/256
+// per frame, 8-bit (what Fireflies did) against 16-bit dithered, both against
+// the exact exponential: how long it lasts and how far its four-frame average
+// strays. Then the kernels at 500 pixels against the frame budget there, and
+// what the accumulator costs in RAM.
+#include <math.h>
+#include <string.h>
+#include "accum.h"
+#include "bench.h"
+#include "effects.h"
+#include "fly_envelope.h"
+#include "old_fly.h"
+#include "litset.h"
+#include "power.h"
+#include "segments.h"
+
+namespace {
+
+alignas(4) uint16_t acc[NUM_LEDS * 3];
+CRGB px[NUM_LEDS];
+LitSet lit;
+
+struct Tail { uint16_t frames; double err; uint16_t levels; uint8_t last; };
+
+// Frames until black (0: not in 400, `last` is where it stuck), mean |4-frame average - exact| in 8-bit steps while the
+// exact value is at least half a step, and distinct outputs seen on the way.
+template <typename F> Tail trail(F step){
+  const CRGB c0(255, 180, 60);
+  const float k = 240 / 256.0f;
+  Tail t = {};
+  float win[4] = {};
+  double err = 0; uint32_t samples = 0;
+  bool seen[256] = {};
+  for (uint16_t f = 0; f < 400; f++){
+    CRGB out = step(f);
+    win[f & 3] = out.r;
+    if (!seen[out.r]){ seen[out.r] = true; t.levels++; }
+    if (f >= 3 && c0.r * powf(k, f) >= 0.5f){ err += fabsf((win[0] + win[1] + win[2] + win[3]) / 4 - c0.r * powf(k, f - 1.5f)); samples++; }
+    t.last = out.r;
+    if (!out.r && !out.g && !out.b){ t.frames = f; break; }
+  }
+  t.err = err / samples;
+  return t;
+}
+
+template <typename F> double nsPer(int reps, F f){
+  BenchClock c;
+  for (int i = 0; i < reps; i++) f();
+  return c.ns() / reps;
+}
+
+}  // namespace
+
+void benchAccum(){
+  Layout l = { 1, { { LED_PIN, 500, 0 } } };
+  gPower.setLayout(l);
+
+  // ---- one trail ----
+  Tail t8 = trail([](uint16_t f){
+    if (!f){ lit.clear(); px[0] = CRGB(255, 180, 60); lit.mark(0); }
+    else litFadeVideo(px, lit, 240, 3);
+    return px[0];
+  });
+  Tail t16 = trail([](uint16_t f){
+    if (!f){ lit.clear(); memset(acc, 0, 6); accAdd(acc, lit, 0, CRGB(255, 180, 60), 0xFFFF); }
+    else accFade(acc, lit, 1, 240);
+    accOut(acc, px, lit, f);
+    return px[0];
+  });
+  printf("trail from 255 at 240/256: %-14s %14s %8s\n", "to black", "avg err (LSB)", "levels");
+  for (const Tail* t : { &t8, &t16 }){
+    char when[24];
+    if (t->frames) snprintf(when, sizeof(when), "%u frames", t->frames); else snprintf(when, sizeof(when), "never, holds %u", t->last);
+    printf("%-25s %-15s %14.2f %8u\n", t == &t8 ? "8-bit video, snap < 3" : "16-bit, dithered", when, t->err, t->levels);
+  }
+  uint16_t l8 = 0, l16 = 0;
+  for (int a = 1; a < 64; a++){ l8 += scale8_video(kFlyCurve[a], kFlyCurve[a]) != scale8_video(kFlyCurve[a - 1], kFlyCurve[a - 1]); l16 += kFlyLevel16[a] != kFlyLevel16[a - 1]; }
+  printf("fly envelope, lowest quarter: %u level steps at 8 bits, %u at 16\n", l8, l16);
+  bool ok = t16.frames && t16.err < t8.err;
+
+  // ---- kernels at 500 pixels ----
+  const uint16_t n = 500;
+  const int kN = 1000;   // at 255/256 the 16-bit values stay well above ACC_SNAP for this many passes
+  printf("%-24s %10s %10s\n", "500 px", "8-bit ns", "16-bit ns");
+  for (uint16_t stride : { 4, 1 }){
+    auto fill = [stride]{
+      lit.clear(); memset(acc, 0, sizeof(acc));
+      for (uint16_t i = 0; i < n; i += stride){ px[i] = CRGB(200, 120, 40); lit.mark(i); accAdd(acc, lit, i, CRGB(200, 120, 40), 0xFFFF); }
+    };
+    fill();
+    double ns8 = nsPer(kN, []{ litFadeVideo(px, lit, 255, 0); });
+    fill();
+    double ns16 = nsPer(kN, [n]{ accFade(acc, lit, n, 255); accOut(acc, px, lit, 0); });
+    printf("fade + out, %3u lit      %10.0f %10.0f\n", n / stride, ns8, ns16);
+  }
+
+  // ---- the mode, against the wire time it has to fit ----
+  gNumLeds = n; gDensity = 35; gSpeed = 50; gFade = 240;
+  effectsReset(1);
+  uint8_t ff = benchMode("fireflies");
+  for (int f = 0; f < 120; f++) benchFrame(ff, f);
+  const int kFrames = 2000;
+  BenchClock c;
+  for (int f = 0; f < kFrames; f++) benchFrame(ff, 120 + f);
+  double frame = c.ns() / kFrames;
+  printf("fireflies, 500 px: %.0f ns per frame, %.2f%% of its %u us wire time\n", frame, frame / 10 / layoutWireUs(l), layoutWireUs(l));
+  printf("accumulator: %zu B here (NUM_LEDS %u), %u B at the device's default 500\n",
+         sizeof(acc), NUM_LEDS, 500 * 3 * (unsigned)sizeof(uint16_t));
+  printf("trail: %s\n", benchCheck(ok, "reaches black, closer to exact"));
+
+  gNumLeds = NUM_LEDS;
+  Layout d = { 1, { { LED_PIN, NUM_LEDS, 0 } } };
+  gPower.setLayout(d);
+  effectsReset(1);
+}
@@ -0,0 +1,91 @@
+// UI assets: bytes on the wire and handler work for the old pages (the HTML
+// literal, and /wifi built with String +=; old_ui.h) vs the gzipped flash
+// asset and its 304 revalidation. Wire time is modelled for a weak AP link.
+// Handler time is measured: the copy work each path does before the bytes
+// reach the TCP stack, the old one through the shim's String.
+#include <string.h>
+#include "bench.h"
+#include "old_ui.h"
+#include "ui_assets.h"
+
+namespace {
+
+const int kMss = 1436;             // TCP payload per segment
+const double kLinkKbps = 1000;     // effective throughput at the edge of the AP
+const double kRttMs = 20;          // per-round-trip cost; slow start sends 10 segments per RTT
+
+struct Wire { int bytes, segments; double ms; };
+
+Wire wire(int header, int body){
+  Wire w;
+  w.bytes = header + body;
+  w.segments = (w.bytes + kMss - 1) / kMss;
+  int rtts = 1 + (w.segments > 10) + (w.segments > 30);
+  w.ms = rtts * kRttMs + w.bytes * 8 / kLinkKbps;
+  return w;
+}
+
+int header(const char* type, int len, bool gz, const char* etag){
+  char h[512];
+  return snprintf(h, sizeof(h), "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nContent-Length: %d\r\n%s%s%s%s"
+                  "Connection: close\r\nAccept-Ranges: none\r\n\r\n", type, len,
+                  gz ? "Content-Encoding: gzip\r\n" : "", etag ? "ETag: " : "", etag ? etag : "",
+                  etag ? "\r\nCache-Control: no-cache\r\n" : "");
+}
+
+// Old path, as AsyncBasicResponse runs it: send() turns the page into a
+// String and the response keeps its own copy. The head and the first piece
+// go out in one write; after that each ack frees two segments (delayed ACK),
+// and the next piece is cut off the front with substring(), which copies the
+// whole remainder every time. The head String is left out on both paths.
+const size_t kSndBuf = 4 * kMss;   // TCP_SND_BUF on the ESP32 core: space() for the first write
+template <typename Page> double oldHandlerNs(Page page, int head){
+  static uint8_t seg[kSndBuf];
+  const int kIter = 2000;
+  BenchClock c;
+  for (int i = 0; i < kIter; i++){
+    String content = page();
+    String rest = content;
+    size_t space = kSndBuf - head;
+    while (rest.length()){
+      String out = rest.substring(0, space);
+      rest = rest.substring(space);
+      memcpy(seg, out.c_str(), out.length());
+      space = 2 * kMss;
+    }
+    benchKeep(seg[0]);
+  }
+  return c.ns() / kIter;
+}
+
+// New path: ETag compare, then segment-sized reads straight out of flash.
+double newHandlerNs(const UiAsset& a, const char* inm){
+  static uint8_t seg[kMss];
+  const int kIter = 2000;
+  BenchClock c;
+  for (int i = 0; i < kIter; i++){
+    if (inm && strcmp(inm, a.etag) == 0){ benchKeep(i); continue; }
+    for (size_t o = 0; o < a.len; o += kMss) memcpy(seg, a.gz + o, std::min((size_t)kMss, (size_t)a.len - o));
+    benchKeep(seg[0]);
+  }
+  return c.ns() / kIter;
+}
+
+}  // namespace
+
+void benchAssets(){
+  printf("%-6s %-10s %8s %6s %8s %12s\n", "page", "path", "bytes", "segs", "wire ms", "handler ns");
+  const String ssid = "HomeNetwork", pass = "correct horse";
+  for (const UiAsset& a : kUiAssets){
+    const bool wifi = !strcmp(a.url, "/wifi");
+    auto page = [&]{ return wifi ? oldWifiPage(ssid, pass) : String(OLD_HTML); };
+    const int rawLen = page().length(), rawHead = header(a.type, rawLen, false, nullptr);
+    Wire before = wire(rawHead, rawLen);
+    Wire first = wire(header(a.type, a.len, true, a.etag), a.len);
+    Wire again = wire(snprintf(nullptr, 0, "HTTP/1.1 304 Not Modified\r\nETag: %s\r\nConnection: close\r\n\r\n", a.etag), 0);
+    printf("%-6s %-10s %8d %6d %8.1f %12.0f\n", a.url, "raw", before.bytes, before.segments, before.ms, oldHandlerNs(page, rawHead));
+    printf("%-6s %-10s %8d %6d %8.1f %12.0f\n", "", "gzip", first.bytes, first.segments, first.ms, newHandlerNs(a, nullptr));
+    printf("%-6s %-10s %8d %6d %8.1f %12.0f\n", "", "304", again.bytes, again.segments, again.ms, newHandlerNs(a, a.etag));
+  }
+  printf("(wire model: %d B segments, %.0f kbit/s, %.0f ms RTT with slow start)\n", kMss, kLinkKbps, kRttMs);
+}
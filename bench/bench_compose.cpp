@@ -0,0 +1,181 @@
+// Layer compositor. The word kernels must give the per-channel results of
+// the byte loops they replace, for every byte pair and every strip length's
+// tail, and be quicker; max is the byte loop itself. Each overlay blend mode
+// must give its per-channel result over the base in a composited frame. Then a wave -> swarm crossfade at 10000 pixels with
+// rings on top, run free and under a budget below what it costs: throttling
+// must bring the frame time under the budget without touching the shown mode.
+// Best of three runs each, the host being noisy at this scale.
+#include <string.h>
+#include "bench.h"
+#include "compositor.h"
+#include "effects.h"
+#include "litset.h"
+#include "power.h"
+#include "rng.h"
+
+namespace {
+
+// ---- per-channel references ----
+void refAdd(CRGB* d, const CRGB* s, uint16_t n){ for (uint16_t i = 0; i < n; i++) d[i] += s[i]; }
+void refMax(CRGB* d, const CRGB* s, uint16_t n){
+  for (uint16_t i = 0; i < n; i++) for (uint8_t c = 0; c < 3; c++) d[i][c] = d[i][c] > s[i][c] ? d[i][c] : s[i][c];
+}
+void refAlpha(CRGB* d, const CRGB* a, const CRGB* b, uint16_t n, uint16_t w){
+  for (uint16_t i = 0; i < n; i++) for (uint8_t c = 0; c < 3; c++) d[i][c] = (a[i][c] * (256 - w) + b[i][c] * w) >> 8;
+}
+
+alignas(4) CRGB a[NUM_LEDS], b[NUM_LEDS], x[NUM_LEDS], y[NUM_LEDS];
+
+void noise(CRGB* px, uint16_t n, Rng& r){ for (uint16_t i = 0; i < n; i++) px[i] = CRGB(r.u8(), r.u8(), r.u8()); }
+
+// Every (a, b) byte pair: a runs through 0..255 in each 256 bytes, b steps
+// once per 256; three passes reach every b.
+bool allPairs(){
+  const uint16_t n = 9984;   // 117 x 256 bytes
+  bool ok = true;
+  for (uint32_t base = 0; base < 256; base += 117){
+    for (uint32_t k = 0; k < (uint32_t)n * 3; k++){ ((uint8_t*)a)[k] = (uint8_t)k; ((uint8_t*)b)[k] = (uint8_t)((k >> 8) + base); }
+    memcpy(x, a, n * 3); memcpy(y, a, n * 3); blendAdd(x, b, n); refAdd(y, b, n); ok &= !memcmp(x, y, n * 3);
+    memcpy(x, a, n * 3); memcpy(y, a, n * 3); blendMax(x, b, n); refMax(y, b, n); ok &= !memcmp(x, y, n * 3);
+    for (uint16_t w : { 0, 1, 77, 128, 255, 256 }){ blendAlpha(x, a, b, n, w); refAlpha(y, a, b, n, w); ok &= !memcmp(x, y, n * 3); }
+  }
+  return ok;
+}
+
+// Lengths 1..67 for the byte tail, and a sparse lit set for blendAddLit.
+bool tails(){
+  Rng r; r.seed(3);
+  bool ok = true;
+  for (uint16_t n = 1; n < 68; n++){
+    noise(a, n + 1, r); noise(b, n + 1, r);
+    memcpy(x, a, (n + 1) * 3); memcpy(y, a, (n + 1) * 3);
+    blendAdd(x, b, n); refAdd(y, b, n);
+    ok &= !memcmp(x, y, (n + 1) * 3);   // and the pixel past n untouched
+  }
+  static LitSet lit;
+  lit.clear();
+  const uint16_t n = 9999;
+  noise(a, n, r);
+  fill_solid(b, NUM_LEDS, CRGB::Black);
+  for (int k = 0; k < 200; k++){ uint16_t i = r.below(n); b[i] = CRGB(r.u8(), r.u8(), r.u8()); lit.mark(i); }
+  memcpy(x, a, n * 3); memcpy(y, a, n * 3);
+  blendAddLit(x, b, lit, n); refAdd(y, b, n);
+  ok &= !memcmp(x, y, n * 3);
+  memcpy(x, a, n * 3); memcpy(y, a, n * 3);
+  blendMaxLit(x, b, lit, n); refMax(y, b, n);
+  return ok && !memcmp(x, y, n * 3);
+}
+
+// Swarm with rings going off, the rings put on by each mode in turn; out
+// against the reference op over leds[] and the ring layer.
+bool overlays(){
+  alignas(4) static CRGB out[NUM_LEDS];
+  const uint16_t n = 2000;
+  const uint8_t swarm = benchMode("swarm");
+  bool ok = true;
+  for (BlendMode m : { BLEND_ADD, BLEND_MAX, BLEND_ALPHA }){
+    gNumLeds = n; gDensity = 60; gSpeed = 60;
+    effectsReset(1);
+    gComp.overlay(m, 96);
+    for (uint32_t f = 0; f < 40; f++){
+      if (f % 5 == 0) triggerRipple();
+      gMode = swarm; gFrameMs = f * 1000 / 60;
+      gComp.frame(out, 1 / 60.0f);
+      memcpy(y, leds, n * 3);
+      const CRGB* r = gComp.rings().px;
+      if (m == BLEND_ADD) refAdd(y, r, n); else if (m == BLEND_MAX) refMax(y, r, n); else refAlpha(y, leds, r, n, 96);
+      ok &= !memcmp(out, y, n * 3);
+    }
+  }
+  gComp.overlay(BLEND_ADD);
+  gNumLeds = NUM_LEDS;
+  effectsReset(1);
+  return ok;
+}
+
+template <typename F> double nsPer(int reps, F f){
+  BenchClock c;
+  for (int i = 0; i < reps; i++){ f(); benchKeep(x[i % 7]); }
+  return c.ns() / reps;
+}
+
+struct Run { double meanUs, maxUs; uint32_t skipped; uint8_t divBase, divRings; uint32_t estUs, costUs[Compositor::L_COUNT]; };
+
+// Wave, then swarm brought in over 2 s with rings going off every few frames.
+// Wave is the dearer of the two, so it is what the budget has to give.
+Run fade(uint32_t budgetUs){
+  alignas(4) static CRGB out[NUM_LEDS];
+  gNumLeds = NUM_LEDS; gDensity = 60; gSpeed = 60;
+  effectsReset(1);
+  gComp.setBudget(budgetUs);
+  Run r = {};
+  const uint8_t swarm = benchMode("swarm"), wave = benchMode("wave");
+  for (uint32_t f = 0; f < 60; f++){ if (f % 4 == 0) triggerRipple(); benchFrame(wave, f); }
+  gComp.crossfade(2000);
+  double sum = 0;
+  uint32_t frames = 0;
+  for (uint32_t f = 60; gComp.fading() || f == 60; f++, frames++){
+    if (f % 4 == 0) triggerRipple();
+    gMode = swarm; gFrameMs = f * 1000 / 60;
+    BenchClock c;
+    gComp.frame(out, 1 / 60.0f);
+    double us = c.ns() / 1000;
+    sum += us;
+    if (frames >= 20 && us > r.maxUs) r.maxUs = us;   // once the costs have settled
+    if (frames == 60){
+      r.divBase = gComp.divisor(Compositor::L_BASE); r.divRings = gComp.divisor(Compositor::L_RINGS); r.estUs = gComp.estimateUs();
+      for (uint8_t l = 0; l < Compositor::L_COUNT; l++) r.costUs[l] = gComp.costUs(l);
+    }
+  }
+  r.meanUs = sum / frames;
+  r.skipped = gComp.skipped;
+  return r;
+}
+
+Run best(uint32_t budgetUs){
+  Run r = fade(budgetUs);
+  for (int i = 0; i < 2; i++){ Run t = fade(budgetUs); if (t.meanUs < r.meanUs) r = t; }
+  return r;
+}
+
+}  // namespace
+
+void benchCompose(){
+  printf("kernels = per-channel loops: every byte pair %s, tails and lit runs %s\n",
+         benchCheck(allPairs()), benchCheck(tails()));
+  printf("rings over swarm, add / max / alpha 96 = per-channel ops: %s\n", benchCheck(overlays()));
+
+  const uint16_t n = 10000;
+  Rng r; r.seed(9);
+  noise(a, n, r); noise(b, n, r);
+  static LitSet lit;
+  lit.clear();
+  for (uint16_t i = 0; i < n; i += 97) lit.mark(i);   // ~100 lit, as a few rings leave it
+  const int kN = 2000;
+  printf("%-14s %10s %10s %8s\n", "10000 px", "loop ns", "kernel ns", "speedup");
+  struct K { const char* name; double loop, word; } k[] = {
+    { "add",   nsPer(kN, []{ refAdd(x, b, n); }),               nsPer(kN, []{ blendAdd(x, b, n); }) },
+    { "max, lit runs", nsPer(kN, []{ refMax(x, b, n); }),       nsPer(kN, [&]{ blendMaxLit(x, b, lit, n); }) },
+    { "alpha", nsPer(kN, []{ refAlpha(x, a, b, n, 100); }),     nsPer(kN, []{ blendAlpha(x, a, b, n, 100); }) },
+    { "add, lit runs", nsPer(kN, []{ refAdd(x, b, n); }),       nsPer(kN, [&]{ blendAddLit(x, b, lit, n); }) },
+  };
+  for (const K& e : k) printf("%-14s %10.0f %10.0f %7.1fx\n", e.name, e.loop, e.word, e.loop / e.word);
+  BenchClock sc;
+  for (int i = 0; i < kN; i++){ powerScan(x, n); benchKeep(gPower.seg[0]); }
+  printf("power rescan of a blended frame: %.0f ns\n", sc.ns() / kN);
+
+  // a budget the shown mode fits with the other two at half rate
+  Run freeRun = best(0);
+  const uint32_t* c = freeRun.costUs;
+  uint32_t budget = c[Compositor::L_FADE] + c[Compositor::L_MIX] + (c[Compositor::L_BASE] + c[Compositor::L_RINGS]) / 2;
+  Run paced = best(budget);
+  printf("wave -> swarm over 2 s, rings on top, 10000 px; layer us: wave %u, swarm %u, rings %u, blend %u\n",
+         c[Compositor::L_BASE], c[Compositor::L_FADE], c[Compositor::L_RINGS], c[Compositor::L_MIX]);
+  printf("%-10s %9s %9s %9s %9s %9s\n", "budget", "mean us", "max us", "est us", "div", "skipped");
+  printf("%-10s %9.0f %9.0f %9u %5u/%-3u %9u\n", "none", freeRun.meanUs, freeRun.maxUs, freeRun.estUs, freeRun.divBase, freeRun.divRings, freeRun.skipped);
+  printf("%-10u %9.0f %9.0f %9u %5u/%-3u %9u %s\n", budget, paced.meanUs, paced.maxUs, paced.estUs, paced.divBase, paced.divRings, paced.skipped,
+         benchCheck(paced.skipped && (paced.estUs <= budget || paced.divBase == COMP_MAX_DIV), paced.estUs <= budget ? "in budget" : "at the floor"));
+
+  gComp.setBudget(0);
+  effectsReset(1);
+}
@@ -0,0 +1,289 @@
+// Control channel: decode cost, then a hue slider drag replayed over loopback
+// TCP against a stand-in for the device's web server. The old page sent a
+// fetch('/set?...') with all nine params per input event, on a connection of
+// its own (the server closes each one), up to six at a time like a browser.
+// The new one coalesces into one binary WebSocket frame per 60 Hz paint, and
+// holds back while the socket still has unsent bytes. Bytes are what the
+// client's send() and recv() moved; latency is from the input event to the
+// stand-in applying that value or a newer one.
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <string.h>
+#include <arpa/inet.h>
+#include <linux/sockios.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "bench.h"
+#include "ctrl_proto.h"
+#include "effects.h"
+
+namespace {
+
+const uint16_t kPort = 28080;   // unprivileged, loopback only
+const int kBrowserConns = 6;    // per-host connection limit in browsers
+
+double nowMs(){ return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+int dial(){
+  int fd = socket(AF_INET, SOCK_STREAM, 0), one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  sockaddr_in a = {};
+  a.sin_family = AF_INET; a.sin_port = htons(kPort); a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (connect(fd, (sockaddr*)&a, sizeof(a))){ close(fd); return -1; }
+  return fd;
+}
+
+// ---- device stand-in ----
+// /set answers the way ESPAsyncWebServer does (200 "ok", connection closed);
+// /ws upgrades and takes masked binary frames through ctrlDecode. Each
+// applied hue is logged as the newest drag event it carries (the hue is the
+// event index mod 256; an older value landing late is not progress).
+struct Applied { double ms; uint32_t event; };
+
+class StandIn {
+public:
+  std::vector<Applied> log;
+
+  bool begin(){
+    mListen = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(mListen, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in a = {};
+    a.sin_family = AF_INET; a.sin_port = htons(kPort); a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return !bind(mListen, (sockaddr*)&a, sizeof(a)) && !listen(mListen, 64);
+  }
+  void start(){ log.clear(); mLast = 0; mStop = false; mThread = std::thread([this]{ run(); }); }
+  void stop(){ mStop = true; mThread.join(); for (Conn& c : mConns) close(c.fd); mConns.clear(); }
+  ~StandIn(){ if (mListen >= 0) close(mListen); }
+
+private:
+  struct Conn { int fd; bool ws; std::string in; };
+  int mListen = -1;
+  std::atomic<bool> mStop{false};
+  std::thread mThread;
+  std::vector<Conn> mConns;
+  Params mParams = {};
+  uint32_t mLast = 0;
+
+  void applied(uint8_t hue){
+    uint8_t d = (uint8_t)(hue - (uint8_t)mLast);
+    if (d >= 128 || (!d && !log.empty())) return;
+    mLast += d;
+    log.push_back({ nowMs(), mLast });
+  }
+
+  void run(){
+    while (!mStop){
+      std::vector<pollfd> fds(1, pollfd{ mListen, POLLIN, 0 });
+      for (Conn& c : mConns) fds.push_back(pollfd{ c.fd, POLLIN, 0 });
+      if (poll(fds.data(), fds.size(), 5) <= 0) continue;
+      if (fds[0].revents & POLLIN){ int fd = accept(mListen, nullptr, nullptr); if (fd >= 0) mConns.push_back({ fd, false, "" }); }
+      for (size_t k = fds.size() - 1; k >= 1; k--){
+        if (!fds[k].revents) continue;
+        Conn& c = mConns[k - 1];
+        char b[2048];
+        ssize_t r = recv(c.fd, b, sizeof(b), 0);
+        if (r <= 0 || !serve(c, b, r)){ close(c.fd); mConns.erase(mConns.begin() + (k - 1)); }
+      }
+    }
+  }
+
+  // false: done with the connection
+  bool serve(Conn& c, const char* b, ssize_t r){
+    c.in.append(b, r);
+    if (!c.ws){
+      size_t end = c.in.find("\r\n\r\n");
+      if (end == std::string::npos) return true;
+      if (c.in.find("Upgrade: websocket") != std::string::npos){
+        static const char kSwitch[] = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                                      "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n\r\n";
+        send(c.fd, kSwitch, sizeof(kSwitch) - 1, 0);
+        c.ws = true; c.in.erase(0, end + 4);
+        return true;
+      }
+      size_t h = c.in.find("&hue=");
+      if (h != std::string::npos && h < end) applied((uint8_t)atoi(c.in.c_str() + h + 5));
+      static const char kOk[] = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 2\r\nConnection: close\r\n\r\nok";
+      send(c.fd, kOk, sizeof(kOk) - 1, 0);
+      return false;
+    }
+    // client frames: FIN + binary, masked, payload under 126 bytes
+    while (c.in.size() >= 6){
+      size_t len = (uint8_t)c.in[1] & 0x7F;
+      if (c.in.size() < 6 + len) break;
+      uint8_t payload[125];
+      for (size_t i = 0; i < len; i++) payload[i] = (uint8_t)c.in[6 + i] ^ (uint8_t)c.in[2 + (i & 3)];
+      Params p = mParams;
+      CtrlResult res = ctrlDecode(payload, len, p);
+      if (res.ok){ if (p.hue != mParams.hue || log.empty()) applied(p.hue); mParams = p; }
+      c.in.erase(0, 6 + len);
+    }
+    return true;
+  }
+};
+
+// ---- clients ----
+struct Drag { uint32_t messages, conns, bytesOut, bytesIn, late; double meanMs, worstMs, meanRttMs; };
+
+// Event e's latency: the first log entry carrying e or newer.
+void latency(const std::vector<double>& events, const std::vector<Applied>& log, Drag& d){
+  size_t k = 0;
+  double sum = 0;
+  uint32_t n = 0;
+  for (uint32_t e = 0; e < events.size(); e++){
+    while (k < log.size() && log[k].event < e) k++;
+    if (k == log.size()){ d.late++; continue; }
+    double lag = log[k].ms - events[e];
+    sum += lag; n++;
+    if (lag > d.worstMs) d.worstMs = lag;
+  }
+  d.meanMs = n ? sum / n : 0;
+}
+
+std::string setRequest(uint8_t hue){
+  char q[160];
+  snprintf(q, sizeof(q), "GET /set?mode=2&bright=90&density=40&speed=70&hue=%u&sat=200&life=50&fade=240&drift=1 HTTP/1.1\r\n", hue);
+  return std::string(q) +
+    "Host: 192.168.4.1\r\nConnection: keep-alive\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0.0.0 Safari/537.36\r\n"
+    "Accept: */*\r\nReferer: http://192.168.4.1/\r\nAccept-Encoding: gzip, deflate\r\nAccept-Language: en-US,en;q=0.9\r\n\r\n";
+}
+
+// One GET per event, six connections' worth of workers.
+Drag viaGet(StandIn& dev, int hz, double seconds){
+  Drag d = {};
+  std::vector<double> events;
+  std::deque<uint32_t> queue;
+  std::mutex m;
+  std::condition_variable cv;
+  bool done = false;
+  double rttSum = 0;
+  std::vector<std::thread> workers;
+  for (int w = 0; w < kBrowserConns; w++) workers.emplace_back([&]{
+    for (;;){
+      uint32_t e;
+      { std::unique_lock<std::mutex> l(m);
+        cv.wait(l, [&]{ return done || !queue.empty(); });
+        if (queue.empty()) return;
+        e = queue.front(); queue.pop_front(); }
+      double t0 = nowMs();
+      int fd = dial();
+      if (fd < 0) continue;
+      std::string req = setRequest((uint8_t)e);
+      ssize_t out = send(fd, req.data(), req.size(), 0), in = 0, r;
+      char b[512];
+      while ((r = recv(fd, b, sizeof(b), 0)) > 0) in += r;
+      close(fd);
+      std::lock_guard<std::mutex> l(m);
+      d.messages++; d.conns++; d.bytesOut += out; d.bytesIn += in; rttSum += nowMs() - t0;
+    }
+  });
+  dev.start();
+  const double t0 = nowMs(), step = 1000.0 / hz;
+  for (uint32_t e = 0; e < (uint32_t)(seconds * hz); e++){
+    while (nowMs() < t0 + e * step) std::this_thread::yield();
+    events.push_back(nowMs());
+    { std::lock_guard<std::mutex> l(m); queue.push_back(e); }
+    cv.notify_one();
+  }
+  { std::lock_guard<std::mutex> l(m); done = true; }
+  cv.notify_all();
+  for (std::thread& w : workers) w.join();
+  dev.stop();
+  d.meanRttMs = d.messages ? rttSum / d.messages : 0;
+  latency(events, dev.log, d);
+  return d;
+}
+
+// The page's queueParam()/flush(): latest value per field, sent on the next
+// paint unless the socket still holds unsent bytes (bufferedAmount).
+Drag viaWs(StandIn& dev, int hz, double seconds){
+  Drag d = {};
+  std::vector<double> events;
+  dev.start();
+  int fd = dial();
+  if (fd < 0){ dev.stop(); return d; }
+  static const char kUpgrade[] = "GET /ws HTTP/1.1\r\nHost: 192.168.4.1\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                                 "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n";
+  d.bytesOut += send(fd, kUpgrade, sizeof(kUpgrade) - 1, 0);
+  std::string hs;
+  char b[512];
+  while (hs.find("\r\n\r\n") == std::string::npos){ ssize_t r = recv(fd, b, sizeof(b), 0); if (r <= 0) break; hs.append(b, r); }
+  d.bytesIn += hs.size(); d.conns = 1;
+
+  int dirty = -1;   // hue waiting for the next paint
+  const double t0 = nowMs(), step = 1000.0 / hz, paint = 1000.0 / 60;
+  const uint32_t n = (uint32_t)(seconds * hz);
+  uint32_t e = 0, frame = 1;
+  double rttSum = 0;
+  while (e < n || dirty >= 0){
+    double tEvent = e < n ? t0 + e * step : 1e300, tPaint = t0 + frame * paint;
+    while (nowMs() < (tEvent < tPaint ? tEvent : tPaint)) std::this_thread::yield();
+    if (tEvent <= tPaint){ events.push_back(nowMs()); dirty = (uint8_t)e++; continue; }
+    frame++;
+    if (dirty < 0) continue;
+    int queued = 0;
+    ioctl(fd, SIOCOUTQNSD, &queued);   // not yet sent, as bufferedAmount counts
+    if (queued > 0) continue;   // keep coalescing
+    const uint8_t payload[2] = { CF_HUE, (uint8_t)dirty }, mask[4] = { 0x12, 0x34, 0x56, 0x78 };
+    uint8_t f[8] = { 0x82, 0x80 | 2, mask[0], mask[1], mask[2], mask[3], (uint8_t)(payload[0] ^ mask[0]), (uint8_t)(payload[1] ^ mask[1]) };
+    double ts = nowMs();
+    d.bytesOut += send(fd, f, sizeof(f), 0);
+    rttSum += nowMs() - ts;
+    d.messages++;
+    dirty = -1;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));   // last frame lands
+  close(fd);
+  dev.stop();
+  d.meanRttMs = d.messages ? rttSum / d.messages : 0;
+  latency(events, dev.log, d);
+  return d;
+}
+
+}  // namespace
+
+void benchCtrl(){
+  // decode throughput on a full nine-field frame
+  const uint8_t frame[] = { CF_MODE, 2, CF_BRIGHT, 90, CF_DENSITY, 40, CF_SPEED, 70, CF_HUE, 12,
+                            CF_SAT, 200, CF_LIFE, 50, CF_FADE, 240, CF_DRIFT, 1 };
+  Params p = {};
+  const int kIter = 2000000;
+  uint32_t applied = 0;
+  BenchClock c;
+  for (int i = 0; i < kIter; i++){ p.hue = (uint8_t)i; applied += ctrlDecode(frame, sizeof(frame), p).params; }
+  double ns = c.ns() / kIter;
+  benchKeep(p); benchKeep(applied);
+  printf("decode 9-field frame: %.1f ns (%.0f frames/s)\n", ns, 1e9 / ns);
+
+  CtrlResult bad = ctrlDecode((const uint8_t*)"\x01\x10\x7f\x00", 4, p);
+  printf("unknown field rejected: %s\n", benchCheck(!bad.ok && bad.params == 1));
+  const uint8_t past[] = { CF_BRIGHT, 90, CF_MODE, MODE_COUNT };
+  bad = ctrlDecode(past, sizeof(past), p);
+  printf("mode past the last rejected: %s\n", benchCheck(!bad.ok && bad.params == 1));
+
+  static StandIn dev;
+  if (!dev.begin()){ printf("cannot bind loopback port, drag replay skipped\n"); return; }
+  printf("%8s %-10s %6s %6s %9s %8s %9s %9s %9s %6s\n", "input Hz", "path", "msgs", "conns", "bytes out", "bytes in", "mean ms", "worst ms", "send ms", "late");
+  const int kRates[] = { 60, 120, 250 };
+  bool ok = true;
+  for (int hz : kRates){
+    Drag g = viaGet(dev, hz, 1.0), w = viaWs(dev, hz, 1.0);
+    printf("%8d %-10s %6u %6u %9u %8u %9.2f %9.2f %9.3f %6u\n", hz, "GET/input", g.messages, g.conns, g.bytesOut, g.bytesIn, g.meanMs, g.worstMs, g.meanRttMs, g.late);
+    printf("%8s %-10s %6u %6u %9u %8u %9.2f %9.2f %9.3f %6u\n", "", "ws/paint", w.messages, w.conns, w.bytesOut, w.bytesIn, w.meanMs, w.worstMs, w.meanRttMs, w.late);
+    ok &= !w.late && w.messages <= 61 && w.bytesOut * 10 < g.bytesOut;
+  }
+  printf("(send ms: GET request to closed response; ws frame send() call. Loopback has no link\n"
+         " latency or device-side request cost, which is where the GET path's per-connection\n"
+         " work goes on the ESP32)\n");
+  printf("ws path: every value lands, <= 1 frame per paint, < 1/10 the bytes: %s\n", benchCheck(ok));
+}
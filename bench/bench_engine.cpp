@@ -0,0 +1,211 @@
+// Effect engine against the shape it replaced: free functions reading the
+// globals, each with its own file-static state, picked by a switch. All six
+// modes are kept here in that form, as they were before the engine apart
+// from the names and the later output changes the engine modes picked up
+// (the firefly accumulator), so both sides draw the same thing. Each pair
+// must produce the same pixels, and the engine should be no slower apart from
+// a fixed ~30 ns a frame: the Params snapshot and the ring ageing pass, which
+// the engine side takes for every mode. Ripples get a ring every 20 frames on
+// both sides. Best of several runs, the two
+// sides interleaved so clock drift hits both alike.
+#include <math.h>
+#include <string.h>
+#include "accum.h"
+#include "bench.h"
+#include "effects.h"
+#include "litset.h"
+#include "noise_row.h"
+#include "palette.h"
+#include "params.h"
+#include "power.h"
+#include "rng.h"
+
+namespace {
+
+// ---- before ----
+#define FLY_NONE 0xFFFF
+FlyEnv   flyEnv[MAX_FIREFLIES];
+uint16_t flyIdx[MAX_FIREFLIES];
+uint8_t  flyHue[MAX_FIREFLIES];
+uint16_t flyNext[MAX_FIREFLIES];
+uint16_t flyFree = FLY_NONE;
+uint16_t flyActive[MAX_FIREFLIES];
+uint16_t flyCount = 0;
+alignas(4) uint16_t flyAcc[NUM_LEDS * 3];
+uint32_t flyTick = 0;
+
+void spawnFly(){
+  uint16_t s = flyFree;
+  if (s == FLY_NONE) return;
+  flyFree = flyNext[s];
+  Rng& r = gRng[RNG_FLY];
+  flyIdx[s] = r.below(gNumLeds);
+  uint32_t rise = r.range(FLY_Q16(0.15), FLY_Q16(0.35)), hold = r.range(FLY_Q16(0.05), FLY_Q16(0.25));
+  flyEnvInit(flyEnv[s], rise, hold, r.range(FLY_Q16(0.25), FLY_Q16(0.55)));
+  flyHue[s] = gAutoHueDrift ? (gHueBase + r.below(12)) : gHueBase;
+  flyActive[flyCount++] = s;
+}
+void setupFireflies(){
+  flyCount = 0;
+  memset(flyAcc, 0, sizeof(flyAcc)); flyTick = 0;
+  for(int i=0;i<MAX_FIREFLIES;i++) flyNext[i] = i+1 < MAX_FIREFLIES ? i+1 : FLY_NONE;
+  flyFree = 0;
+}
+void stepFireflies(float dt){
+  uint16_t cap = min<uint16_t>(MAX_FIREFLIES, gNumLeds / 4);
+  uint16_t target = (uint32_t)gDensity * cap / 100;
+  for(uint16_t s=0, budget=4+target/64; s<budget && flyCount<target; s++) spawnFly();
+  accFade(flyAcc, gLit, gNumLeds, gFade);
+  float lifeScale = 0.6f + 1.6f * (1.0f - (gLifespan / 100.0f));
+  float speedScalar = (0.08f + 0.6f*(gSpeed/100.0f)) * lifeScale;
+  uint32_t step = (uint32_t)(dt * speedScalar * 65536.0f);
+  const CRGB* hue = palHue();
+  for (uint16_t k = 0; k < flyCount; ){
+    uint16_t s = flyActive[k];
+    uint8_t a;
+    if (!flyEnvStage(flyEnv[s], step, a)){
+      flyNext[s] = flyFree; flyFree = s;
+      flyActive[k] = flyActive[--flyCount];
+      continue;
+    }
+    accAdd(flyAcc, gLit, flyIdx[s], hue[flyHue[s]], kFlyLevel16[a]);
+    k++;
+  }
+  accOut(flyAcc, leds, gLit, flyTick++);
+  if (gAutoHueDrift && (gFrameMs & 1023) < 16) gHueBase++;
+}
+
+void stepSync(float){
+  uint16_t bpm88 = (10 + gSpeed/2) << 8;
+  uint8_t beat = 10 + scale8(sin8((uint16_t)((gFrameMs * bpm88 * 280) >> 16) >> 8), 245);
+  powerFill(leds, gNumLeds, palVal()[beat]); gLit.markAll(gNumLeds);
+}
+void stepWave(float t){
+  const CRGB* pal = palVal();
+  powerFillWith(leds, gNumLeds, [&](uint16_t i){
+    uint8_t b1=sin8((i*2)+(t*(2+gSpeed/2))); uint8_t b2=sin8((i*3)-(t*(1+gSpeed/3)));
+    return pal[qadd8(b1/2,b2/2)];
+  });
+  gLit.markAll(gNumLeds);
+}
+
+void stepTwinkle(float){
+  litFadeToBlackBy(leds, gLit, 12);
+  Rng& r = gRng[RNG_TWINKLE];
+  if(r.u8() < gDensity){ int i = r.below(gNumLeds); uint8_t h = gHueBase + r.below(18); powerAdd(leds, gLit, i, palDim(palHue()[h], 160 + r.below(95))); }
+}
+
+NoiseCache swarmNoise;
+uint8_t swarmN[NUM_LEDS];
+void stepSwarm(float t){
+  const CRGB* pal = palSwarm();
+  uint16_t y = (uint16_t)(uint32_t)(t* (10+gSpeed));
+  swarmNoise.sample(swarmN, gNumLeds, 0, 4, y);
+  powerFillWith(leds, gNumLeds, [&](uint16_t i){ return pal[swarmN[i]]; });
+  gLit.markAll(gNumLeds);
+}
+
+Ripple rip[MAX_RIPPLES];
+void triggerOld(int center){ for(auto &r:rip) if(!r.on){ r.center=(center>=0 && center<gNumLeds) ? center : gRng[RNG_RIPPLE].below(gNumLeds); r.age=0; r.speed=0.9f+(gSpeed/140.0f); r.on=true; break; } }
+inline void ringPixel(int i, const CRGB& c, uint8_t cover){
+  if (i < 0 || i >= gNumLeds || !cover) return;
+  CRGB px = c; px.nscale8_video(cover);
+  powerAdd(leds, gLit, i, px);
+}
+void renderRipples(float dt){
+  for(auto &r:rip){
+    if(!r.on) continue;
+    r.age += dt*r.speed;
+    float radius = r.age * (8 + gDensity/2.0f);
+    if(radius>gNumLeds){ r.on=false; continue; }
+    CRGB c = palVal()[(uint8_t)(255.0f * (1.0f - (radius/gNumLeds)))];
+    float inner = radius - 2;
+    for(int d = max(0, (int)floorf(inner + 0.5f)); d <= (int)ceilf(radius - 0.5f); d++){
+      float cover = min(d + 0.5f, radius) - max(d - 0.5f, inner);
+      if (cover <= 0) continue;
+      uint8_t w = (uint8_t)(min(cover, 1.0f) * 255.0f);
+      ringPixel(r.center + d, c, w);
+      if (d) ringPixel(r.center - d, c, w);
+    }
+  }
+}
+void stepRipples(float dt){
+  litFadeToBlackBy(leds, gLit, 18);
+  renderRipples(dt);
+}
+
+void oldModes(float dt){
+  float t = gFrameMs / 1000.0f;
+  switch(gMode){
+    case 0: stepFireflies(dt); break;
+    case 1: stepSync(t); break;
+    case 2: stepWave(t); break;
+    case 3: stepTwinkle(dt); break;
+    case 4: stepSwarm(t); break;
+    case 5: stepRipples(dt); break;
+  }
+}
+void oldReset(){
+  setupFireflies();
+  swarmNoise.valid = false;
+  for (auto& r : rip) r.on = false;
+}
+
+// ---- after ----
+// The rings age in the compositor before the mode draws; this is that step.
+void engineModes(float dt){
+  const Params p = paramsLive();
+  gRipples.advance(p, dt, gNumLeds);
+  gModes.frame(gMode, Pixels{ leds, gNumLeds, &gLit }, p, FrameTime{ gFrameMs, gFrameMs / 1000.0f, dt });
+}
+
+uint32_t hashStrip(uint16_t n){
+  uint32_t h = 2166136261u;
+  const uint8_t* p = (const uint8_t*)leds;
+  for (uint32_t i = 0; i < (uint32_t)n * 3; i++){ h ^= p[i]; h *= 16777619u; }
+  return h;
+}
+
+const int kFrames = 300, kRuns = 7;
+
+double run(bool engine, uint8_t mode, uint32_t& hash){
+  effectsReset(1);
+  oldReset();
+  gMode = mode; gHueBase = 45;
+  const float dt = 1 / 60.0f;
+  BenchClock c;
+  for (int f = 0; f < kFrames; f++){
+    gFrameMs = f * 1000 / 60;
+    if (f % 20 == 0){ if (engine) gRipples.trigger(-1, gNumLeds, gSpeed); else triggerOld(-1); }
+    if (engine) engineModes(dt); else oldModes(dt);
+  }
+  double ns = c.ns() / kFrames;
+  hash = hashStrip(gNumLeds);
+  return ns;
+}
+
+}  // namespace
+
+void benchEngine(){
+  gDensity = 35; gSpeed = 80; gHueBase = 45; gSaturation = 200;
+  printf("%-9s %6s %12s %12s %8s %s\n", "mode", "leds", "switch ns", "engine ns", "ratio", "pixels");
+  bool same = true;
+  for (uint8_t m = 0; m < MODE_COUNT; m++){
+    for (uint16_t n : { 500, 2000, 10000 }){
+      Layout l = { 1, { { LED_PIN, n, 0 } } };
+      gNumLeds = n; gPower.setLayout(l);
+      double best[2] = { 1e18, 1e18 };
+      uint32_t h[2];
+      for (int r = 0; r < kRuns; r++)
+        for (int e = 0; e < 2; e++){ double ns = run(e, m, h[e]); if (ns < best[e]) best[e] = ns; }
+      same &= h[0] == h[1];
+      printf("%-9s %6u %12.0f %12.0f %7.2fx %s\n", modeName(m), n, best[0], best[1], best[0] / best[1], benchCheck(h[0] == h[1], "same"));
+    }
+  }
+  printf("all %u modes pixel-identical: %s\n", MODE_COUNT, benchCheck(same));
+  printf("Modes: %u types, %zu B of effect state\n", MODE_COUNT, sizeof(Modes));
+  Layout l = { 1, { { LED_PIN, NUM_LEDS, 0 } } };
+  gNumLeds = NUM_LEDS; gPower.setLayout(l);
+  gHueBase = 45;
+  effectsReset(1);
+}
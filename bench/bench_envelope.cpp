@@ -0,0 +1,96 @@
+// Firefly envelope: old per-fly float math vs the Q16 engine + curve LUT.
+#include <stdlib.h>
+#include <algorithm>
+#include "bench.h"
+#include "fly_envelope.h"
+#include "old_fly.h"
+
+namespace {
+
+// The pre-Q16 update, kept verbatim as the baseline.
+struct FloatFly { float phase, rise, fall, hold; bool active; };
+
+inline bool floatStep(FloatFly& f, float dt, uint8_t gSpeed, uint8_t gLifespan, uint8_t& v){
+  float lifeScale = 0.6f + 1.6f * (1.0f - (gLifespan / 100.0f));
+  float speedScalar = (0.08f + 0.6f*(gSpeed/100.0f)) * lifeScale;
+  f.phase += dt * speedScalar;
+  float total = f.rise + f.hold + f.fall;
+  if (f.phase >= total) return false;
+  float x=f.phase, a=0.0f;
+  if (x < f.rise)               a = x / f.rise;
+  else if (x < f.rise + f.hold) a = 1.0f;
+  else                          a = 1.0f - ((x - (f.rise + f.hold)) / f.fall);
+  v = (uint8_t)((a*a) * 255);
+  return true;
+}
+
+uint32_t lcg = 1;
+inline uint16_t rnd(uint16_t a, uint16_t b){ lcg = lcg * 1664525u + 1013904223u; return a + (lcg >> 16) % (b - a + 1); }
+
+const float kDt = 1.0f / 60.0f;
+const uint8_t kSpeed = 50, kLife = 50;
+const int kFrames = 4000;
+
+double runFloat(int n, uint32_t& sum){
+  static FloatFly flies[4096];
+  lcg = 1;
+  for (int i = 0; i < n; i++) flies[i] = { 0, rnd(9830, 22937) / 65536.0f, rnd(16384, 36044) / 65536.0f, rnd(3276, 16384) / 65536.0f, true };
+  BenchClock c;
+  for (int f = 0; f < kFrames; f++){
+    for (int i = 0; i < n; i++){
+      uint8_t v;
+      if (!floatStep(flies[i], kDt, kSpeed, kLife, v)){ flies[i].phase = 0; continue; }
+      sum += v;
+    }
+  }
+  return c.ns() / ((double)kFrames * n);
+}
+
+double runQ16(int n, uint32_t& sum){
+  static FlyEnv flies[4096];
+  lcg = 1;
+  for (int i = 0; i < n; i++){ uint16_t r = rnd(9830, 22937), fa = rnd(16384, 36044), h = rnd(3276, 16384); flyEnvInit(flies[i], r, h, fa); }
+  float lifeScale = 0.6f + 1.6f * (1.0f - (kLife / 100.0f));
+  uint32_t step = (uint32_t)(kDt * (0.08f + 0.6f*(kSpeed/100.0f)) * lifeScale * 65536.0f);
+  BenchClock c;
+  for (int f = 0; f < kFrames; f++){
+    for (int i = 0; i < n; i++){
+      uint8_t v;
+      if (!flyEnvStep(flies[i], step, v)){ flies[i].phase = 0; continue; }
+      sum += v;
+    }
+  }
+  return c.ns() / ((double)kFrames * n);
+}
+
+// Largest brightness difference between the two engines over one fly's life.
+int maxError(){
+  int worst = 0;
+  for (int k = 0; k < 200; k++){
+    uint16_t r = rnd(9830, 22937), fa = rnd(16384, 36044), h = rnd(3276, 16384);
+    FloatFly ff = { 0, r / 65536.0f, fa / 65536.0f, h / 65536.0f, true };
+    FlyEnv fe; flyEnvInit(fe, r, h, fa);
+    for (uint32_t q = 1; q < fe.end; q += 97){
+      ff.phase = q / 65536.0f; fe.phase = q - 1;
+      uint8_t a = 0, b = 0;
+      bool la = floatStep(ff, 0, 0, 100, a);  // zero dt: evaluate at phase
+      bool lb = flyEnvStep(fe, 1, b);
+      if (la && lb) worst = std::max(worst, abs((int)a - (int)b));
+    }
+  }
+  return worst;
+}
+
+}  // namespace
+
+void benchEnvelope(){
+  printf("%-8s %14s %14s %8s\n", "flies", "float ns/fly", "q16 ns/fly", "gain");
+  const int kCounts[] = { 128, 2048 };
+  for (int n : kCounts){
+    uint32_t s1 = 0, s2 = 0;
+    double a = runFloat(n, s1), b = runQ16(n, s2);
+    benchKeep(s1); benchKeep(s2);
+    printf("%-8d %14.2f %14.2f %7.2fx\n", n, a, b, a / b);
+  }
+  printf("max brightness error vs float: %d/255\n", maxError());
+}
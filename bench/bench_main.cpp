@@ -0,0 +1,59 @@
+// Host-native benchmark runner: `pio run -e native && .pio/build/native/program [section]`
+// Exits 1 if any section's check failed (benchCheck), so it can gate a build.
+#include <string.h>
+#include "bench.h"
+#include "compositor.h"
+#include "effects.h"
+
+int gBenchFailures = 0;
+
+struct Section { const char* name; void (*run)(); };
+static const Section kSections[] = {
+  { "modes",    benchModes },
+  { "envelope", benchEnvelope },
+  { "pipeline", benchPipeline },
+  { "params",   benchParams },
+  { "segments", benchSegments },
+  { "palette",  benchPalette },
+  { "noise",    benchNoise },
+  { "ctrl",     benchCtrl },
+  { "preview",  benchPreview },
+  { "realtime", benchRealtime },
+  { "assets",   benchAssets },
+  { "schedule", benchSchedJson },
+  { "wifi",     benchWifi },
+  { "persist",  benchPersist },
+  { "metrics",  benchMetrics },
+  { "power",    benchPower },
+  { "replay",   benchReplay },
+  { "map",      benchMap },
+  { "engine",   benchEngine },
+  { "compose",  benchCompose },
+  { "accum",    benchAccum },
+  { "pace",     benchPace },
+};
+
+const CRGB* benchFrame(uint8_t mode, uint32_t f){
+  alignas(4) static CRGB out[NUM_LEDS];
+  gMode = mode;
+  gFrameMs = f * 1000 / 60;
+  gComp.frame(out, 1 / 60.0f);
+  return out;
+}
+
+uint8_t benchMode(const char* name){
+  for (uint8_t m = 0; m < MODE_COUNT; m++) if (!strcmp(modeName(m), name)) return m;
+  return MODE_COUNT;
+}
+
+int main(int argc, char** argv){
+  const char* only = argc > 1 ? argv[1] : nullptr;
+  for (const Section& s : kSections){
+    if (only && strcmp(only, s.name) != 0) continue;
+    printf("== %s ==\n", s.name);
+    s.run();
+    printf("\n");
+  }
+  if (gBenchFailures) printf("%d check(s) failed\n", gBenchFailures);
+  return gBenchFailures ? 1 : 0;
+}
@@ -0,0 +1,173 @@
+// Pixel map at 5000 pixels: four helix-wound trees and a pergola. The upload
+// parser must give the same map from CSV and JSON, grid-pruned 3D ripples must
+// match a brute-force pass over every pixel, and the mapped modes should cost
+// about what their 1D versions do.
+#include <math.h>
+#include <string>
+#include <string.h>
+#include "bench.h"
+#include "effects.h"
+#include "litset.h"
+#include "palette.h"
+#include "params.h"
+#include "pixmap.h"
+#include "power.h"
+
+namespace {
+
+const uint16_t kPixels = 5000;
+
+// Positions in centimetres: trees 4 m tall around a 60 cm trunk, the pergola
+// a 4 x 3 m grid of runs at 2.4 m.
+void install(int32_t* xyz){
+  for (uint16_t i = 0; i < kPixels; i++){
+    int32_t* p = xyz + i * 3;
+    if (i < 4000){
+      uint16_t tree = i / 1000, k = i % 1000;
+      float a = k * 0.25f, h = k * 0.4f, r = 60.0f * (1.0f - h / 480.0f);
+      p[0] = 150 + tree % 2 * 500 + (int32_t)lroundf(r * cosf(a));
+      p[1] = (int32_t)lroundf(h);
+      p[2] = 150 + tree / 2 * 500 + (int32_t)lroundf(r * sinf(a));
+    } else {
+      uint16_t k = i - 4000, run = k / 100, along = k % 100;
+      p[0] = 200 + (run < 5 ? run * 100 : along * 4);
+      p[1] = 240;
+      p[2] = 200 + (run < 5 ? along * 3 : (run - 5) * 60);
+    }
+  }
+}
+
+std::string csv(const int32_t* xyz){
+  std::string s;
+  char line[40];
+  for (uint16_t i = 0; i < kPixels; i++){ snprintf(line, sizeof(line), "%d,%d,%d\n", xyz[i * 3], xyz[i * 3 + 1], xyz[i * 3 + 2]); s += line; }
+  return s;
+}
+std::string json(const int32_t* xyz){
+  std::string s = "[";
+  char item[48];
+  for (uint16_t i = 0; i < kPixels; i++){ snprintf(item, sizeof(item), "%s[%d.0, %d, %d.4]", i ? "," : "", xyz[i * 3], xyz[i * 3 + 1], xyz[i * 3 + 2]); s += item; }
+  return s + "]";
+}
+
+// Fed as a TCP stack hands it over, in ~1.4 kB pieces, and quantized in
+// place over the staging the way /map does it.
+bool parse(MapParser& p, const std::string& body, uint8_t* out, uint16_t& n){
+  static int16_t raw[NUM_LEDS * 3];
+  p.begin(raw);
+  for (size_t o = 0; o < body.size(); o += 1436)
+    if (!p.feed((const uint8_t*)body.data() + o, body.size() - o < 1436 ? body.size() - o : 1436)) return false;
+  if (!p.finish((uint8_t*)raw, n)) return false;
+  memcpy(out, raw, n * 3);
+  return true;
+}
+
+// Every pixel against every live ring, same shell and weight as the effect.
+void bruteShells(CRGB* out){
+  fill_solid(out, kPixels, CRGB::Black);
+  for (const Ripple& r : gRipples.ring){
+    if (!r.on) continue;
+    float radius = r.age * (8 + gDensity / 2.0f);
+    if (radius > 442) continue;
+    CRGB c = palVal()[(uint8_t)(255.0f * (1.0f - radius / 442))];
+    const float mid = radius - 6.0f;
+    const int32_t m2 = (int32_t)(mid * mid), band = (int32_t)(mid * 12);
+    if (band < 1) continue;
+    for (uint16_t i = 0; i < kPixels; i++){
+      int dx = gMap.x[i] - gMap.x[r.center], dy = gMap.y[i] - gMap.y[r.center], dz = gMap.z[i] - gMap.z[r.center];
+      int32_t e = abs(dx * dx + dy * dy + dz * dz - m2);
+      if (e >= band) continue;
+      CRGB px = c; px.nscale8_video(255 - (uint8_t)((e * ((255 << 16) / band)) >> 16));
+      out[i] += px;
+    }
+  }
+}
+
+void clearFrame(){
+  fill_solid(leds, NUM_LEDS, CRGB::Black); gLit.clear();
+  Layout l = { 1, { { 4, kPixels, 0 } } };
+  gPower.setLayout(l);
+}
+
+double nsPerFrame(uint8_t mode, int frames){
+  bool rings = !strcmp(modeName(mode), "ripples");
+  BenchClock c;
+  for (int f = 0; f < frames; f++){
+    if (rings && f % 6 == 0) triggerRipple();
+    benchFrame(mode, f);
+  }
+  return c.ns() / frames;
+}
+
+void rings(float dt){
+  const Params p = paramsLive();
+  gRipples.advance(p, dt, gNumLeds);
+  gRipples.draw(Pixels{ leds, gNumLeds, &gLit }, p);
+}
+
+}  // namespace
+
+void benchMap(){
+  static int32_t raw[kPixels * 3];
+  static uint8_t a[NUM_LEDS * 3], b[NUM_LEDS * 3];
+  static MapParser p;
+  install(raw);
+  uint16_t na = 0, nb = 0;
+  std::string c = csv(raw), j = json(raw);
+  bool okA = parse(p, c, a, na), okB = parse(p, j, b, nb);
+  bool same = okA && okB && na == kPixels && nb == kPixels && !memcmp(a, b, kPixels * 3);
+  uint16_t bad = 0;
+  bool rejects = !parse(p, "1,2,3\n4,5", a + 3 * kPixels, bad) && !parse(p, "", a + 3 * kPixels, bad);
+  printf("upload: csv %zu B, json %zu B -> %u pixels, %s; short and empty bodies %s\n",
+         c.size(), j.size(), na, benchCheck(same, "same map"), benchCheck(rejects, "rejected"));
+
+  const int kBuilds = 200;
+  BenchClock bc;
+  for (int i = 0; i < kBuilds; i++) gMap.build(a, kPixels);
+  printf("build: %.1f us; flash %u B, tables %zu B\n", bc.ns() / kBuilds / 1000, kPixels * 3, sizeof(PixMap));
+
+  // grid pruning is exact: rings at every radius, several at once
+  gNumLeds = kPixels;
+  effectsReset(7);
+  clearFrame();
+  gDensity = 60; gSpeed = 60;
+  static CRGB ref[kPixels];
+  uint32_t frames = 0, diff = 0;
+  for (int f = 0; f < 900; f++, frames++){
+    if (f % 20 == 0) triggerRipple();
+    fill_solid(leds, kPixels, CRGB::Black); gLit.clear();
+    rings(1 / 60.0f);
+    bruteShells(ref);
+    if (memcmp(ref, leds, sizeof(CRGB) * kPixels)) diff++;
+  }
+  printf("3D ripples, %u frames: grid %s brute force\n", frames, benchCheck(!diff, "=", "FAIL vs"));
+
+  // per frame, 1D and mapped
+  printf("%8s %10s %10s %10s\n", "mode", "1D ns", "3D ns", "3D lit");
+  for (const char* name : { "ripples", "swarm", "wave" }){
+    const int kN = 600;
+    uint16_t keep = gMap.count;
+    gMap.count = 0; effectsReset(7); clearFrame();
+    double flat = nsPerFrame(benchMode(name), kN);
+    gMap.count = keep; effectsReset(7); clearFrame();
+    double mapped = nsPerFrame(benchMode(name), kN);
+    printf("%8s %10.0f %10.0f %10u\n", name, flat, mapped, gLit.count());
+  }
+  { // what the grid saves: the same rings visiting every pixel
+    effectsReset(7); clearFrame();
+    for (int i = 0; i < MAX_RIPPLES; i++){ triggerRipple(); gRipples.ring[i].age = i * 0.4f; }
+    const int kN = 300;
+    BenchClock g;
+    for (int i = 0; i < kN; i++) rings(0);
+    double grid = g.ns() / kN;
+    BenchClock br;
+    for (int i = 0; i < kN; i++){ bruteShells(ref); benchKeep(ref[0]); }
+    printf("%d rings: grid %.0f ns, every pixel %.0f ns\n", MAX_RIPPLES, grid, br.ns() / kN);
+  }
+
+  gMap.count = 0;
+  gNumLeds = NUM_LEDS;
+  effectsReset(1); clearFrame();
+  Layout l = { 1, { { 4, NUM_LEDS, 0 } } };
+  gPower.setLayout(l);
+}
@@ -0,0 +1,42 @@
+// Per-mode frame cost across strip lengths and density/speed settings.
+#include <string.h>
+#include "bench.h"
+#include "effects.h"
+
+namespace {
+
+struct Setting { const char* name; uint8_t density, speed; };
+const Setting kSettings[] = { { "calm", 10, 10 }, { "default", 35, 50 }, { "busy", 100, 100 } };
+const uint16_t kLengths[] = { 500, 2000, 10000 };
+
+const int kWarmup = 120, kFrames = 600;
+
+void runFrames(uint8_t m, int frames, uint32_t& f){
+  bool rings = !strcmp(modeName(m), "ripples");
+  for (int i = 0; i < frames; i++, f++){
+    if (rings && (i % 20) == 0) triggerRipple();
+    benchFrame(m, f);
+  }
+}
+
+}  // namespace
+
+void benchModes(){
+  static_assert(NUM_LEDS >= 10000, "native env must size leds[] for the largest bench strip");
+  printf("%-10s %-8s %6s %12s %10s %8s\n", "mode", "setting", "leds", "ns/frame", "ns/pixel", "fps-cap");
+  for (uint8_t m = 0; m < MODE_COUNT; m++){
+    for (uint16_t n : kLengths){
+      for (const Setting& s : kSettings){
+        gNumLeds = n; gDensity = s.density; gSpeed = s.speed;
+        effectsReset(1);
+        uint32_t f = 0;
+        runFrames(m, kWarmup, f);
+        BenchClock c;
+        runFrames(m, kFrames, f);
+        double ns = c.ns() / kFrames;
+        benchKeep(leds[0]);
+        printf("%-10s %-8s %6u %12.0f %10.2f %8.0f\n", modeName(m), s.name, n, ns, ns / n, 1e9 / ns);
+      }
+    }
+  }
+}
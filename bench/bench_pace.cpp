@@ -0,0 +1,143 @@
+// Frame pacing on a virtual clock. loop() as it was (render, send, repeat,
+// dt from millis()) against the pacer at 60 fps, with the sleep rounded to
+// 1 ms ticks the way vTaskDelay rounds it. Rates, dt spread, loop duty, and
+// how far the frame clock trails the wall clock as the last frame starts,
+// which must be the periods dropped to within one period. Renders over the
+// period must stretch it, and it must come back once they fit again. Then the
+// idle skip on real modes at 500 pixels: how many frames go out, and that
+// every frame held back matches the one on the strip byte for byte.
+#include <string.h>
+#include "bench.h"
+#include "compositor.h"
+#include "effects.h"
+#include "pacer.h"
+#include "power.h"
+#include "rng.h"
+
+namespace {
+
+struct Sim { double fps, sentFps, duty; float dtMin, dtMax; uint32_t dropped; double lagMs, lostMs; };
+
+// A vTaskDelay(n) that starts mid-tick wakes on a tick boundary.
+uint32_t tickWake(uint32_t now, uint32_t w){ return (now / 1000 + (w >= 2000 ? w / 1000 : 1)) * 1000; }
+
+// Ten seconds of frames costing cost(f) us each. The pacer's last window gives fps and duty.
+template <typename F> Sim paced(uint32_t periodUs, F cost){
+  const uint32_t t0 = 5000, end = t0 + 10000000;
+  FramePacer p;
+  p.begin(t0, periodUs);
+  Sim s = { 0, 0, 0, 1e9f, 0, 0, 0, 0 };
+  PaceStats ps = {};
+  uint32_t now = t0, f = 0, cur = periodUs, dropped = 0;
+  while (now < end){
+    uint32_t w = p.wait(now);
+    s.lostMs += (p.dropped() - dropped) * (cur / 1000.0); dropped = p.dropped();
+    if (w){ p.sleeping(now); now = tickWake(now, w); continue; }
+    float dt = p.step();
+    if (dt < s.dtMin) s.dtMin = dt;
+    if (dt > s.dtMax) s.dtMax = dt;
+    s.lagMs = (now - t0) / 1000.0 - p.clockMs();
+    now += cost(f++);
+    p.changed(f, now / 1000);
+    if (p.report(now, 1000000 / periodUs, ps)) cur = ps.periodUs;
+  }
+  s.fps = ps.fpsX10 / 10.0; s.sentFps = ps.shownX10 / 10.0; s.duty = ps.dutyX10 / 10.0; s.dropped = ps.dropped;
+  return s;
+}
+
+// The loop before pacing: no sleep, dt from millis() deltas.
+template <typename F> Sim unpaced(F cost){
+  const uint32_t t0 = 5000, end = t0 + 10000000;
+  Sim s = { 0, 0, 100, 1e9f, 0, 0, 0, 0 };
+  uint32_t now = t0, last = t0 / 1000, f = 0;
+  while (now < end){
+    uint32_t ms = now / 1000;
+    float dt = (ms - last) / 1000.0f; last = ms;
+    if (f && dt < s.dtMin) s.dtMin = dt;
+    if (dt > s.dtMax) s.dtMax = dt;
+    now += cost(f++);
+  }
+  s.fps = s.sentFps = f / 10.0;
+  return s;
+}
+
+// The frame clock only falls behind by what was dropped, plus less than a
+// period still due.
+bool accounted(const Sim& s, uint32_t periodUs){ return s.lagMs >= s.lostMs - 1 && s.lagMs < s.lostMs + periodUs / 1000.0; }
+
+void row(const char* name, const Sim& s, const char* verdict){
+  printf("%-34s %6.1f %6.1f %6.1f..%-6.1f %6.1f %7u %7.1f %7.1f %s\n", name, s.fps, s.sentFps, s.dtMin * 1000, s.dtMax * 1000, s.duty, s.dropped, s.lagMs, s.lostMs, verdict);
+}
+
+struct Idle { uint32_t frames, sent, heldBack, mismatched; double hashNs; };
+
+// Frames of mode m through the compositor and the limiter, kept off the
+// strip the way loop() does it.
+Idle idle(uint8_t m, uint8_t density, uint8_t speed, uint32_t frames){
+  alignas(4) static CRGB sent[NUM_LEDS];
+  Layout l = { 1, { { LED_PIN, 500, 0 } } };
+  gNumLeds = 500; gDensity = density; gSpeed = speed; gBrightness = 200;
+  gPower.setLayout(l);
+  effectsReset(1);
+  FramePacer p;
+  p.begin(0, 1000000 / 60);
+  Idle r = {};
+  double ns = 0;
+  for (uint32_t f = 0; f < frames; f++){
+    const CRGB* out = benchFrame(m, f);
+    PowerOut po;
+    powerLimit(l, gBrightness, MAX_MA, po);
+    BenchClock c;
+    uint32_t h = frameHash(out, gNumLeds, gBrightness, po.scale, l.count);
+    ns += c.ns();
+    r.frames++;
+    if (p.changed(h, f * 1000 / 60)){ r.sent++; memcpy(sent, out, gNumLeds * sizeof(CRGB)); }
+    else { r.heldBack++; if (memcmp(sent, out, gNumLeds * sizeof(CRGB))) r.mismatched++; }
+  }
+  r.hashNs = ns / frames;
+  return r;
+}
+
+}  // namespace
+
+void benchPace(){
+  const uint32_t period = 1000000 / 60;
+  Rng r; r.seed(5);
+  auto jitter = [&r](uint32_t base, uint32_t spread){ return [&r, base, spread](uint32_t){ return base - spread + r.below(2 * spread + 1); }; };
+
+  printf("virtual clock, 60 fps target, 1 ms ticks   %6s %6s %14s %6s %7s %7s %7s\n", "fps", "sent", "dt ms", "duty%", "dropped", "lag ms", "lost ms");
+  Sim old = unpaced(jitter(3000, 1000));
+  row("unpaced (old loop), 3 +- 1 ms", old, old.dtMax > old.dtMin ? "dt jitters" : "");
+  Sim light = paced(period, jitter(3000, 1000));
+  row("paced, 3 +- 1 ms render", light, benchCheck(light.dtMin == light.dtMax && light.fps > 59.4 && light.fps < 60.6 && !light.dropped && accounted(light, period)));
+  Sim heavy = paced(period, jitter(12000, 4000));
+  row("paced, 12 +- 4 ms render", heavy, benchCheck(heavy.dtMin == heavy.dtMax && heavy.fps > 59.4 && heavy.fps < 60.6 && !heavy.dropped && accounted(heavy, period)));
+  Sim over = paced(period, [](uint32_t){ return 22000u; });
+  row("paced, 22 ms render (over period)", over, benchCheck(over.dtMax > over.dtMin && over.fps > 40 && over.fps < 45.5 && accounted(over, period), "ok, stretches"));
+  Sim burst = paced(period, [](uint32_t f){ return f >= 120 && f < 240 ? 22000u : 3000u; });
+  row("paced, 22 ms x 120 frames, then 3", burst, benchCheck(burst.fps > 59.4 && burst.fps < 60.6 && accounted(burst, period), "ok, recovers"));
+  Sim stall = paced(period, [](uint32_t f){ return f == 100 ? 250000u : 3000u; });
+  row("paced, 3 ms + one 250 ms stall", stall, benchCheck(stall.dtMin == stall.dtMax && stall.dropped >= 10 && stall.dropped <= 12 && accounted(stall, period), "ok, drops"));
+
+  printf("%-34s %7s %7s %9s %10s %8s\n", "500 px, 10 s at 60 fps", "frames", "sent", "held back", "mismatched", "hash ns");
+  struct Case { const char* name; const char* mode; uint8_t density, speed; } cases[] = {
+    { "fireflies, density 0", "fireflies", 0, 50 },
+    { "fireflies, density 35", "fireflies", 35, 50 },
+    { "sync, speed 0 (10 bpm)", "sync", 35, 0 },
+    { "wave", "wave", 35, 80 },
+  };
+  bool ok = true;
+  for (const Case& c : cases){
+    Idle i = idle(benchMode(c.mode), c.density, c.speed, 600);
+    ok &= !i.mismatched;
+    printf("%-34s %7u %7u %9u %10u %8.0f\n", c.name, i.frames, i.sent, i.heldBack, i.mismatched, i.hashNs);
+  }
+  Idle dark = idle(benchMode("fireflies"), 0, 50, 600);
+  printf("idle skip: %s; a black scene sends %u frames in 10 s (one per PACE_REFRESH_MS)\n", benchCheck(ok && dark.sent <= 11), dark.sent);
+
+  gNumLeds = NUM_LEDS;
+  Layout d = { 1, { { LED_PIN, NUM_LEDS, 0 } } };
+  gPower.setLayout(d);
+  gDensity = 35; gSpeed = 50;
+  effectsReset(1);
+}
@@ -0,0 +1,63 @@
+// Per-pixel color cost: hsv2rgb per pixel vs the palette tables, plus an
+// exactness check of every table entry against CHSV.
+#include "bench.h"
+#include "effects.h"
+#include "palette.h"
+
+namespace {
+
+int mismatches(){
+  int bad = 0;
+  const uint8_t kHues[] = { 0, 45, 100, 200 }, kSats[] = { 0, 120, 200, 255 };
+  for (uint8_t h : kHues) for (uint8_t s : kSats){
+    gHueBase = h; gSaturation = s;
+    const CRGB *val = palVal(), *hue = palHue(), *sw = palSwarm();
+    for (int i = 0; i < 256; i++){
+      if (val[i] != CRGB(CHSV(h, s, i))) bad++;
+      if (sw[i] != CRGB(CHSV(h + scale8(i, 20), s, scale8(i, 220)))) bad++;
+      for (int v = 0; v < 256; v += 5) if (palDim(hue[i], v) != CRGB(CHSV(i, s, v))) bad++;
+    }
+  }
+  return bad;
+}
+
+}  // namespace
+
+void benchPalette(){
+  const uint16_t n = 10000;
+  const int kReps = 200;
+  gHueBase = 45; gSaturation = 200;
+
+  BenchClock c0;
+  for (int r = 0; r < kReps; r++)
+    for (uint16_t i = 0; i < n; i++) leds[i] = CHSV(gHueBase, gSaturation, (uint8_t)(i + r));
+  double hsv = c0.ns() / ((double)kReps * n);
+  benchKeep(leds[7]);
+
+  BenchClock c1;
+  for (int r = 0; r < kReps; r++){
+    const CRGB* pal = palVal();
+    for (uint16_t i = 0; i < n; i++) leds[i] = pal[(uint8_t)(i + r)];
+  }
+  double lut = c1.ns() / ((double)kReps * n);
+  benchKeep(leds[7]);
+
+  BenchClock c2;
+  for (int r = 0; r < kReps; r++){
+    const CRGB* hue = palHue();
+    for (uint16_t i = 0; i < n; i++) leds[i] = palDim(hue[(uint8_t)(i * 3)], (uint8_t)(i + r));
+  }
+  double dim = c2.ns() / ((double)kReps * n);
+  benchKeep(leds[7]);
+
+  BenchClock c3;
+  for (int r = 0; r < kReps; r++){ gHueBase++; palVal(); }
+  double rebuild = c3.ns() / kReps;
+
+  printf("hsv2rgb per pixel      %6.2f ns\n", hsv);
+  printf("palVal lookup          %6.2f ns  (%.1fx)\n", lut, hsv / lut);
+  printf("palHue + palDim        %6.2f ns  (%.1fx)\n", dim, hsv / dim);
+  printf("palVal rebuild         %6.0f ns per hue/sat change\n", rebuild);
+  int bad = mismatches();
+  printf("table mismatches vs CHSV: %d  %s\n", bad, benchCheck(!bad));
+}
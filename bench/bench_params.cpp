@@ -0,0 +1,51 @@
+// Seqlock parameter snapshots and the ripple SPSC queue under a writer burst.
+// Every field of a published block carries the same value, so a torn
+// snapshot shows up as a mismatch.
+#include <atomic>
+#include <thread>
+#include "bench.h"
+#include "params.h"
+
+void benchParams(){
+  static SeqLock<Params> lock;
+  static SpscQueue<int16_t, 16> q;
+  std::atomic<bool> done{false};
+  uint32_t pushed = 0, dropped = 0;
+
+  std::thread writer([&]{
+    for (uint32_t k = 1; k <= 200000; k++){
+      uint8_t v = (uint8_t)k;
+      Params p = { v, v, v, v, v, v, v, v, (bool)(v & 1), v, v };
+      lock.write(p);
+      if ((k & 63) == 0){ if (q.push((int16_t)(k >> 6))) pushed++; else dropped++; }
+      if ((k & 15) == 0) std::this_thread::yield();  // let the reader in on one core too
+    }
+    done = true;
+  });
+
+  uint32_t seen = 0, snaps = 0, skipped = 0, torn = 0, popped = 0, outOfOrder = 0;
+  int16_t last = 0, rc;
+  while (!done.load()){
+    Params p;
+    if (lock.read(p, seen)){
+      snaps++;
+      if (p.brightness != p.mode || p.fade != p.mode || p.sat != p.mode || p.drift != (bool)(p.mode & 1)) torn++;
+    } else skipped++;
+    while (q.pop(rc)){ popped++; if (rc <= last) outOfOrder++; last = rc; }
+    std::this_thread::yield();
+  }
+  writer.join();
+  while (q.pop(rc)){ popped++; if (rc <= last) outOfOrder++; last = rc; }
+
+  // Uncontended cost of one publish plus one snapshot
+  const uint32_t kIter = 1000000;
+  Params p = {};
+  BenchClock c;
+  for (uint32_t k = 0; k < kIter; k++){ p.speed = (uint8_t)k; lock.write(p); lock.read(p, seen); }
+  double ns = c.ns() / kIter;
+  benchKeep(p);
+
+  printf("snapshots %u (no new/in-write %u), torn %u\n", snaps, skipped, torn);
+  printf("ripple cmds pushed %u, dropped on full %u, popped %u, out of order %u\n", pushed, dropped, popped, outOfOrder);
+  printf("publish+snapshot ns %.1f  %s\n", ns, benchCheck(!torn && !outOfOrder && popped == pushed));
+}
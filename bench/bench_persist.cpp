@@ -0,0 +1,137 @@
+// Scene and Wi-Fi persistence against a Preferences stand-in that counts
+// flash writes: how many a burst of edits costs, that unchanged data costs
+// none, and that a saved scene comes back intact (and a bad one does not).
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "persist.h"
+#include "wifi_manager.h"
+
+namespace {
+
+class MockKv : public KvStore {
+public:
+  std::map<std::string, std::vector<uint8_t>> keys;
+  uint32_t puts = 0, bytes = 0;
+  bool full = false;   // flash full: every put fails
+  size_t get(const char* key, void* buf, size_t len) override {
+    auto it = keys.find(key);
+    if (it == keys.end() || it->second.size() != len) return 0;
+    memcpy(buf, it->second.data(), len);
+    return len;
+  }
+  bool put(const char* key, const void* buf, size_t len) override {
+    if (full) return false;
+    keys[key].assign((const uint8_t*)buf, (const uint8_t*)buf + len);
+    puts++; bytes += len;
+    return true;
+  }
+};
+
+Params scene(uint8_t bright){ return { 2, bright, 40, 128, 20, 200, 80, 60, true, 10, 60 }; }
+
+// Edits at `hz` for `ms`, then idles 10 s, ticking every 16 ms like loop().
+uint32_t drag(ScenePersist& sp, MockKv& kv, uint32_t& now, uint32_t ms, uint32_t hz, bool change){
+  uint32_t before = kv.puts, nextEdit = now, end = now + ms;
+  Params p = scene(10); Schedule s = {};
+  for (; now < end + 10000; now += 16){
+    if (now < end && now >= nextEdit){ if (change) p.brightness++; sp.touch(now); nextEdit += 1000 / hz; }
+    sp.tick(now, p, s);
+  }
+  return kv.puts - before;
+}
+
+struct Case { const char* name; bool ok; uint32_t writes, oldWrites; const char* note; };
+
+}  // namespace
+
+void benchPersist(){
+  std::vector<Case> cases;
+
+  { // slider dragged for 5 s: one write once it settles
+    MockKv kv; ScenePersist sp(kv); uint32_t now = 0;
+    uint32_t w = drag(sp, kv, now, 5000, 60, true);
+    cases.push_back({ "5 s drag", w == 1, w, 300, "60 events/s, written 3 s after release" });
+  }
+  { // same values sent again: nothing to write
+    MockKv kv; ScenePersist sp(kv); uint32_t now = 0;
+    drag(sp, kv, now, 100, 60, false);
+    uint32_t w = drag(sp, kv, now, 5000, 60, false);
+    cases.push_back({ "no change", w == 0, w, 300, "touched but identical bytes" });
+  }
+  { // never settles: bounded by PERSIST_MAX_MS
+    MockKv kv; ScenePersist sp(kv); uint32_t now = 0;
+    uint32_t w = drag(sp, kv, now, 120000, 5, true);
+    cases.push_back({ "2 min nonstop", w >= 120000 / PERSIST_MAX_MS && w <= 120000 / PERSIST_MAX_MS + 1, w, 600, "one per PERSIST_MAX_MS" });
+  }
+  { // reboot: params and schedule round-trip; the write skip survives it
+    MockKv kv; ScenePersist sp(kv);
+    Schedule s = {};
+    s.count = 2;
+    s.items[0] = { 3, 30000, 1 << SF_HUE, { 0, 0, 0, 77 }, 0 };
+    s.items[1] = { 5, 9000, 0, {}, 2500 };
+    sp.touch(0); sp.tick(PERSIST_QUIET_MS, scene(99), s);
+    ScenePersist boot(kv);
+    Params p = {}, want = scene(99); Schedule r = {};
+    bool ok = boot.load(p, r) && !memcmp(&p, &want, sizeof(p)) && r.count == 2
+           && r.items[0].mode == 3 && r.items[0].val[SF_HUE] == 77 && r.items[1].duration_ms == 9000 && r.items[1].xfade_ms == 2500;
+    boot.touch(0);
+    ok &= !boot.tick(PERSIST_QUIET_MS, p, r);
+    p.hue++; boot.touch(0);
+    ok &= boot.tick(PERSIST_QUIET_MS, p, r);
+    cases.push_back({ "reboot restore", ok, kv.puts, 0, "scene + schedule; no rewrite until something changes" });
+  }
+  { // write fails: the same bytes go out again once it can succeed
+    MockKv kv; ScenePersist sp(kv); Schedule s = {};
+    kv.full = true;
+    sp.touch(0);
+    bool ok = !sp.tick(PERSIST_QUIET_MS, scene(99), s) && !sp.tick(2 * PERSIST_QUIET_MS - 1, scene(99), s);
+    kv.full = false;
+    ok &= sp.tick(2 * PERSIST_QUIET_MS, scene(99), s) && kv.puts == 1;
+    BlobSlot slot("nets"); WifiList l = {};
+    kv.full = true; ok &= !slot.save(kv, &l, sizeof(l));
+    kv.full = false; ok &= slot.save(kv, &l, sizeof(l));
+    cases.push_back({ "failed write", ok, kv.puts, 0, "retried after PERSIST_QUIET_MS, not taken as saved" });
+  }
+  { // corrupt or from another firmware: defaults stay
+    MockKv kv; ScenePersist sp(kv); Schedule s = {};
+    sp.touch(0); sp.tick(PERSIST_QUIET_MS, scene(99), s);
+    std::vector<uint8_t> good = kv.keys["scene"];
+    Params p; Schedule r;
+    kv.keys["scene"][10] ^= 0x40;
+    bool ok = !ScenePersist(kv).load(p, r);
+    kv.keys["scene"] = good; kv.keys["scene"][2] = SCENE_VERSION + 1;
+    ok &= !ScenePersist(kv).load(p, r);
+    kv.keys["scene"].resize(good.size() - 4);
+    ok &= !ScenePersist(kv).load(p, r);
+    kv.keys["scene"] = good;
+    ok &= ScenePersist(kv).load(p, r);
+    cases.push_back({ "bad blob", ok, 0, 0, "bit flip, version, size rejected" });
+  }
+  { // Wi-Fi list: one blob per edit instead of 1 + 2n keys, none if unchanged
+    MockKv kv; BlobSlot slot("nets");
+    WifiList l = {};
+    uint32_t old = 0;
+    for (int i = 0; i < 5; i++){
+      snprintf(l.net[l.count].ssid, sizeof(l.net[0].ssid), "net%d", i); strcpy(l.net[l.count].pass, "secret");
+      l.count++;
+      slot.save(kv, &l, sizeof(l));
+      old += 1 + 2 * l.count;
+    }
+    bool ok = kv.puts == 5;
+    ok &= !slot.save(kv, &l, sizeof(l));   // re-adding the same network
+    cases.push_back({ "wifi 5 adds", ok, kv.puts, old, "one blob each, re-add is free" });
+  }
+
+  // old: the same edits before, one write per event or one key per field
+  printf("%-15s %7s %7s\n", "case", "writes", "old");
+  for (const Case& c : cases) printf("%-15s %7u %7u %s  %s\n", c.name, c.writes, c.oldWrites, benchCheck(c.ok), c.note);
+
+  MockKv kv; ScenePersist sp(kv); Schedule s = {}; s.count = MAX_SCHEDULE_ITEMS;
+  const int N = 20000;
+  BenchClock c;
+  for (int i = 0; i < N; i++){ sp.touch(0); benchKeep(sp.tick(PERSIST_QUIET_MS, scene(1), s)); }
+  printf("scene blob %u B; unchanged check %.2f us (CRC of the whole blob)\n", (unsigned)sizeof(SceneBlob), c.ns() / N / 1000);
+}
@@ -0,0 +1,115 @@
+// Incremental power accounting against FastLED's full-buffer estimate: the
+// per-segment sums must match a rescan of the frame sent, after every frame of
+// every mode, and the limiter must pick the brightness FastLED's would. Then
+// what each costs.
+#include <string.h>
+#include "bench.h"
+#include "effects.h"
+#include "power.h"
+
+namespace {
+
+// FastLED's power_mgt.cpp: per controller, summed over controllers
+uint32_t refUnscaled(const CRGB* px, uint16_t n){
+  uint32_t r = 0, g = 0, b = 0;
+  for (uint16_t i = 0; i < n; i++){ r += px[i].r; g += px[i].g; b += px[i].b; }
+  return ((r * POWER_RED_MW) >> 8) + ((g * POWER_GREEN_MW) >> 8) + ((b * POWER_BLUE_MW) >> 8) + POWER_DARK_MW * n;
+}
+uint8_t refLimit(const Layout& l, const CRGB* px, uint8_t target, uint32_t maxMa){
+  uint32_t total = 0, start = 0;
+  for (uint8_t s = 0; s < l.count; s++){ total += refUnscaled(px + start, l.seg[s].count); start += l.seg[s].count; }
+  uint32_t req = total * target / 256;
+  return req > POWER_VOLTS * maxMa ? (uint32_t)target * POWER_VOLTS * maxMa / req : target;
+}
+
+Layout split(uint16_t n){
+  Layout l = { 3, { { 4, (uint16_t)(n / 2), 0 }, { 5, (uint16_t)(n / 4), 0 }, { 13, (uint16_t)(n - n / 2 - n / 4), 0 } } };
+  return l;
+}
+
+bool sumsMatch(const Layout& l, const CRGB* px){
+  uint16_t start = 0;
+  for (uint8_t s = 0; s < l.count; s++){
+    PowerSum ref = {};
+    for (uint16_t i = start; i < start + l.seg[s].count; i++){ ref.r += px[i].r; ref.g += px[i].g; ref.b += px[i].b; }
+    const PowerSum& a = gPower.seg[s];
+    if (a.r != ref.r || a.g != ref.g || a.b != ref.b) return false;
+    start += l.seg[s].count;
+  }
+  return true;
+}
+
+void reset(const Layout& l){
+  gNumLeds = layoutTotal(l);
+  gPower.setLayout(l);
+  effectsReset(1);
+}
+
+}  // namespace
+
+void benchPower(){
+  // accuracy: every mode, ripples on top, modes switching without a clear
+  const uint16_t n = 2000;
+  Layout l = split(n);
+  reset(l);
+  gBrightness = 255; gDensity = 60; gSpeed = 60;
+  const uint32_t kMaxMa = 5000;
+  uint32_t frames = 0, badSums = 0, badLimit = 0, clamped = 0;
+  for (int round = 0; round < 2; round++){
+    for (uint8_t m = 0; m < MODE_COUNT; m++){
+      for (int f = 0; f < 400; f++, frames++){
+        if (f % 15 == 0) triggerRipple();
+        const CRGB* out = benchFrame(m, frames);
+        if (!sumsMatch(l, out)) badSums++;
+        PowerOut po;
+        powerLimit(l, gBrightness, kMaxMa, po);
+        if (po.scale[0] != refLimit(l, out, gBrightness, kMaxMa)) badLimit++;
+        clamped += po.clamped;
+      }
+    }
+  }
+  { // a network frame: summed during the copy into the pipeline buffer
+    static CRGB src[NUM_LEDS], dst[NUM_LEDS];
+    for (uint16_t i = 0; i < n; i++) src[i] = CRGB(i * 7, i * 13, i * 3);
+    powerCopy(dst, src, n);
+    if (!sumsMatch(l, dst) || memcmp(dst, src, sizeof(CRGB) * n)) badSums++;
+    frames++;
+  }
+  printf("%u frames, 3 segments: sums %s, limiter %s (%u frames limited)\n", frames,
+         benchCheck(!badSums, "exact", "MISMATCH"), benchCheck(!badLimit, "= FastLED", "MISMATCH"), clamped);
+
+  // per-segment budget: a bright run on one injection point dims only that run
+  {
+    Layout b = split(n);
+    b.seg[1].ma = 2000;
+    reset(b);
+    fill_solid(leds, n, CRGB(8, 8, 8));
+    fill_solid(leds + n / 2, n / 4, CRGB(60, 60, 60));
+    powerCopy(leds, leds, n);   // sums for the hand-filled frame
+    PowerOut po;
+    powerLimit(b, 255, 100000, po);
+    bool ok = po.scale[0] == 255 && po.scale[2] == 255 && po.scale[1] < 255 && po.ma[1] <= 2000;
+    PowerOut glob;
+    b.seg[1].ma = 0;
+    powerLimit(b, 255, po.totalMa, glob);
+    printf("budget 2000 mA on seg 1: scales %u/%u/%u, seg 1 draws %u mA %s; one global limit at the same total would dim all to %u\n",
+           po.scale[0], po.scale[1], po.scale[2], po.ma[1], benchCheck(ok), glob.scale[0]);
+  }
+
+  // cost: FastLED rescans the frame inside show(); the limiter reads 3 sums
+  printf("%6s %14s %14s\n", "leds", "rescan ns", "limiter ns");
+  for (uint16_t len : { 500, 2000, 10000 }){
+    Layout c = split(len);
+    reset(c);
+    for (int f = 0; f < 60; f++) benchFrame(benchMode("wave"), f);
+    const int kN = 2000;
+    BenchClock c1;
+    for (int i = 0; i < kN; i++) benchKeep(refLimit(c, leds, 255, kMaxMa));
+    double scan = c1.ns() / kN;
+    PowerOut po;
+    BenchClock c2;
+    for (int i = 0; i < kN * 100; i++){ powerLimit(c, 255, kMaxMa, po); benchKeep(po.scale[0]); }
+    printf("%6u %14.0f %14.1f\n", len, scan, c2.ns() / (kN * 100));
+  }
+  reset(split(NUM_LEDS));
+}
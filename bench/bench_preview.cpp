@@ -0,0 +1,83 @@
+// Preview stream: bytes per frame for each mode vs raw RGB, encode cost, and a
+// decode roundtrip to confirm the client reconstructs the strip exactly. Key
+// frames follow previewTick's rule, and a second viewer loses one delta: it
+// must be back in step by the next key, within PREVIEW_KEY_MS.
+#include <string.h>
+#include "bench.h"
+#include "effects.h"
+#include "preview.h"
+
+namespace {
+
+const uint16_t kLengths[] = { 500, 2000 };
+const int kEvery = 6, kSamples = 60;   // 10 preview fps off a 60 fps render
+
+CRGB prev[NUM_LEDS], shown[NUM_LEDS], lossy[NUM_LEDS];
+uint8_t buf[PREVIEW_MAX_BYTES(NUM_LEDS)];
+
+uint32_t varint(const uint8_t*& p){
+  uint32_t v = 0; int sh = 0; uint8_t c;
+  do { c = *p++; v |= (uint32_t)(c & 0x7F) << sh; sh += 7; } while (c & 0x80);
+  return v;
+}
+
+// Mirror of the browser decoder in main.cpp's page.
+bool decode(const uint8_t* b, size_t len, CRGB* px){
+  uint16_t n = b[1] | (b[2] << 8);
+  if (b[0] & PV_FLAG_KEY) for (uint16_t i = 0; i < n; i++) px[i] = CRGB::Black;
+  const uint8_t* p = b + 3; const uint8_t* end = b + len;
+  uint32_t i = 0;
+  while (p < end && i < n){
+    uint32_t v = varint(p), run = v >> 2;
+    if (i + run > n) return false;
+    switch (v & 3){
+      case PV_SKIP: break;
+      case PV_LITERAL: for (uint32_t k = 0; k < run; k++, p += 3) px[i + k] = CRGB(p[0], p[1], p[2]); break;
+      case PV_REPEAT: for (uint32_t k = 0; k < run; k++) px[i + k] = CRGB(p[0], p[1], p[2]); p += 3; break;
+      default: return false;
+    }
+    i += run;
+  }
+  return p == end && i == n;
+}
+
+}  // namespace
+
+void benchPreview(){
+  printf("%-10s %6s %9s %9s %9s %8s %10s %s\n", "mode", "leds", "raw B", "key B", "delta B", "ratio", "encode ns", "roundtrip");
+  uint32_t worstMs = 0;
+  bool recovered = true;
+  for (uint8_t m = 0; m < MODE_COUNT; m++){
+    bool rings = !strcmp(modeName(m), "ripples");
+    for (uint16_t n : kLengths){
+      gNumLeds = n; gDensity = 35; gSpeed = 50;
+      effectsReset(1);
+      size_t keyBytes = 0, deltaBytes = 0;
+      int deltas = 0;
+      double ns = 0;
+      bool ok = true;
+      uint32_t lastKey = 0, lostMs = 0, backMs = 0;
+      for (int f = 0; f < 120 + kSamples * kEvery; f++){
+        if (rings && (f % 20) == 0) triggerRipple();
+        const CRGB* out = benchFrame(m, f);
+        if (f < 120 || f % kEvery) continue;
+        const uint32_t ms = f * 1000 / 60;
+        bool key = f == 120 || ms - lastKey >= PREVIEW_KEY_MS;
+        if (key) lastKey = ms;
+        BenchClock c;
+        size_t len = previewEncode(out, prev, n, key, buf);
+        ns += c.ns();
+        if (key){ if (!keyBytes) keyBytes = len; } else { deltaBytes += len; deltas++; }
+        ok &= decode(buf, len, shown) && memcmp(shown, out, n * sizeof(CRGB)) == 0;
+        if (f == 120 + 3 * kEvery){ lostMs = ms; continue; }   // the lossy viewer never gets this one
+        if (decode(buf, len, lossy) && lostMs && !backMs && !memcmp(lossy, out, n * sizeof(CRGB))) backMs = ms;
+      }
+      if (!backMs || backMs - lostMs > PREVIEW_KEY_MS) recovered = false;
+      else if (backMs - lostMs > worstMs) worstMs = backMs - lostMs;
+      double delta = (double)deltaBytes / deltas;
+      printf("%-10s %6u %9u %9zu %9.0f %7.1fx %10.0f %s\n", modeName(m), n, n * 3, keyBytes, delta,
+             n * 3 / delta, ns / kSamples, benchCheck(ok));
+    }
+  }
+  printf("viewer that lost a delta: back in step within %u ms (key every %u ms): %s\n", worstMs, PREVIEW_KEY_MS, benchCheck(recovered));
+}
@@ -0,0 +1,181 @@
+// Realtime ingest: header parsing checks, then DDP and E1.31 streams sent over
+// loopback to the same RtIngest the device polls. Reports receive cost per
+// frame, lockstep frame rate, and how injected packet loss is counted.
+#include <atomic>
+#include <thread>
+#include <string.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "bench.h"
+#include "realtime.h"
+
+namespace {
+
+const uint16_t kDdpPort = 24048, kE131Port = 25568;   // unprivileged, off the real ports
+const int kDdpPixels = 480;                            // 1440-byte payloads
+
+CRGB px[NUM_LEDS];
+
+CRGB tag(uint32_t frame, uint16_t i){ return CRGB((uint8_t)frame, (uint8_t)i, (uint8_t)(i >> 8)); }
+
+size_t ddpPacket(uint8_t* b, uint8_t seq, uint32_t firstPx, uint16_t count, bool push, uint32_t frame){
+  b[0] = 0x40 | (push ? 0x01 : 0); b[1] = seq; b[2] = 0x0B; b[3] = 1;
+  uint32_t off = firstPx * 3, len = count * 3;
+  b[4] = off >> 24; b[5] = off >> 16; b[6] = off >> 8; b[7] = off;
+  b[8] = len >> 8; b[9] = len;
+  for (uint16_t k = 0; k < count; k++){ CRGB c = tag(frame, firstPx + k); memcpy(b + 10 + k * 3, c.raw, 3); }
+  return 10 + len;
+}
+
+size_t e131Packet(uint8_t* b, uint8_t seq, uint16_t universe, uint16_t n, uint32_t frame, uint8_t options = 0){
+  memset(b, 0, 126);
+  b[1] = 0x10; memcpy(b + 4, "ASC-E1.17", 9);
+  b[21] = 0x04; b[43] = 0x02;
+  b[108] = 100; b[111] = seq; b[112] = options; b[113] = universe >> 8; b[114] = universe;
+  b[117] = 0x02; b[118] = 0xA1; b[122] = 1;
+  uint32_t first = (universe - RT_E131_UNIVERSE) * RT_E131_PIXELS;
+  uint16_t count = n - first < RT_E131_PIXELS ? n - first : RT_E131_PIXELS;
+  uint16_t slots = count * 3 + 1;
+  b[123] = slots >> 8; b[124] = slots;
+  for (uint16_t k = 0; k < count; k++){ CRGB c = tag(frame, first + k); memcpy(b + 126 + k * 3, c.raw, 3); }
+  return 126 + count * 3;
+}
+
+size_t e131Sync(uint8_t* b, uint8_t seq, uint16_t universe){
+  memset(b, 0, 49);
+  b[1] = 0x10; memcpy(b + 4, "ASC-E1.17", 9);
+  b[21] = 0x08; b[43] = 0x01; b[44] = seq; b[45] = universe >> 8; b[46] = universe;
+  return 49;
+}
+
+struct Sender {
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  ~Sender(){ close(fd); }
+  void send(const uint8_t* b, size_t len, uint16_t port){
+    sockaddr_in a = {};
+    a.sin_family = AF_INET; a.sin_port = htons(port); a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sendto(fd, b, len, 0, (sockaddr*)&a, sizeof(a));
+  }
+};
+
+// Sends one frame; `skip` drops every skip-th packet (0 = none) to model loss.
+// Returns packets actually sent.
+uint32_t sendFrame(Sender& s, bool ddp, uint16_t n, uint32_t frame, uint32_t& pkt, int skip, uint32_t& skipped){
+  static uint8_t b[1500];
+  static uint8_t ddpSeq = 0, uniSeq[RT_MAX_UNIVERSES];
+  uint32_t sent = 0;
+  uint16_t parts = ddp ? (n + kDdpPixels - 1) / kDdpPixels : (n + RT_E131_PIXELS - 1) / RT_E131_PIXELS;
+  for (uint16_t p = 0; p < parts; p++, pkt++){
+    size_t len;
+    if (ddp){
+      ddpSeq = ddpSeq % 15 + 1;
+      uint32_t first = p * kDdpPixels;
+      uint16_t count = n - first < (uint32_t)kDdpPixels ? n - first : kDdpPixels;
+      len = ddpPacket(b, ddpSeq, first, count, p + 1 == parts, frame);
+      if (skip && pkt % skip == 0){ skipped++; continue; }
+      s.send(b, len, kDdpPort);
+    } else {
+      len = e131Packet(b, ++uniSeq[p], RT_E131_UNIVERSE + p, n, frame);
+      if (skip && pkt % skip == 0){ skipped++; continue; }
+      s.send(b, len, kE131Port);
+    }
+    sent++;
+  }
+  return sent;
+}
+
+bool frameIs(uint16_t n, uint32_t frame){
+  for (uint16_t i = 0; i < n; i++) if (px[i] != tag(frame, i)) return false;
+  return true;
+}
+
+void checks(){
+  uint8_t b[1500];
+  bool ok = true;
+  size_t len = ddpPacket(b, 1, 100, 50, true, 0);
+  RtSpan s = rtParseDdp(b, len, 120);
+  ok &= s.data && s.push && s.hdr == 10 && s.off == 300 && s.len == 60;   // clipped to 120 px
+  b[0] |= 0x10;                                                           // timecode: 4 more header bytes
+  ok &= rtParseDdp(b, len, 500).hdr == 14;
+  b[0] = 0x40 | 0x02;                                                     // query
+  ok &= rtParseDdp(b, len, 500).drop;
+  len = e131Packet(b, 1, RT_E131_UNIVERSE + 2, 500, 0);
+  s = rtParseE131(b, len, 500);
+  ok &= s.data && s.push && s.off == 2 * 170 * 3 && s.len == (500 - 340) * 3;
+  s = rtParseE131(b, len, 1000);
+  ok &= s.data && !s.push;
+  e131Packet(b, 1, RT_E131_UNIVERSE, 500, 0, 0x80);                       // preview data
+  ok &= !rtParseE131(b, 126, 500).data;
+  len = e131Sync(b, 1, 7);
+  s = rtParseE131(b, len, 500);
+  ok &= s.sync && s.universe == 7;
+  printf("header parsing: %s\n", benchCheck(ok));
+}
+
+}  // namespace
+
+void benchRealtime(){
+  checks();
+  static RtIngest rx;
+  if (!rx.begin(kDdpPort, kE131Port)){ printf("cannot bind loopback ports, skipped\n"); return; }
+  Sender tx;
+  const uint16_t kLengths[] = { 500, 1000, 2000, 4000 };
+  const int kFrames = 300;
+
+  // Lockstep: the next frame goes out once the last one was published, so
+  // the rate is the whole loopback path; rx us counts only time in poll().
+  printf("%-6s %6s %8s %10s %10s %8s %s\n", "proto", "leds", "pkts/fr", "rx us/fr", "fps", "frames", "content");
+  for (int proto = 0; proto < 2; proto++){
+    for (uint16_t n : kLengths){
+      bool ddp = proto == 0;
+      std::atomic<uint32_t> done{0};
+      uint32_t pkt = 0, skipped = 0, sent = 0;
+      std::thread th([&]{
+        for (int f = 0; f < kFrames; f++){
+          while (done.load() < (uint32_t)f) std::this_thread::yield();
+          sent += sendFrame(tx, ddp, n, f, pkt, 0, skipped);
+        }
+      });
+      double rxNs = 0; uint32_t bad = 0, before = rx.stats.frames;
+      BenchClock wall;
+      while (done.load() < (uint32_t)kFrames && wall.ns() < 5e9){
+        uint32_t pk = rx.stats.packets;
+        BenchClock c;
+        bool fr = rx.poll(px, n);
+        if (rx.stats.packets != pk) rxNs += c.ns();
+        if (fr){ bad += !frameIs(n, done.load()); done++; }
+      }
+      double wallNs = wall.ns();
+      th.join();
+      uint32_t got = rx.stats.frames - before;
+      printf("%-6s %6u %8.1f %10.1f %10.0f %8u %s\n", ddp ? "ddp" : "e1.31", n, (double)sent / kFrames,
+             rxNs / 1000 / (got ? got : 1), got * 1e9 / wallNs, got, benchCheck(!bad && got == (uint32_t)kFrames));
+    }
+  }
+
+  // Loss: every 7th packet dropped at the sender, paced at 40 fps.
+  printf("%-6s %6s %8s %8s %8s %8s\n", "proto", "leds", "sent", "skipped", "lost", "frames");
+  for (int proto = 0; proto < 2; proto++){
+    bool ddp = proto == 0;
+    uint16_t n = 2000;
+    uint32_t pkt = 1, skipped = 0, sent = 0;
+    RtStats s0 = rx.stats;
+    for (int f = 0; f < 40; f++){
+      sent += sendFrame(tx, ddp, n, f, pkt, 7, skipped);
+      BenchClock c;
+      while (c.ns() < 25e6) rx.poll(px, n);
+    }
+    printf("%-6s %6u %8u %8u %8u %8u\n", ddp ? "ddp" : "e1.31", n, sent, skipped,
+           rx.stats.lost - s0.lost, rx.stats.frames - s0.frames);
+  }
+
+  uint8_t b[1500];
+  size_t len = e131Packet(b, 0, RT_E131_UNIVERSE, 500, 0, 0x40);   // stream terminated
+  bool was = rx.active();
+  tx.send(b, len, kE131Port);
+  BenchClock c;
+  while (c.ns() < 5e6) rx.poll(px, 500);
+  printf("stream terminated hands back to modes: %s\n", benchCheck(was && !rx.active()));
+}
@@ -0,0 +1,93 @@
+// Deterministic replay: each case renders N frames of a mode from a seed and
+// parameter set on a virtual 60 fps clock and hashes every frame. The hash
+// must match its golden value, so a change that is meant to be output-neutral
+// (most optimizations) can be checked for identical pixels as well as speed.
+// A change that is meant to alter output prints the new value for the table.
+#include <string.h>
+#include "bench.h"
+#include "compositor.h"
+#include "effects.h"
+#include "power.h"
+#include "rng.h"
+
+namespace {
+
+struct ReplayCase {
+  const char* name; uint8_t mode; uint32_t seed; uint16_t leds; uint16_t frames;
+  uint8_t density, speed, hue, sat, life, fade; bool drift;
+  uint16_t rippleEvery;   // frames between triggered ripples, 0 = none
+  uint32_t golden;
+  uint8_t to = 0xFF;      // halfway through, switch to this mode...
+  uint16_t xfadeMs = 0;   // ...crossfading over this long
+};
+
+const ReplayCase kCases[] = {
+  { "fireflies",      0, 1,    500, 1200, 35,  50, 45, 200, 50, 240, true,   0, 0xdb522309 },
+  { "fireflies busy", 0, 7,   2000,  600, 100, 100, 10, 255, 10, 220, false, 0, 0x3e9b4d08 },
+  { "sync",           1, 1,    500,  600, 35,  50, 45, 200, 50, 240, true,  40, 0xa5e65d07 },
+  { "wave",           2, 1,    500,  600, 35,  80, 45, 200, 50, 240, false,  0, 0x895dd23a },
+  { "twinkle",        3, 3,    500, 1200, 90,  50, 90, 180, 50, 240, false,  0, 0xd24d0666 },
+  { "swarm",          4, 1,   1000,  600, 35,  50, 45, 200, 50, 240, true,   0, 0x85684afa },
+  { "ripples",        5, 5,    500,  900, 60,  50, 45, 200, 50, 240, false, 20, 0xe0ec1583 },
+  { "swarm+ripples",  4, 9,   2000,  600, 35,  90, 45, 200, 50, 240, true,  25, 0xa3ec57c5 },
+  { "fireflies>wave", 0, 4,   1000,  600, 50,  60, 30, 220, 40, 235, true,  30, 0x74f53455, 2, 3000 },
+};
+
+// FNV-1a over every frame's bytes, chained across the run
+inline uint32_t hashFrame(uint32_t h, const CRGB* px, uint16_t n){
+  const uint8_t* p = (const uint8_t*)px;
+  for (uint32_t i = 0; i < (uint32_t)n * 3; i++){ h ^= p[i]; h *= 16777619u; }
+  return h;
+}
+
+// One run; returns the chained hash and the render time per frame.
+uint32_t replay(const ReplayCase& c, uint32_t seed, double& nsPerFrame){
+  Layout l = { 1, { { LED_PIN, c.leds, 0 } } };
+  gNumLeds = c.leds; gPower.setLayout(l);
+  gMode = c.mode; gDensity = c.density; gSpeed = c.speed; gHueBase = c.hue;
+  gSaturation = c.sat; gLifespan = c.life; gFade = c.fade; gAutoHueDrift = c.drift;
+  effectsReset(seed);
+  alignas(4) static CRGB out[NUM_LEDS];
+  uint32_t h = 2166136261u, prev = 0;
+  double ns = 0;
+  for (uint16_t f = 0; f < c.frames; f++){
+    uint32_t ms = (uint32_t)f * 1000 / 60;
+    gFrameMs = ms;
+    if (c.rippleEvery && f % c.rippleEvery == 0) triggerRipple();
+    if (f == c.frames / 2 && c.to != 0xFF){ gComp.crossfade(c.xfadeMs); gMode = c.to; }
+    BenchClock clk;
+    gComp.frame(out, (ms - prev) / 1000.0f);
+    ns += clk.ns();
+    prev = ms;
+    h = hashFrame(h, out, c.leds);
+  }
+  nsPerFrame = ns / c.frames;
+  return h;
+}
+
+}  // namespace
+
+void benchReplay(){
+  printf("%-15s %6s %6s %10s %10s %10s\n", "case", "leds", "frames", "ns/frame", "hash", "golden");
+  int bad = 0;
+  for (const ReplayCase& c : kCases){
+    double ns, ns2, ns3;
+    uint32_t h = replay(c, c.seed, ns);
+    bool same = replay(c, c.seed, ns2) == h;          // deterministic
+    bool seeded = replay(c, c.seed + 1, ns3) != h;    // wave and swarm draw nothing random
+    bool ok = same && h == c.golden;
+    bad += !ok;
+    printf("%-15s %6u %6u %10.0f   %08x   %08x %s%s%s\n", c.name, c.leds, c.frames, (ns + ns2) / 2, h, c.golden,
+           benchCheck(ok), same ? "" : " (not deterministic)", seeded ? "" : " (no random draws)");
+  }
+  printf("%s\n", benchCheck(!bad, "all frames identical to golden", "output changed: update the golden hashes only if that was intended"));
+
+  Rng r; r.seed(1);
+  const int kN = 10000000;
+  BenchClock clk;
+  uint32_t acc = 0;
+  for (int i = 0; i < kN; i++) acc += r.below(500);
+  benchKeep(acc);
+  printf("Rng::below: %.2f ns per draw\n", clk.ns() / kN);
+  effectsReset(1);
+}
@@ -0,0 +1,147 @@
+// /schedule parser: behaviour checks, a chunking-invariance fuzz, and
+// throughput against a port of the old String/indexOf handler.
+#include <random>
+#include <string>
+#include <string.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "sched_json.h"
+
+namespace {
+
+struct Parsed { bool ok; Schedule s; size_t err; uint16_t dropped; };
+
+Parsed parse(const std::string& doc, size_t chunk){
+  static SchedParser p;
+  p.begin();
+  bool ok = true;
+  for (size_t o = 0; o < doc.size() && ok; o += chunk)
+    ok = p.feed((const uint8_t*)doc.data() + o, std::min(chunk, doc.size() - o));
+  ok = ok && p.finish();
+  return { ok, p.result(), p.errorAt(), p.dropped() };
+}
+
+bool same(const Parsed& a, const Parsed& b){
+  if (a.ok != b.ok || a.s.count != b.s.count || a.dropped != b.dropped) return false;
+  if (!a.ok && a.err != b.err) return false;
+  for (uint8_t i = 0; i < a.s.count; i++){
+    const SchedItem &x = a.s.items[i], &y = b.s.items[i];
+    if (x.mode != y.mode || x.duration_ms != y.duration_ms || x.set != y.set || x.xfade_ms != y.xfade_ms) return false;
+    for (uint8_t f = 0; f < SF_COUNT; f++) if ((x.set >> f & 1) && x.val[f] != y.val[f]) return false;
+  }
+  return true;
+}
+
+std::string uiDoc(int items, bool params){
+  std::string d = "{\"items\":[";
+  for (int i = 0; i < items; i++){
+    char b[160];
+    snprintf(b, sizeof(b), "%s{\"mode\":%d,\"seconds\":%d%s}", i ? "," : "", i % 6, 5 + i,
+             params ? ",\"bright\":120,\"density\":35,\"speed\":50,\"hue\":40,\"sat\":255,\"life\":50,\"fade\":245,\"drift\":true" : "");
+    d += b;
+  }
+  return d + "]}";
+}
+
+// The handler this replaced, ported to std::string: builds the body a byte at
+// a time, then indexOf/substring/toInt per item. One chunk only.
+uint8_t oldParse(const uint8_t* data, size_t len, Schedule& sch){
+  sch.count = 0;
+  std::string body; body.reserve(len + 1);
+  for (size_t i = 0; i < len; i++) body += (char)data[i];
+  size_t pos = 0;
+  while (sch.count < MAX_SCHEDULE_ITEMS){
+    size_t mPos = body.find("\"mode\"", pos); if (mPos == std::string::npos) break;
+    size_t colon = body.find(':', mPos); if (colon == std::string::npos) break;
+    size_t comma = body.find(',', colon), endBrace = body.find('}', colon);
+    size_t stop = std::min(comma, endBrace);
+    uint8_t mode = (uint8_t)atol(body.substr(colon + 1, stop - colon - 1).c_str());
+    size_t tPos = body.find("\"seconds\"", stop);
+    bool usedSeconds = true;
+    if (tPos == std::string::npos){ tPos = body.find("\"minutes\"", stop); usedSeconds = false; }
+    if (tPos == std::string::npos) break;
+    size_t tColon = body.find(':', tPos); if (tColon == std::string::npos) break;
+    size_t tComma = body.find(',', tColon), tEnd = body.find('}', tColon);
+    size_t tStop = std::min(tComma, tEnd);
+    uint32_t amount = (uint32_t)atol(body.substr(tColon + 1, tStop - tColon - 1).c_str());
+    sch.items[sch.count++] = { mode, usedSeconds ? amount * 1000 : amount * 60000, 0, {}, 0 };
+    pos = tStop;
+  }
+  return sch.count;
+}
+
+void checks(){
+  bool ok = true;
+  Parsed r = parse(uiDoc(3, false), 1 << 20);
+  ok &= r.ok && r.s.count == 3 && r.s.items[2].mode == 2 && r.s.items[2].duration_ms == 7000 && !r.s.items[0].set;
+  r = parse(uiDoc(1, true), 1 << 20);
+  ok &= r.ok && r.s.items[0].set == 0xFF && r.s.items[0].val[SF_HUE] == 40 && r.s.items[0].val[SF_DRIFT] == 1;
+  r = parse(" [ {\"minutes\":1.5,\"mode\":4,\"x\":{\"a\":[1,{\"mode\":9}],\"b\":\"\\\"}\\u00e9\"},\"hue\":-3} ,"
+            "{\"ms\":2.5e3,\"sat\":999},{\"mode\":1},{\"seconds\":0},{\"mode\":6,\"seconds\":5} ] ", 1 << 20);
+  ok &= r.ok && r.s.count == 2 && r.dropped == 3 && r.s.items[0].mode == 4 && r.s.items[0].duration_ms == 90000
+        && r.s.items[0].val[SF_HUE] == 0 && r.s.items[1].duration_ms == 2500 && r.s.items[1].val[SF_SAT] == 255;
+  r = parse("[{\"seconds\":5,\"xfade\":1.25},{\"seconds\":5,\"xfade\":90},{\"seconds\":5,\"xfade\":-1}]", 1 << 20);
+  ok &= r.ok && r.s.count == 3 && r.s.items[0].xfade_ms == 1250 && r.s.items[1].xfade_ms == 60000 && r.s.items[2].xfade_ms == 0;
+  r = parse(uiDoc(MAX_SCHEDULE_ITEMS + 6, false), 1 << 20);
+  ok &= r.ok && r.s.count == MAX_SCHEDULE_ITEMS && r.dropped == 6;
+  ok &= parse("{\"items\":[]}", 1).ok && parse("[]", 1).ok && parse("{}", 1).ok;
+  const char* bad[] = { "", "{", "[1,]", "{\"items\":[{\"mode\":01}]}", "{\"a\" 1}", "[1 2]", "{\"a\":tru}",
+                        "[\"\\x\"]", "[1]]", "{\"a\":1,}", "[-]", "[1.]", "[1e]", "\"a\nb\"", "[[[[[[[[[[[[[[[[[1]]]]]]]]]]]]]]]]]" };
+  for (const char* b : bad) ok &= !parse(b, 1).ok;
+  printf("behaviour checks: %s\n", benchCheck(ok));
+}
+
+// Mutates a valid document (byte flips, inserts, deletes, truncation, splices
+// of JSON punctuation) and checks every chunking gives the same outcome.
+void fuzz(){
+  std::mt19937 rng(1234);
+  const std::string seed = uiDoc(8, true);
+  const char kPunct[] = "{}[]:,\"\\-.0123456789eE+truefalsenull \t\n";
+  uint32_t cases = 0, accepted = 0, mismatches = 0, bounds = 0;
+  for (; cases < 200000; cases++){
+    std::string d = seed;
+    int edits = 1 + rng() % 6;
+    for (int e = 0; e < edits && !d.empty(); e++){
+      size_t at = rng() % d.size();
+      switch (rng() % 5){
+        case 0: d[at] = (char)(rng() & 0xFF); break;
+        case 1: d.insert(d.begin() + at, kPunct[rng() % (sizeof(kPunct) - 1)]); break;
+        case 2: d.erase(at, 1 + rng() % 4); break;
+        case 3: d.resize(at); break;
+        case 4: d.insert(at, d.substr(rng() % d.size(), rng() % 24)); break;
+      }
+    }
+    Parsed whole = parse(d, 1 << 20), bytes = parse(d, 1), odd = parse(d, 1 + rng() % 64);
+    if (!same(whole, bytes) || !same(whole, odd)) mismatches++;
+    if (whole.s.count > MAX_SCHEDULE_ITEMS || (!whole.ok && whole.err > d.size())) bounds++;
+    accepted += whole.ok;
+  }
+  printf("fuzz: %u cases, %u still valid, chunking mismatches %u, bounds %u %s\n", cases, accepted,
+         mismatches, bounds, benchCheck(!mismatches && !bounds));
+}
+
+}  // namespace
+
+void benchSchedJson(){
+  checks();
+  fuzz();
+  printf("%6s %-7s %8s %10s %10s %10s\n", "items", "params", "bytes", "new MB/s", "old MB/s", "new us");
+  const int kCounts[] = { 8, 20, 64 };
+  for (int n : kCounts){
+    for (int withParams = 0; withParams < 2; withParams++){
+      std::string d = uiDoc(n, withParams);
+      const int kIter = 20000;
+      static SchedParser p;
+      BenchClock c;
+      for (int i = 0; i < kIter; i++){ p.begin(); p.feed((const uint8_t*)d.data(), d.size()); benchKeep(p.finish()); }
+      double nsNew = c.ns() / kIter;
+      Schedule s;
+      BenchClock c2;
+      for (int i = 0; i < kIter; i++) benchKeep(oldParse((const uint8_t*)d.data(), d.size(), s));
+      double nsOld = c2.ns() / kIter;
+      printf("%6d %-7s %8zu %10.0f %10.0f %10.1f\n", n, withParams ? "yes" : "no", d.size(),
+             d.size() * 1e3 / nsNew, d.size() * 1e3 / nsOld, nsNew / 1000);
+    }
+  }
+  printf("(old handler: one chunk only, mode+duration only, heap per substring)\n");
+}
@@ -0,0 +1,19 @@
+// Output time vs segment count, from the WS281x wire model in segments.h.
+// Pixels are split as evenly as the layout allows; the longest segment sets
+// the frame's wire time because the RMT channels transmit in parallel.
+#include "bench.h"
+#include "segments.h"
+
+void benchSegments(){
+  const uint16_t kTotals[] = { 500, 2000, 4000, 8000 };
+  const uint8_t kSegs[] = { 1, 2, 4, 6, 8 };
+  printf("%6s %5s %8s %10s %8s\n", "leds", "segs", "longest", "wire us", "max fps");
+  for (uint16_t n : kTotals){
+    for (uint8_t k : kSegs){
+      Layout l; l.count = k;
+      for (uint8_t i = 0; i < k; i++) l.seg[i] = { 0, (uint16_t)(n / k + (i < n % k)), 0 };
+      uint32_t us = layoutWireUs(l);
+      printf("%6u %5u %8u %10u %8.1f%s\n", n, k, l.seg[0].count, us, 1e6 / us, 1e6 / us >= 60 ? "" : "  < 60");
+    }
+  }
+}
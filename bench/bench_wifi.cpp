@@ -0,0 +1,170 @@
+// Wi-Fi connection manager against a scripted radio on a virtual clock:
+// which network it joins, how long that takes, and that no tick ever waits.
+// "old block" is how long the blocking setupWiFi() kept the first frame dark.
+#include <string.h>
+#include <vector>
+#include "bench.h"
+#include "wifi_manager.h"
+
+namespace {
+
+struct Ap { const char* ssid; const char* pass; int8_t rssi; uint8_t bssid[6]; uint8_t channel; };
+
+// Scripted radio. Scans take kScanMs; a join takes kJoinMs, or fails after
+// kFailMs on a wrong password or a BSSID/channel that is not on the air.
+class MockRadio : public WifiDriver {
+public:
+  static const uint32_t kScanMs = 2200, kJoinMs = 900, kFailMs = 1500;
+  std::vector<Ap> air;
+  uint32_t now = 0;
+  int scans = 0, joins = 0, clients = 0;
+  bool apUp = false;
+
+  void set(std::initializer_list<Ap> l){ air.clear(); for (const Ap& a : l) air.push_back(a); }
+
+  void staMode(bool keepAp) override { if (!keepAp) apUp = false; }
+  void scanStart() override { scans++; mScanAt = now + kScanMs; }
+  int scanResults(WifiSeen* out, int max) override {
+    if (!mScanAt || now < mScanAt) return -1;
+    mScanAt = 0;
+    int k = 0;
+    for (const Ap& a : air){
+      if (k == max) break;
+      strcpy(out[k].ssid, a.ssid); out[k].rssi = a.rssi; memcpy(out[k].bssid, a.bssid, 6); out[k].channel = a.channel;
+      k++;
+    }
+    return k;
+  }
+  void connect(const char* ssid, const char* pass, const uint8_t* bssid, uint8_t channel) override {
+    joins++;
+    mOk = false;
+    for (const Ap& a : air)
+      if (!strcmp(a.ssid, ssid) && !strcmp(a.pass, pass) && (!bssid || !memcmp(a.bssid, bssid, 6)) && (!channel || a.channel == channel)) mOk = true;
+    mDoneAt = now + (mOk ? kJoinMs : kFailMs);
+    mState = WL_LINK_CONNECTING;
+  }
+  WifiLink link() override {
+    if (mState == WL_LINK_CONNECTING && now >= mDoneAt) mState = mOk ? WL_LINK_UP : WL_LINK_FAILED;
+    return mState;
+  }
+  void disconnect() override { mState = WL_LINK_IDLE; }
+  void startAP() override { apUp = true; }
+  int apClients() override { return clients; }
+  void drop(){ mState = WL_LINK_FAILED; }
+
+private:
+  uint32_t mScanAt = 0, mDoneAt = 0;
+  bool mOk = false;
+  WifiLink mState = WL_LINK_IDLE;
+};
+
+WifiList nets(std::initializer_list<std::pair<const char*, const char*>> l){
+  WifiList w = {};
+  for (auto& p : l){ strcpy(w.net[w.count].ssid, p.first); strcpy(w.net[w.count].pass, p.second); w.count++; }
+  return w;
+}
+
+// Ticks every 16 ms (a frame) until `until` or the state is reached.
+uint32_t runUntil(WifiManager& m, MockRadio& r, WifiState want, uint32_t limitMs, double& worstTickNs){
+  uint32_t start = r.now;
+  while (r.now - start < limitMs){
+    BenchClock c;
+    m.tick(r.now);
+    double ns = c.ns(); if (ns > worstTickNs) worstTickNs = ns;
+    if (m.state() == want) return r.now - start;
+    r.now += 16;
+  }
+  return UINT32_MAX;
+}
+
+const Ap kHome  = { "home",   "pw1", -71, { 1,1,1,1,1,1 },  6 };
+const Ap kHome2 = { "home",   "pw1", -48, { 1,1,1,1,1,2 }, 11 };   // same SSID, closer AP
+const Ap kShop  = { "shop",   "pw2", -55, { 2,2,2,2,2,2 },  1 };
+const Ap kOther = { "nearby", "x",   -40, { 3,3,3,3,3,3 },  3 };
+
+struct Case { const char* name; bool ok; uint32_t ms, oldMs; const char* note; };
+
+}  // namespace
+
+void benchWifi(){
+  std::vector<Case> cases;
+  double worst = 0;
+
+  { // strongest saved network wins, a missing one costs nothing
+    MockRadio r; r.set({ kHome, kShop, kOther });
+    WifiManager m(r);
+    m.begin(nets({ { "gone", "a" }, { "home", "pw1" }, { "shop", "pw2" } }), nullptr, 0);
+    uint32_t t = runUntil(m, r, WS_UP, 60000, worst);
+    cases.push_back({ "rank by rssi", t != UINT32_MAX && !strcmp(m.fast().ssid, "shop"), t, 10000 + MockRadio::kJoinMs, "gone skipped, shop -55 over home -71" });
+  }
+  { // same SSID on two APs: the nearer BSSID
+    MockRadio r; r.set({ kHome, kHome2 });
+    WifiManager m(r);
+    m.begin(nets({ { "home", "pw1" } }), nullptr, 0);
+    uint32_t t = runUntil(m, r, WS_UP, 60000, worst);
+    cases.push_back({ "best bssid", t != UINT32_MAX && m.fast().channel == 11 && m.fastChanged, t, MockRadio::kJoinMs, "ch 11 -48 over ch 6 -71" });
+  }
+  { // wrong password: next candidate after the auth failure, not a timeout
+    MockRadio r; r.set({ kHome, kShop });
+    WifiManager m(r);
+    m.begin(nets({ { "shop", "wrong" }, { "home", "pw1" } }), nullptr, 0);
+    uint32_t t = runUntil(m, r, WS_UP, 60000, worst);
+    cases.push_back({ "auth failure", t != UINT32_MAX && !strcmp(m.fast().ssid, "home"), t, MockRadio::kFailMs + MockRadio::kJoinMs, "falls through on the failure event" });
+  }
+  { // cached BSSID/channel: joins without scanning
+    MockRadio r; r.set({ kHome, kShop });
+    WifiFast f = {}; strcpy(f.ssid, "home"); memcpy(f.bssid, kHome.bssid, 6); f.channel = kHome.channel;
+    WifiManager m(r);
+    m.begin(nets({ { "home", "pw1" } }), &f, 0);
+    uint32_t t = runUntil(m, r, WS_UP, 60000, worst);
+    cases.push_back({ "fast reconnect", t != UINT32_MAX && r.scans == 0 && !m.fastChanged, t, MockRadio::kJoinMs, "no scan, no flash write" });
+  }
+  { // stale cache (AP moved channel): fast attempt fails, scan finds it
+    MockRadio r; Ap moved = kHome; moved.channel = 1; r.set({ moved });
+    WifiFast f = {}; strcpy(f.ssid, "home"); memcpy(f.bssid, kHome.bssid, 6); f.channel = kHome.channel;
+    WifiManager m(r);
+    m.begin(nets({ { "home", "pw1" } }), &f, 0);
+    uint32_t t = runUntil(m, r, WS_UP, 60000, worst);
+    cases.push_back({ "stale cache", t != UINT32_MAX && r.scans == 1 && m.fast().channel == 1, t, MockRadio::kJoinMs, "cache refreshed" });
+  }
+  { // link drop while up: same AP again without a scan
+    MockRadio r; r.set({ kShop });
+    WifiManager m(r);
+    m.begin(nets({ { "shop", "pw2" } }), nullptr, 0);
+    runUntil(m, r, WS_UP, 60000, worst);
+    int scans = r.scans;
+    r.drop();
+    m.tick(r.now); r.now += 16;
+    uint32_t t = runUntil(m, r, WS_UP, 60000, worst);
+    cases.push_back({ "link drop", t != UINT32_MAX && r.scans == scans, t, UINT32_MAX, "rejoins the cached AP" });
+  }
+  { // nothing reachable: AP right after one scan, rescans only when nobody is on the AP
+    MockRadio r; r.set({ kOther });
+    WifiManager m(r);
+    m.begin(nets({ { "home", "pw1" }, { "shop", "pw2" } }), nullptr, 0);
+    uint32_t t = runUntil(m, r, WS_AP, 60000, worst);
+    bool ok = t != UINT32_MAX && r.apUp;
+    r.clients = 1;
+    runUntil(m, r, WS_SCAN, WIFI_AP_RETRY_MS + 5000, worst);
+    ok &= r.scans == 1;                        // a phone on the AP is left alone
+    r.clients = 0; r.air.push_back(kShop);     // network comes back
+    uint32_t t2 = runUntil(m, r, WS_UP, WIFI_AP_RETRY_MS + 10000, worst);
+    ok &= t2 != UINT32_MAX && !r.apUp;
+    cases.push_back({ "fallback AP", ok, t, 2 * 10000, "then rejoins when shop appears" });
+  }
+  { // no saved networks: AP on the first call
+    MockRadio r;
+    WifiManager m(r);
+    m.begin(nets({}), nullptr, 0);
+    cases.push_back({ "no networks", m.state() == WS_AP && r.apUp, 0, 10000, "" });
+  }
+
+  // old block: how long the blocking setupWiFi() kept the first frame dark
+  printf("%-15s %8s %10s\n", "case", "join ms", "old block");
+  for (const Case& c : cases){
+    char old[16];
+    if (c.oldMs == UINT32_MAX) snprintf(old, sizeof(old), "-"); else snprintf(old, sizeof(old), "%u", c.oldMs);
+    printf("%-15s %8u %10s %s  %s\n", c.name, c.ms, old, benchCheck(c.ok), c.note);
+  }
+  printf("worst tick: %.0f ns; the render loop never waits on Wi-Fi\n", worst);
+}
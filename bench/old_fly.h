@@ -0,0 +1,55 @@
+#pragma once
+// The firefly trail as Fireflies drew it before the 16-bit accumulator
+// (accum.h), verbatim: the i*i/255 brightness curve read through the Q16
+// envelope, and the 8-bit lit-pixel fade. Kept for bench_accum and
+// bench_envelope only.
+#include "fly_envelope.h"
+#include "litset.h"
+#include "power.h"
+
+// kFlyCurve[i] = i*i/255, the old (a*a)*255 brightness curve sampled at a = i/255.
+static const uint8_t kFlyCurve[256] = {
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  1,  1,  1,  1,  1,  1,  2,  2,  2,  2,  2,  3,  3,  3,  3,
+    4,  4,  4,  4,  5,  5,  5,  5,  6,  6,  6,  7,  7,  7,  8,  8,
+    9,  9,  9, 10, 10, 11, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15,
+   16, 16, 17, 17, 18, 18, 19, 19, 20, 20, 21, 22, 22, 23, 23, 24,
+   25, 25, 26, 27, 27, 28, 29, 29, 30, 31, 31, 32, 33, 33, 34, 35,
+   36, 36, 37, 38, 39, 40, 40, 41, 42, 43, 44, 44, 45, 46, 47, 48,
+   49, 50, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63,
+   64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 79, 80,
+   81, 82, 83, 84, 85, 87, 88, 89, 90, 91, 93, 94, 95, 96, 97, 99,
+  100,101,102,104,105,106,108,109,110,112,113,114,116,117,118,120,
+  121,122,124,125,127,128,129,131,132,134,135,137,138,140,141,143,
+  144,146,147,149,150,152,153,155,156,158,160,161,163,164,166,168,
+  169,171,172,174,176,177,179,181,182,184,186,188,189,191,193,195,
+  196,198,200,202,203,205,207,209,211,212,214,216,218,220,222,224,
+  225,227,229,231,233,235,237,239,241,243,245,247,249,251,253,255,
+};
+
+// flyEnvStage, as the curve brightness.
+inline bool flyEnvStep(FlyEnv& e, uint32_t step, uint8_t& v){
+  uint8_t a;
+  if (!flyEnvStage(e, step, a)) return false;
+  v = kFlyCurve[a];
+  return true;
+}
+
+// nscale8_video(scale), then snap pixels with every channel below `snap` to
+// black; rebuilds gPower's sums like the litset.h kernels.
+inline void litFadeVideo(CRGB* px, LitSet& lit, uint8_t scale, uint8_t snap){
+  PowerWalk sum;
+  for (uint16_t k = 0; k < LitSet::kWords; k++){
+    uint32_t m = lit.w[k];
+    if (!m) continue;
+    uint32_t keep = m;
+    do {
+      uint8_t b = __builtin_ctz(m); m &= m - 1;
+      CRGB& c = px[(k << 5) + b];
+      c.nscale8_video(scale);
+      if (c.r < snap && c.g < snap && c.b < snap){ c = CRGB::Black; keep &= ~(1UL << b); }
+      else sum.add((k << 5) + b, c);
+    } while (m);
+    lit.w[k] = keep;
+  }
+}
@@ -0,0 +1,351 @@
+#pragma once
+// The two pages as main.cpp served them before the UI moved into flash
+// assets (ui_assets.h), verbatim: the control page literal and the /wifi
+// page builder. Kept for bench_assets only.
+#include <Arduino.h>
+
+static const char* OLD_HTML = R"HTML(
+<!doctype html><html><head><meta name=viewport content='width=device-width,initial-scale=1'>
+<title>Fireflies</title>
+<style>
+:root{--bg:#0b0d12;--card:#121725;--text:#e6ecf2;--muted:#95a2b0;--acc:#5ee06c;--rail:#2b3246;--handle:#2a9241;}
+*{box-sizing:border-box} body{margin:0;background:var(--bg);color:var(--text);font:16px/1.45 system-ui,-apple-system,Segoe UI,Roboto,Helvetica,Arial}
+.wrap{max-width:880px;margin:32px auto;padding:0 18px}
+.card{background:var(--card);border-radius:14px;padding:18px;margin:14px 0;box-shadow:0 6px 18px rgba(0,0,0,.28)}
+h2{margin:8px 0 14px}
+label{display:flex;justify-content:space-between;align-items:center;margin:12px 0 6px}
+.val{opacity:.85;font-variant-numeric:tabular-nums}
+select,input[type=range],button{width:100%}
+input[type=range]{accent-color:var(--acc)}
+.hint{color:var(--muted);font-size:.9em;margin:-2px 0 10px}
+.row{display:grid;grid-template-columns:1fr 1fr;gap:14px}
+@media (max-width:740px){.row{grid-template-columns:1fr}}
+.btn{margin-top:10px;padding:12px 14px;border:0;border-radius:10px;background:var(--acc);color:#06210b;font-weight:700}
+.btn.secondary{background:#2f3548;color:#d9e0ea}
+.bar{height:10px;border-radius:8px;background:var(--rail);overflow:hidden}
+.footer{color:var(--muted);font-size:.85em;margin-top:10px}
+.sched-list{list-style:none;margin:0;padding:0}
+.sched-item{display:flex;align-items:center;gap:8px;background:#0f1320;border:1px solid #242a3a;border-radius:10px;padding:10px;margin:8px 0;cursor:grab}
+.handle{width:14px;height:14px;border-radius:4px;background:var(--handle)}
+.mode-badge{font-weight:600}
+.small{font-size:.9em;color:var(--muted)}
+</style></head><body><div class=wrap>
+<h2>Fireflies Controller</h2>
+<div id="apBanner" class="hint" style="display:none">AP mode: connect your phone to <b>Fireflies-Setup</b> and open <b>http://192.168.4.1/wifi</b> to join a network.</div>
+<div class=card>
+  <label>Mode
+    <select id=mode>
+      <option value=0>Fireflies</option>
+      <option value=1>Sync Pulse</option>
+      <option value=2>Wave</option>
+      <option value=3>Twinkle</option>
+      <option value=4>Swarm</option>
+      <option value=5>Ripples (standalone)</option>
+    </select>
+  </label>
+  <div class=hint>Choose the base animation. The Ripple button below now works on <em>any</em> mode as an overlay.</div>
+
+  <div class=row>
+    <div>
+      <label>Brightness <span class=val id=vbright></span></label>
+      <input type=range id=bright min=1 max=255 value=80>
+      <div class=hint>Overall output level. Lower if your PSU gets warm.</div>
+    </div>
+    <div>
+      <label>Density / Intensity <span class=val id=vdensity></span></label>
+      <input type=range id=density min=0 max=100 value=35>
+      <div class=hint>How many lights are active at once (mode-dependent).</div>
+    </div>
+  </div>
+
+  <div class=row>
+    <div>
+      <label>Speed <span class=val id=vspeed></span></label>
+      <input type=range id=speed min=1 max=100 value=50>
+      <div class=hint>Animation tempo.</div>
+    </div>
+    <div>
+      <label>Hue <span class=val id=vhue></span></label>
+      <input type=range id=hue min=0 max=255 value=45>
+      <div class=hint>Base color; enable drift for subtle wandering.</div>
+    </div>
+  </div>
+
+  <div class=row>
+    <div>
+      <label>Saturation <span class=val id=vsat></span></label>
+      <input type=range id=sat min=0 max=255 value=200>
+      <div class=hint>Color purity. Lower for pastel fireflies.</div>
+    </div>
+    <div>
+      <label>Lifespan <span class=val id=vlife></span></label>
+      <input type=range id=life min=1 max=100 value=50>
+      <div class=hint>How long each firefly lives. Lower = quicker blink.</div>
+    </div>
+  </div>
+
+  <label>Background Fade <span class=val id=vfade></span></label>
+  <input type=range id=fade min=200 max=250 value=240>
+  <div class=hint>How fast the whole scene clears to black. Lower = faster.</div>
+
+  <div style="display:flex;align-items:center;gap:10px;margin-top:8px">
+    <input type=checkbox id=drift checked>
+    <label for=drift style="margin:0">Auto hue drift</label>
+  </div>
+
+  <button class=btn id=rippleBtn>Create Ripple</button>
+  <div class=hint>Triggers an expanding wave overlay on top of the current mode.</div>
+
+  <div class=card style="margin-top:16px">
+    <h3 style="margin:0 0 8px">Live preview</h3>
+    <canvas id=pvCanvas width=800 height=48 style="width:100%;background:#000;border-radius:8px;image-rendering:pixelated"></canvas>
+    <label>Preview rate <span class=val id=vpv></span></label>
+    <input type=range id=pv min=0 max=30 value=10>
+    <div class=hint>Frames per second streamed to this page (0 = off). On a slow link frames are dropped, not queued.</div>
+  </div>
+
+  <div class=card style="margin-top:16px">
+    <h3 style="margin:0 0 8px">Wi-Fi</h3>
+    <div class=hint>Save the networks you use. The device will try them at boot, in the order listed below.</div>
+
+    <ul id="wifiList" class="sched-list" style="margin-top:8px"></ul>
+
+    <div class=row>
+      <div>
+        <label>SSID</label>
+        <input id="nwSsid" placeholder="Network name">
+      </div>
+      <div>
+        <label>Password</label>
+        <input id="nwPass" type="password" placeholder="Password">
+      </div>
+    </div>
+    <div class=row>
+      <button class="btn secondary" id="addNet">Add network</button>
+      <a class="btn secondary" href="/wifi_setup">Start Setup Hotspot</a>
+    </div>
+    <div class=row>
+      <a class="btn secondary" href="/wifi">Open Wi-Fi Setup</a>
+      <button class="btn" id="tryNets">Try saved networks now</button>
+    </div>
+    <div class="small" id="wifiMsg" style="margin-top:6px;opacity:.85"></div>
+  </div>
+</div>
+
+<div class=card>
+  <h2 style="margin-top:0">Scheduler</h2>
+  <div class=hint>Build a simple timeline: choose a mode, set duration, press <b>Add</b>. Drag to reorder. Press <b>Send to ESP32</b> to start looping.</div>
+  <div class=row>
+    <div>
+      <label>Mode</label>
+      <select id=schMode>
+        <option value=0>Fireflies</option>
+        <option value=3>Twinkle</option>
+        <option value=4>Swarm</option>
+        <option value=2>Wave</option>
+        <option value=1>Sync Pulse</option>
+        <option value=5>Ripples (standalone)</option>
+      </select>
+    </div>
+    <div>
+      <label>Duration</label>
+      <div class=row>
+        <input type=number id=schMin min=0 max=180 value=0 style="width:100%" placeholder="min">
+        <input type=number id=schSec min=0 max=59 value=10 style="width:100%" placeholder="sec">
+      </div>
+      <div class="small" style="opacity:.8">Minutes and seconds (0–180 min, 0–59 sec).</div>
+    </div>
+  </div>
+  <div class=row>
+    <button class="btn" id=addItem>Add</button>
+    <button class="btn secondary" id=clearItems>Clear</button>
+  </div>
+  <ul class=sched-list id=schedList></ul>
+  <button class="btn" id=sendSched>Send to ESP32</button>
+  <div class="footer small">The schedule loops continuously on the device until you clear or send a new one.</div>
+</div>
+
+<script>
+// ----- Helpers -----
+const qs=id=>document.getElementById(id);
+const state={};
+
+fetch('/whoami').then(r=>r.json()).then(j=>{
+  const b=document.getElementById('apBanner'); if(!b) return;
+  if(j && j.ap){ b.style.display='block'; }
+}).catch(()=>{});
+
+function upd(){
+  qs('vbright').textContent=qs('bright').value;
+  qs('vdensity').textContent=qs('density').value;
+  qs('vspeed').textContent=qs('speed').value;
+  qs('vhue').textContent=qs('hue').value;
+  qs('vsat').textContent=qs('sat').value;
+  qs('vlife').textContent=qs('life').value;
+  qs('vfade').textContent=qs('fade').value;
+  qs('vpv').textContent=qs('pv').value;
+}
+
+// ----- Control channel -----
+// Binary (field,value) pairs over /ws, coalesced to one frame per animation
+// frame with the latest value per field. Falls back to /set while the socket is down.
+const FIELDS={mode:0,bright:1,density:2,speed:3,hue:4,sat:5,life:6,fade:7,drift:8,ripple:9,pv:10};
+let ws=null, dirty={}, flushQueued=false;
+function wsOpen(){
+  ws=new WebSocket('ws://'+location.host+'/ws'); ws.binaryType='arraybuffer';
+  ws.onclose=()=>{ ws=null; setTimeout(wsOpen,1000); };
+}
+wsOpen();
+function fieldVal(id){ return id==='drift' ? (qs('drift').checked?1:0) : +qs(id).value; }
+function queueParam(id,v){
+  dirty[id]=v;
+  if(!flushQueued){ flushQueued=true; requestAnimationFrame(flush); }
+}
+function flush(){
+  flushQueued=false;
+  const ids=Object.keys(dirty); if(!ids.length) return;
+  if(ws && ws.readyState===1){
+    if(ws.bufferedAmount>0){ flushQueued=true; requestAnimationFrame(flush); return; } // keep coalescing
+    const b=new Uint8Array(ids.length*2);
+    ids.forEach((id,i)=>{ b[2*i]=FIELDS[id]; b[2*i+1]=dirty[id]; });
+    ws.send(b);
+  } else {
+    if(dirty.ripple!==undefined){ fetch('/ripple'); delete dirty.ripple; }
+    if(Object.keys(dirty).length) fetch('/set?'+new URLSearchParams(dirty));
+  }
+  dirty={};
+}
+
+['mode','bright','density','speed','hue','sat','life','fade','drift','pv'].forEach(id=>{
+  qs(id).addEventListener(id==='mode'?'change':'input', ()=>{ upd(); queueParam(id, fieldVal(id)); });
+});
+
+// Ripple overlay works on any mode now
+qs('rippleBtn').addEventListener('click', ()=>{ queueParam('ripple', 0); });
+
+// ----- Live preview -----
+// Decodes the /preview stream (see preview.h): varint (run<<2|op), op 0 skip,
+// 1 literal RGB run, 2 repeated RGB. Drawn 100 pixels per row.
+let pvPx=new Uint8Array(0);
+function pvOpen(){
+  const s=new WebSocket('ws://'+location.host+'/preview'); s.binaryType='arraybuffer';
+  s.onmessage=e=>pvFrame(new Uint8Array(e.data));
+  s.onclose=()=>setTimeout(pvOpen,2000);
+}
+function pvFrame(b){
+  const n=b[1]|(b[2]<<8);
+  if(pvPx.length!==n*3) pvPx=new Uint8Array(n*3);
+  if(b[0]&1) pvPx.fill(0);
+  let o=3, i=0;
+  while(o<b.length && i<n){
+    let v=0, sh=0, c;
+    do{ c=b[o++]; v+=(c&0x7f)*Math.pow(2,sh); sh+=7; }while(c&0x80);
+    const op=v%4, run=Math.floor(v/4);
+    if(op===0){ i+=run; }
+    else if(op===1){ pvPx.set(b.subarray(o,o+run*3), i*3); o+=run*3; i+=run; }
+    else { for(let k=0;k<run;k++,i++) pvPx.set(b.subarray(o,o+3), i*3); o+=3; }
+  }
+  pvDraw(n);
+}
+function pvDraw(n){
+  const cols=Math.min(n,100)||1, rows=Math.ceil(n/cols)||1, img=new ImageData(cols,rows);
+  for(let i=0;i<n;i++){ img.data[4*i]=pvPx[3*i]; img.data[4*i+1]=pvPx[3*i+1]; img.data[4*i+2]=pvPx[3*i+2]; img.data[4*i+3]=255; }
+  const cv=qs('pvCanvas'), g=cv.getContext('2d');
+  cv.width=cols; cv.height=rows; cv.style.height=Math.max(24,rows*8)+'px';
+  g.putImageData(img,0,0);
+}
+pvOpen();
+
+upd();
+
+// ----- Scheduler UI (drag & drop) -----
+const list=qs('schedList');
+function renderSchedule(items){
+  list.innerHTML='';
+  items.forEach((it,idx)=>{
+    const li=document.createElement('li');
+    li.className='sched-item';
+    li.draggable=true;
+    li.dataset.idx=idx;
+    const mm = Math.floor(it.seconds/60), ss = it.seconds%60;
+    li.innerHTML = '<div class=handle></div>'
+      + '<div class=mode-badge>'+ modeName(it.mode) +'</div>'
+      + '<div class=small>'+ (mm>0?(mm+'m '):'') + ss + 's</div>'
+      + '<button class="btn secondary" style="width:auto" onclick="removeItem('+idx+')">Remove</button>';
+    li.addEventListener('dragstart', ev=>{ ev.dataTransfer.setData('text/plain', idx); });
+    li.addEventListener('dragover', ev=>ev.preventDefault());
+    li.addEventListener('drop', ev=>{
+      ev.preventDefault();
+      const from=+ev.dataTransfer.getData('text/plain'); const to=idx;
+      if(from===to) return;
+      const a=schedule[from]; schedule.splice(from,1); schedule.splice(to,0,a);
+      renderSchedule(schedule);
+    });
+    list.appendChild(li);
+  });
+}
+function modeName(m){ return ['Fireflies','Sync','Wave','Twinkle','Swarm','Ripples'][m] || ('Mode '+m); }
+let schedule=[];
+
+qs('addItem').addEventListener('click', ()=>{
+  const m = +qs('schMode').value;
+  const min = Math.max(0, Math.min(180, +qs('schMin').value||0));
+  const sec = Math.max(0, Math.min(59,  +qs('schSec').value||0));
+  let total = (min*60)+sec;
+  if (total < 1) total = 1; // minimum 1s
+  schedule.push({mode:m, seconds: total});
+  renderSchedule(schedule);
+});
+window.removeItem=function(i){ schedule.splice(i,1); renderSchedule(schedule); };
+qs('clearItems').addEventListener('click', ()=>{ schedule=[]; renderSchedule(schedule); });
+
+qs('sendSched').addEventListener('click', ()=>{
+  fetch('/schedule', {method:'POST', headers:{'Content-Type':'application/json'}, body: JSON.stringify({items:schedule})});
+});
+
+// ----- Wi-Fi list management -----
+function refreshWifiList(){
+  fetch('/wifi_list').then(r=>r.json()).then(arr=>{
+    const ul=document.getElementById('wifiList'); ul.innerHTML='';
+    arr.forEach((item,i)=>{
+      const li=document.createElement('li');
+      li.className='sched-item';
+      li.innerHTML = '<div class="handle"></div>'
+        + '<div class="mode-badge">'+ item.ssid +'</div>'
+        + '<button class="btn secondary" style="width:auto" onclick="delNet('+i+')">Remove</button>';
+      ul.appendChild(li);
+    });
+  }).catch(()=>{});
+}
+function delNet(i){ fetch('/wifi_del?i='+i).then(()=>refreshWifiList()); }
+document.getElementById('addNet').addEventListener('click', ()=>{
+  const s=document.getElementById('nwSsid').value.trim();
+  const p=document.getElementById('nwPass').value;
+  if(!s){ document.getElementById('wifiMsg').textContent='Enter an SSID.'; return; }
+  fetch('/wifi_add', {method:'POST', body:new URLSearchParams({ssid:s, pass:p})})
+    .then(()=>{ document.getElementById('nwPass').value=''; refreshWifiList(); });
+});
+document.getElementById('tryNets').addEventListener('click', ()=>{
+  const msg=document.getElementById('wifiMsg'); msg.textContent='Trying saved networks…';
+  fetch('/wifi_try').then(r=>r.json()).then(j=>{
+    msg.textContent = j.connected ? 'Connected! Check the Serial Monitor for IP.' : 'No saved networks worked. AP may be active.';
+  }).catch(()=>{ msg.textContent='Error contacting device.'; });
+});
+refreshWifiList();
+</script>
+</div></body></html>
+)HTML";
+
+inline String oldWifiPage(const String& savedSsid, const String& savedPass){
+  String page = F("<!doctype html><html><head><meta name=viewport content='width=device-width,initial-scale=1'><title>Wi-Fi Setup</title><style>body{font-family:system-ui,-apple-system,Segoe UI,Roboto,Helvetica,Arial;padding:18px}input,button{font-size:16px;padding:10px;margin:6px 0;width:100%}label{display:block;margin-top:10px}</style></head><body>");
+  page += F("<h2>Fireflies Wi-Fi Setup</h2>");
+  page += F("<form method='POST' action='/wifi_save'>");
+  page += F("<label>SSID</label><input name='ssid' placeholder='Network name' value='");
+  page += savedSsid; page += F("'>");
+  page += F("<label>Password</label><input name='pass' type='password' placeholder='Password' value='");
+  page += savedPass; page += F("'>");
+  page += F("<button type='submit'>Save &amp; Reboot</button></form>");
+  page += F("<p style='opacity:.7'>Device will reboot and try to join the network you entered.</p>");
+  page += F("</body></html>");
+  return page;
+}
@@ -0,0 +1,60 @@
+#pragma once
+// Minimal Arduino surface for the [env:native] host build. Only what the
+// effect code and the bench's old handlers touch; nothing here is meant to
+// run on the device.
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+uint32_t millis();
+uint32_t micros();
+uint32_t esp_random();
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max){
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// WString as the ESP32 core has it, for bench code that measures String
+// handlers: every append reallocs to the exact new length, substring() and
+// construction from char* copy. F() strings are plain ones on the host.
+#include <stdlib.h>
+#define F(s) (s)
+class String {
+public:
+  String(const char* s = ""){ copy(s, strlen(s)); }
+  String(const String& s){ copy(s.mBuf, s.mLen); }
+  String(String&& s) : mBuf(s.mBuf), mLen(s.mLen), mCap(s.mCap){ s.mBuf = nullptr; s.mLen = s.mCap = 0; }
+  ~String(){ free(mBuf); }
+  String& operator=(const String& s){ if (this != &s) copy(s.mBuf, s.mLen); return *this; }
+  String& operator=(String&& s){ if (this != &s){ free(mBuf); mBuf = s.mBuf; mLen = s.mLen; mCap = s.mCap; s.mBuf = nullptr; s.mLen = s.mCap = 0; } return *this; }
+  String& operator+=(const char* s){ concat(s, strlen(s)); return *this; }
+  String& operator+=(const String& s){ concat(s.mBuf, s.mLen); return *this; }
+  bool reserve(size_t n){
+    if (mBuf && mCap >= n) return true;
+    char* b = (char*)realloc(mBuf, n + 1);
+    if (!b) return false;
+    if (!mBuf) b[0] = 0;
+    mBuf = b; mCap = n;
+    return true;
+  }
+  String substring(size_t from, size_t to) const {
+    if (to > mLen) to = mLen;
+    if (from >= to) return String();
+    String out; out.copy(mBuf + from, to - from);
+    return out;
+  }
+  String substring(size_t from) const { return substring(from, mLen); }
+  const char* c_str() const { return mBuf ? mBuf : ""; }
+  size_t length() const { return mLen; }
+
+private:
+  void copy(const char* s, size_t n){ if (!reserve(n)) return; memcpy(mBuf, s, n); mBuf[n] = 0; mLen = n; }
+  void concat(const char* s, size_t n){ if (!n || !reserve(mLen + n)) return; memcpy(mBuf + mLen, s, n); mLen += n; mBuf[mLen] = 0; }
+  char* mBuf = nullptr;
+  size_t mLen = 0, mCap = 0;
+};
@@ -0,0 +1,80 @@
+#pragma once
+// Host stand-in for the parts of FastLED the effects use. Math follows the
+// library's portable C paths (FASTLED_SCALE8_FIXED, hsv2rgb_rainbow, inoise8)
+// so per-pixel cost and output are representative of the ESP32 build.
+#include "Arduino.h"
+
+typedef uint8_t fract8;
+
+inline uint8_t scale8(uint8_t i, fract8 scale){ return (uint8_t)(((uint16_t)i * (1 + (uint16_t)scale)) >> 8); }
+inline uint8_t scale8_video(uint8_t i, fract8 scale){ return (uint8_t)((((int)i * (int)scale) >> 8) + ((i && scale) ? 1 : 0)); }
+inline uint8_t qadd8(uint8_t i, uint8_t j){ unsigned t = i + j; return t > 255 ? 255 : (uint8_t)t; }
+inline uint8_t qsub8(uint8_t i, uint8_t j){ int t = i - j; return t < 0 ? 0 : (uint8_t)t; }
+uint8_t sin8(uint8_t theta);
+inline uint8_t cos8(uint8_t theta){ return sin8(theta + 64); }
+
+// ---- random (FastLED's 16-bit LCG) ----
+extern uint16_t rand16seed;
+inline uint8_t random8(){ rand16seed = (rand16seed * 2053) + 13849; return (uint8_t)(((uint8_t)(rand16seed & 0xFF)) + ((uint8_t)(rand16seed >> 8))); }
+inline uint8_t random8(uint8_t lim){ return (uint8_t)((random8() * lim) >> 8); }
+inline uint8_t random8(uint8_t min, uint8_t lim){ return random8(lim - min) + min; }
+inline uint16_t random16(){ rand16seed = (rand16seed * 2053) + 13849; return rand16seed; }
+inline uint16_t random16(uint16_t lim){ return (uint16_t)(((uint32_t)random16() * lim) >> 16); }
+inline void random16_set_seed(uint16_t seed){ rand16seed = seed; }
+
+// ---- beats (millis based, like the library) ----
+inline uint16_t beat88(uint16_t bpm88, uint32_t timebase = 0){ return (uint16_t)(((millis() - timebase) * bpm88 * 280) >> 16); }
+inline uint16_t beat16(uint16_t bpm, uint32_t timebase = 0){ if (bpm < 256) bpm <<= 8; return beat88(bpm, timebase); }
+inline uint8_t beat8(uint16_t bpm, uint32_t timebase = 0){ return beat16(bpm, timebase) >> 8; }
+inline uint8_t beatsin8(uint16_t bpm, uint8_t lowest = 0, uint8_t highest = 255, uint32_t timebase = 0, uint8_t phase_offset = 0){
+  uint8_t beat = beat8(bpm, timebase);
+  uint8_t beatsin = sin8(beat + phase_offset);
+  return lowest + scale8(beatsin, highest - lowest);
+}
+
+// ---- noise ----
+uint8_t inoise8(uint16_t x, uint16_t y);
+uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z);
+
+// ---- colors ----
+struct CHSV {
+  uint8_t hue, sat, val;
+  CHSV() : hue(0), sat(0), val(0) {}
+  CHSV(uint8_t h, uint8_t s, uint8_t v) : hue(h), sat(s), val(v) {}
+};
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb);
+
+struct CRGB {
+  union { struct { uint8_t r, g, b; }; uint8_t raw[3]; };
+  enum HTMLColorCode { Black = 0x000000, White = 0xFFFFFF };
+
+  CRGB() : r(0), g(0), b(0) {}
+  CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+  CRGB(HTMLColorCode c) : r((c >> 16) & 0xFF), g((c >> 8) & 0xFF), b(c & 0xFF) {}
+  CRGB(const CHSV& hsv){ hsv2rgb_rainbow(hsv, *this); }
+
+  uint8_t& operator[](uint8_t x){ return raw[x]; }
+  const uint8_t& operator[](uint8_t x) const { return raw[x]; }
+
+  CRGB& operator=(const CHSV& hsv){ hsv2rgb_rainbow(hsv, *this); return *this; }
+  CRGB& operator+=(const CRGB& c){ r = qadd8(r, c.r); g = qadd8(g, c.g); b = qadd8(b, c.b); return *this; }
+  CRGB& nscale8(uint8_t s){ uint16_t f = 1 + s; r = (r * f) >> 8; g = (g * f) >> 8; b = (b * f) >> 8; return *this; }
+  CRGB& nscale8_video(uint8_t s){
+    uint8_t nz = s != 0;
+    r = r == 0 ? 0 : ((r * s) >> 8) + nz;
+    g = g == 0 ? 0 : ((g * s) >> 8) + nz;
+    b = b == 0 ? 0 : ((b * s) >> 8) + nz;
+    return *this;
+  }
+  CRGB& fadeToBlackBy(uint8_t f){ return nscale8(255 - f); }
+  bool operator==(const CRGB& o) const { return r == o.r && g == o.g && b == o.b; }
+  bool operator!=(const CRGB& o) const { return !(*this == o); }
+};
+
+inline CRGB operator+(CRGB a, const CRGB& b){ return a += b; }
+
+inline void fill_solid(CRGB* leds, int n, const CRGB& c){ for (int i = 0; i < n; i++) leds[i] = c; }
+inline void nscale8(CRGB* leds, uint16_t n, uint8_t s){ for (uint16_t i = 0; i < n; i++) leds[i].nscale8(s); }
+inline void fadeToBlackBy(CRGB* leds, uint16_t n, uint8_t f){ nscale8(leds, n, 255 - f); }
@@ -0,0 +1,140 @@
+// Host implementations behind bench/shim/FastLED.h and Arduino.h.
+#include <chrono>
+#include "FastLED.h"
+
+static const auto kBoot = std::chrono::steady_clock::now();
+uint32_t millis(){ return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - kBoot).count(); }
+uint32_t micros(){ return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - kBoot).count(); }
+
+static uint32_t rngState = 0x9E3779B9u;
+uint32_t esp_random(){ rngState ^= rngState << 13; rngState ^= rngState >> 17; rngState ^= rngState << 5; return rngState; }
+
+uint16_t rand16seed = 1337;
+
+// ---- sin8 (lib8tion sin8_C) ----
+static const uint8_t b_m16_interleave[] = { 0, 49, 49, 41, 90, 27, 117, 10 };
+uint8_t sin8(uint8_t theta){
+  uint8_t offset = theta;
+  if (theta & 0x40) offset = (uint8_t)255 - offset;
+  offset &= 0x3F;
+  uint8_t secoffset = offset & 0x0F;
+  if (theta & 0x40) ++secoffset;
+  uint8_t section = offset >> 4;
+  const uint8_t* p = b_m16_interleave + section * 2;
+  uint8_t b = p[0], m16 = p[1];
+  uint8_t mx = (m16 * secoffset) >> 4;
+  int8_t y = mx + b;
+  if (theta & 0x80) y = -y;
+  y += 128;
+  return y;
+}
+
+// ---- hsv2rgb_rainbow ----
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb){
+  uint8_t hue = hsv.hue, sat = hsv.sat, val = hsv.val;
+  uint8_t offset8 = (hue & 0x1F) << 3;
+  uint8_t third = scale8(offset8, (256 / 3));
+  uint8_t r, g, b;
+  if (!(hue & 0x80)){
+    if (!(hue & 0x40)){
+      if (!(hue & 0x20)){ r = 255 - third; g = third; b = 0; }
+      else              { r = 171; g = 85 + third; b = 0; }
+    } else {
+      if (!(hue & 0x20)){ uint8_t twothirds = scale8(offset8, ((256 * 2) / 3)); r = 171 - twothirds; g = 170 + third; b = 0; }
+      else              { r = 0; g = 255 - third; b = third; }
+    }
+  } else {
+    if (!(hue & 0x40)){
+      if (!(hue & 0x20)){ uint8_t twothirds = scale8(offset8, ((256 * 2) / 3)); r = 0; g = 171 - twothirds; b = 85 + twothirds; }
+      else              { r = third; g = 0; b = 255 - third; }
+    } else {
+      if (!(hue & 0x20)){ r = 85 + third; g = 0; b = 171 - third; }
+      else              { r = 170 + third; g = 0; b = 85 - third; }
+    }
+  }
+  if (sat != 255){
+    if (sat == 0){ r = 255; g = 255; b = 255; }
+    else {
+      uint8_t desat = 255 - sat;
+      desat = scale8_video(desat, desat);
+      uint8_t satscale = 255 - desat;
+      r = scale8(r, satscale) + desat; g = scale8(g, satscale) + desat; b = scale8(b, satscale) + desat;
+    }
+  }
+  if (val != 255){
+    val = scale8_video(val, val);
+    if (val == 0){ r = 0; g = 0; b = 0; }
+    else { r = scale8(r, val); g = scale8(g, val); b = scale8(b, val); }
+  }
+  rgb.r = r; rgb.g = g; rgb.b = b;
+}
+
+// ---- inoise8 (Ken Perlin's permutation, 8-bit fixed point path) ----
+static const uint8_t p[] = {
+  151,160,137,91,90,15,131,13,201,95,96,53,194,233,7,225,140,36,103,30,69,142,8,99,37,240,21,10,23,
+  190,6,148,247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,57,177,33,88,237,149,56,87,174,
+  20,125,136,171,168,68,175,74,165,71,134,139,48,27,166,77,146,158,231,83,111,229,122,60,211,133,
+  230,220,105,92,41,55,46,245,40,244,102,143,54,65,25,63,161,1,216,80,73,209,76,132,187,208,89,18,
+  169,200,196,135,130,116,188,159,86,164,100,109,198,173,186,3,64,52,217,226,250,124,123,5,202,38,
+  147,118,126,255,82,85,212,207,206,59,227,47,16,58,17,182,189,28,42,223,183,170,213,119,248,152,2,
+  44,154,163,70,221,153,101,155,167,43,172,9,129,22,39,253,19,98,108,110,79,113,224,232,178,185,
+  112,104,218,246,97,228,251,34,242,193,238,210,144,12,191,179,162,241,81,51,145,235,249,14,239,
+  107,49,192,214,31,181,199,106,157,184,84,204,176,115,121,50,45,127,4,150,254,138,236,205,93,222,
+  114,67,29,24,72,243,141,128,195,78,66,215,61,156,180,151 };
+static_assert(sizeof(p) == 257, "permutation table must wrap once");
+#define P(x) p[(uint8_t)(x)]
+
+static inline int8_t avg7(int8_t i, int8_t j){ return (i >> 1) + (j >> 1) + (i & 0x1); }
+static inline uint8_t ease8InOutQuad(uint8_t i){
+  uint8_t j = i; if (j & 0x80) j = 255 - j;
+  uint8_t jj2 = scale8(j, j) << 1;
+  if (i & 0x80) jj2 = 255 - jj2;
+  return jj2;
+}
+static inline int8_t lerp7by8(int8_t a, int8_t b, fract8 frac){
+  if (b > a){ uint8_t delta = b - a; return a + scale8(delta, frac); }
+  uint8_t delta = a - b; return a - scale8(delta, frac);
+}
+static inline int8_t grad8(uint8_t hash, int8_t x, int8_t y){
+  int8_t u, v;
+  if (hash & 4){ u = y; v = x; } else { u = x; v = y; }
+  if (hash & 1) u = -u;
+  if (hash & 2) v = -v;
+  return avg7(u, v);
+}
+static inline int8_t grad8(uint8_t hash, int8_t x, int8_t y, int8_t z){
+  hash &= 0xF;
+  int8_t u = (hash & 8) ? y : x;
+  int8_t v = hash < 4 ? y : (hash == 12 || hash == 14 ? x : z);
+  if (hash & 1) u = -u;
+  if (hash & 2) v = -v;
+  return avg7(u, v);
+}
+
+static int8_t inoise8_raw(uint16_t x, uint16_t y){
+  uint8_t X = x >> 8, Y = y >> 8;
+  uint8_t A = P(X) + Y, AA = P(A), AB = P(A + 1);
+  uint8_t B = P(X + 1) + Y, BA = P(B), BB = P(B + 1);
+  uint8_t u = ease8InOutQuad((uint8_t)x), v = ease8InOutQuad((uint8_t)y);
+  int8_t xx = ((uint8_t)x >> 1) & 0x7F, yy = ((uint8_t)y >> 1) & 0x7F;
+  const uint8_t N = 0x80;
+  int8_t X1 = lerp7by8(grad8(P(AA), xx, yy), grad8(P(BA), xx - N, yy), u);
+  int8_t X2 = lerp7by8(grad8(P(AB), xx, yy - N), grad8(P(BB), xx - N, yy - N), u);
+  return lerp7by8(X1, X2, v);
+}
+static int8_t inoise8_raw(uint16_t x, uint16_t y, uint16_t z){
+  uint8_t X = x >> 8, Y = y >> 8, Z = z >> 8;
+  uint8_t A = P(X) + Y, AA = P(A) + Z, AB = P(A + 1) + Z;
+  uint8_t B = P(X + 1) + Y, BA = P(B) + Z, BB = P(B + 1) + Z;
+  uint8_t u = ease8InOutQuad((uint8_t)x), v = ease8InOutQuad((uint8_t)y), w = ease8InOutQuad((uint8_t)z);
+  int8_t xx = ((uint8_t)x >> 1) & 0x7F, yy = ((uint8_t)y >> 1) & 0x7F, zz = ((uint8_t)z >> 1) & 0x7F;
+  const uint8_t N = 0x80;
+  int8_t X1 = lerp7by8(grad8(P(AA), xx, yy, zz), grad8(P(BA), xx - N, yy, zz), u);
+  int8_t X2 = lerp7by8(grad8(P(AB), xx, yy - N, zz), grad8(P(BB), xx - N, yy - N, zz), u);
+  int8_t X3 = lerp7by8(grad8(P(AA + 1), xx, yy, zz - N), grad8(P(BA + 1), xx - N, yy, zz - N), u);
+  int8_t X4 = lerp7by8(grad8(P(AB + 1), xx, yy - N, zz - N), grad8(P(BB + 1), xx - N, yy - N, zz - N), u);
+  int8_t Y1 = lerp7by8(X1, X2, v), Y2 = lerp7by8(X3, X4, v);
+  return lerp7by8(Y1, Y2, w);
+}
+uint8_t inoise8(uint16_t x, uint16_t y){ int8_t n = inoise8_raw(x, y) + 64; return qadd8(n, n); }
+uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z){ int8_t n = inoise8_raw(x, y, z) + 64; return qadd8(n, n); }
@@ -0,0 +1,38 @@
+#pragma once
+#include <FastLED.h>
+#include "config.h"
+#include "litset.h"
+
+// ---- 16-bit accumulation ----
+// Channels in 8.8 fixed point, three per pixel (RGB), for effects whose fades
+// run for many frames: an 8-bit channel scaled by 240/256 sticks or snaps in
+// the last few steps, this one keeps going for eight more bits. The buffer is
+// quantized to the 8-bit pixels once per frame with temporal dithering, so a
+// level between two 8-bit steps shows as the right mix of both over four
+// frames. The pixels' lit set doubles as the accumulator's: an unlit pixel
+// has every channel 0.
+#define ACC_SNAP 0x80   // a pixel with every channel below half a step goes black
+
+// acc = acc * scale / 256 (floor), over the 32-pixel runs with a lit pixel.
+// Two channels per 32-bit word; acc must be word aligned.
+void accFade(uint16_t* acc, const LitSet& lit, uint16_t n, uint8_t scale);
+
+// Adds color c at level s (0..65535) into pixel i, saturating.
+inline void accAdd(uint16_t* acc, LitSet& lit, uint16_t i, const CRGB& c, uint16_t s){
+  uint16_t* p = acc + i * 3;
+  for (uint8_t k = 0; k < 3; k++){
+    uint32_t v = p[k] + ((c.raw[k] * (uint32_t)s) >> 8);
+    p[k] = v > 0xFFFF ? 0xFFFF : (uint16_t)v;
+  }
+  lit.mark(i);
+}
+
+// The lit pixels to px at frame f: (acc + dither) >> 8, where the dither
+// steps a quarter of a level per frame from a per-pixel start. Pixels that
+// fall under ACC_SNAP are cleared in acc and dropped from lit. Rebuilds
+// gPower's sums from what it writes, like the lit-set fades.
+void accOut(uint16_t* acc, CRGB* px, LitSet& lit, uint32_t f);
+
+// Starts acc from what px holds (c * 257 per channel) over the lit pixels,
+// 0 elsewhere.
+void accLoad(uint16_t* acc, const CRGB* px, const LitSet& lit, uint16_t n);
@@ -0,0 +1,89 @@
+#pragma once
+#include <FastLED.h>
+#include "config.h"
+#include "effects.h"
+#include "litset.h"
+
+// ---- Blend kernels ----
+// Add and alpha work on 32-bit words, four channel bytes at a time (SWAR),
+// with a byte loop for the last n*3 % 4; max stays a byte loop, which the
+// word version did not beat. Buffers must be word aligned: leds[], the
+// pipeline's and the compositor's own are. dst may be the same buffer as a
+// source.
+enum BlendMode : uint8_t { BLEND_ADD, BLEND_ALPHA, BLEND_MAX };
+
+void blendAdd(CRGB* dst, const CRGB* src, uint16_t n);                      // qadd8 per channel
+void blendAddLit(CRGB* dst, const CRGB* src, const LitSet& lit, uint16_t n); // same, only 32-pixel runs with a lit pixel in src
+void blendMax(CRGB* dst, const CRGB* src, uint16_t n);                      // brighter of the two, per channel
+void blendMaxLit(CRGB* dst, const CRGB* src, const LitSet& lit, uint16_t n); // same, only 32-pixel runs with a lit pixel in src
+void blendAlpha(CRGB* dst, const CRGB* a, const CRGB* b, uint16_t n, uint16_t w);  // (a*(256-w) + b*w) >> 8, w 0..256
+
+// ---- Compositor ----
+// Layers, bottom up: the base (leds[] and gLit, the mode that is showing),
+// the mode a crossfade is bringing in, and the ripple overlay. Each draws into
+// its own buffer and is blended over what is below it by its BlendMode:
+//   out = alpha(base, incoming, fade position) + rings
+// The incoming mode is always alpha, weighted by the fade position; the
+// overlay is add unless overlay() says otherwise. Add and max leave pixels
+// where the layer is black alone, so they only visit its lit runs.
+// With only the base drawing the blend is a copy and the incremental power
+// sums stand; otherwise they are rescanned from out.
+//
+// A crossfade is armed by crossfade(ms) and taken by the next mode change, in
+// the same frame; changes that are not armed (UI, API) cut as before. A change
+// during a fade lands the fade in progress first.
+//
+// Each layer's render cost is smoothed from micros(). The budget is the
+// frame period (see pacer.h). When the frame would go over it the layers that
+// are not the mode being shown are drawn less often, the outgoing one first,
+// then the rings, down to every COMP_MAX_DIV frames; a skipped layer keeps its
+// last frame and is handed the time it missed when it next draws. The shown
+// mode is never throttled.
+#define COMP_MAX_DIV    4
+
+struct Layer {
+  alignas(4) CRGB px[NUM_LEDS];
+  LitSet lit;
+  BlendMode mode = BLEND_ADD;
+  uint16_t w = 256;   // BLEND_ALPHA weight, 0..256
+};
+
+class Compositor {
+public:
+  enum { L_BASE, L_FADE, L_RINGS, L_MIX, L_COUNT };   // L_MIX: the blend itself, never skipped
+
+  Compositor(){ mIn.mode = BLEND_ALPHA; }
+
+  void reset();                                   // cut to gMode, layers black, every layer every frame
+  void setBudget(uint32_t us){ mBudget = us; }    // 0: no throttling
+  void crossfade(uint16_t ms){ mArm = ms; }       // the next mode change fades over ms (0 cuts)
+  void overlay(BlendMode m, uint16_t w = 256){ mRings.mode = m; mRings.w = w; }   // how the rings go on top
+  const Layer& rings() const { return mRings; }
+  void frame(CRGB* out, float dt);                // gMode at gFrameMs into out[0..gNumLeds)
+
+  bool fading() const { return mFadeMs; }
+  uint8_t divisor(uint8_t l) const { return mDiv[l]; }
+  uint32_t costUs(uint8_t l) const { return mCost[l] >> 4; }
+  uint32_t estimateUs() const;                    // a frame at the current divisors
+  uint32_t skipped = 0;                           // layer draws skipped to stay in budget
+
+private:
+  bool draw(uint8_t l, uint8_t m, Pixels px, const Params& p, FrameTime t);
+  void endFade();
+  static void blend(CRGB* out, const CRGB* under, const Layer& l, uint16_t n);
+  void pace();
+  void measure(uint8_t l, uint32_t us){ mCost[l] += ((int32_t)(us << 4) - (int32_t)mCost[l]) / 8; }
+
+  Layer mIn, mRings;
+  RippleMode mRingFx;           // fade and rings, as the standalone mode draws them
+  uint8_t mOut = 0, mNext = 0;  // mode in the base; mode coming in while fading
+  uint16_t mArm = 0, mFadeMs = 0;
+  uint32_t mFadeStart = 0;
+  bool mRingsOn = false;        // overlay wanted by the shown mode and not yet black
+  uint32_t mBudget = 0, mFrame = 0;
+  uint32_t mCost[L_COUNT] = {}; // us x16, smoothed
+  uint8_t mDiv[L_COUNT] = { 1, 1, 1, 1 };
+  float mDt[L_COUNT] = {};
+};
+
+extern Compositor gComp;
@@ -0,0 +1,22 @@
+#pragma once
+
+// --------- USER CONFIG ----------
+// Overridable from build_flags so the native bench can size the strip itself.
+#ifndef LED_PIN
+#define LED_PIN       5     // default single-segment layout
+#endif
+#ifndef NUM_LEDS
+#define NUM_LEDS      500   // buffer capacity; raise for multi-pin layouts (see segments.h), up to ~3000
+#endif
+// Static RAM for everything sized by NUM_LEDS, about 43 bytes a pixel: frame
+// and layer buffers, effect state, the pixel map and the preview. An ESP32
+// links at most ~180 KB of static DRAM and the core, Wi-Fi, lwIP and the web
+// server take ~50 KB of that. main.cpp checks the sum against this budget at
+// compile time, which caps NUM_LEDS at about 3000.
+#ifndef DRAM_BUDGET
+#define DRAM_BUDGET   (128 * 1024)
+#endif
+#define LED_TYPE      WS2811
+#define COLOR_ORDER   GRB
+#define MAX_MA        2000
+// --------------------------------
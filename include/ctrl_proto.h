@@ -0,0 +1,22 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "params.h"
+
+// Binary control frames on the /ws WebSocket: a run of (field, value) byte
+// pairs. Pairs apply in order, so the last value for a field in a frame wins;
+// the UI coalesces to at most one frame per animation frame.
+enum CtrlField : uint8_t {
+  CF_MODE = 0, CF_BRIGHT, CF_DENSITY, CF_SPEED, CF_HUE, CF_SAT, CF_LIFE, CF_FADE, CF_DRIFT,
+  CF_RIPPLE,   // value ignored; triggers a ripple
+  CF_PREVIEW,  // preview stream fps, 0 = off
+  CF_FPS,      // render target fps, 0 = PACE_FPS
+  CF_COUNT
+};
+
+struct CtrlResult { uint8_t params; uint8_t ripples; bool ok; };
+
+// Applies every pair to p; stops at an unknown field, a mode past the last
+// one or a dangling byte (ok=false), with the pairs before it already applied, so decode into a
+// copy and keep it only when ok.
+CtrlResult ctrlDecode(const uint8_t* buf, size_t len, Params& p);
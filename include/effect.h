@@ -0,0 +1,88 @@
+#pragma once
+#include <FastLED.h>
+#include "config.h"
+#include "params.h"
+
+// ---- Effect framework ----
+// A mode is a type that owns its state and draws a frame in render():
+//
+//   class Glow : public Effect<Glow> {
+//   public:
+//     static const char* name(){ return "glow"; }    // /metrics key
+//     static const char* label(){ return "Glow"; }   // UI
+//     void render(Pixels px, const Params& p, const FrameTime& t);
+//   };
+//
+// EffectSet<...> lists the modes in mode-number order (Modes in effects.h).
+// It dispatches on the mode with every call bound at compile time, so each
+// render() inlines into its branch of the dispatch like a switch case would,
+// and it is where the UI, /metrics and the schedule get the mode count and
+// names. A new mode is a new type and one entry in that list.
+//
+// render() reads settings from p and time from t, not from the globals, so
+// the compiler can keep them in registers across pixel stores.
+
+struct FrameTime { uint32_t ms; float t, dt; };   // frame clock; seconds since start; seconds since last frame
+
+// The buffer being drawn, px[0..n), and its lit set: leds[] and gLit, or a
+// compositor layer. kMax is the buffer capacity, fixed at compile time so
+// per-pixel effect state is sized from it. Effects draw RGB; the color order
+// (COLOR_ORDER) is applied by the controllers at show time.
+struct LitSet;
+struct Pixels {
+  static const uint16_t kMax = NUM_LEDS;
+  CRGB* px;
+  uint16_t n;
+  LitSet* lit;
+  CRGB& operator[](uint16_t i) const { return px[i]; }
+};
+
+extern uint8_t gHueBase;
+
+// Defaults a mode can hide by redeclaring them.
+template <class E> class Effect {
+public:
+  static const bool kRipples = true;    // ripple overlay drawn on top
+  static const bool kHueDrift = false;  // nudges the hue each second while drift is on
+  void reset(){}
+  void enter(Pixels){}                  // about to draw into px, which holds another mode's frame
+  static const char* label(){ return E::name(); }
+
+  void frame(Pixels px, const Params& p, const FrameTime& t){
+    E& e = static_cast<E&>(*this);
+    e.render(px, p, t);
+    if (E::kHueDrift && p.drift && (t.ms & 1023) < 16) gHueBase++;
+  }
+};
+
+template <class... Es> class EffectSet;
+
+template <> class EffectSet<> {
+public:
+  static const uint8_t kCount = 0;
+  bool frame(uint8_t, Pixels, const Params&, const FrameTime&){ return true; }
+  void reset(){}
+  void enter(uint8_t, Pixels){}
+  static const char* name(uint8_t){ return nullptr; }
+  static const char* label(uint8_t){ return nullptr; }
+  static bool ripples(uint8_t){ return true; }
+};
+
+template <class E, class... Rest> class EffectSet<E, Rest...> {
+public:
+  static const uint8_t kCount = 1 + sizeof...(Rest);
+  // Draws mode m (none if out of range); true if the ripple overlay follows.
+  bool frame(uint8_t m, Pixels px, const Params& p, const FrameTime& t){
+    if (m == 0){ mHead.frame(px, p, t); return E::kRipples; }
+    return mRest.frame(m - 1, px, p, t);
+  }
+  void reset(){ mHead.reset(); mRest.reset(); }
+  void enter(uint8_t m, Pixels px){ if (m == 0) mHead.enter(px); else mRest.enter(m - 1, px); }
+  static const char* name(uint8_t m){ return m ? EffectSet<Rest...>::name(m - 1) : E::name(); }
+  static const char* label(uint8_t m){ return m ? EffectSet<Rest...>::label(m - 1) : E::label(); }
+  static bool ripples(uint8_t m){ return m ? EffectSet<Rest...>::ripples(m - 1) : E::kRipples; }
+
+private:
+  E mHead;
+  EffectSet<Rest...> mRest;
+};
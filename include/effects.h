@@ -0,0 +1,123 @@
+#pragma once
+#include <FastLED.h>
+#include "config.h"
+#include "effect.h"
+#include "fly_envelope.h"
+#include "noise_row.h"
+
+// Pixel buffer shared by every mode. gNumLeds <= NUM_LEDS is the active length.
+extern CRGB leds[NUM_LEDS];
+extern uint16_t gNumLeds;
+
+// Frame clock in ms. Effects get time only from the FrameTime built from it,
+// and draw randomness only from the seeded streams in rng.h, so a run
+// replays exactly from its seed, parameters and clock.
+extern uint32_t gFrameMs;
+
+// runtime params; the compositor hands them to the mode as one Params
+extern uint8_t gBrightness;
+extern uint8_t gMode;      // index into Modes below
+extern uint8_t gDensity;   // meaning varies by mode
+extern uint8_t gSpeed;
+extern uint8_t gHueBase;
+extern uint8_t gSaturation;
+extern bool    gAutoHueDrift;
+extern uint8_t gLifespan;  // 1–100; lower = shorter life (faster on/off)
+extern uint8_t gFade;      // 200–250; lower = faster fade-to-black
+
+// ---------- FIREFLIES -----------
+// Pool in struct-of-arrays form. The per-frame loop walks the dense active
+// list and touches only the hot envelope; position/hue are read once per fly.
+// Free slots form an intrusive singly linked list, so spawn and retire are O(1).
+// Flies and their fading trails build up in a 16-bit accumulator (accum.h)
+// that is dithered down to the pixels each frame. The pool holds the most
+// render() ever spawns, one fly per 4 pixels of buffer.
+#ifndef MAX_FIREFLIES
+#define MAX_FIREFLIES (NUM_LEDS / 4)
+#endif
+class Fireflies : public Effect<Fireflies> {
+public:
+  static const bool kHueDrift = true;
+  static const char* name(){ return "fireflies"; }
+  void reset();
+  void enter(Pixels px);
+  void render(Pixels px, const Params& p, const FrameTime& t);
+  uint16_t active() const { return mCount; }
+
+private:
+  static const uint16_t kNone = 0xFFFF;
+  void spawn(uint16_t n, const Params& p);
+  FlyEnv   mEnv[MAX_FIREFLIES];      // hot
+  uint16_t mIdx[MAX_FIREFLIES];      // cold
+  uint8_t  mHue[MAX_FIREFLIES];
+  uint16_t mNext[MAX_FIREFLIES];     // free list links
+  uint16_t mFree = kNone;
+  uint16_t mActive[MAX_FIREFLIES];   // dense list of live slots
+  uint16_t mCount = 0;
+  alignas(4) uint16_t mAcc[Pixels::kMax * 3];
+  uint32_t mTick = 0;                // dither phase
+};
+
+// ---------- SYNC / WAVE / TWINKLE / SWARM ----------
+class Sync : public Effect<Sync> {
+public:
+  static const char* name(){ return "sync"; }
+  static const char* label(){ return "Sync Pulse"; }
+  void render(Pixels px, const Params& p, const FrameTime& t);
+};
+class Wave : public Effect<Wave> {
+public:
+  static const char* name(){ return "wave"; }
+  void render(Pixels px, const Params& p, const FrameTime& t);
+};
+class Twinkle : public Effect<Twinkle> {
+public:
+  static const char* name(){ return "twinkle"; }
+  void render(Pixels px, const Params& p, const FrameTime& t);
+};
+class Swarm : public Effect<Swarm> {
+public:
+  static const char* name(){ return "swarm"; }
+  void reset(){ mNoise.valid = false; }
+  void render(Pixels px, const Params& p, const FrameTime& t);
+
+private:
+  NoiseCache mNoise;
+  uint8_t mN[Pixels::kMax];
+};
+
+// ---------- RIPPLES --------------
+// One set of rings shared by the standalone mode and the overlay layer the
+// compositor puts on top of every other mode. They age once per frame, in
+// advance(), however many layers draw them.
+#define MAX_RIPPLES 32
+struct Ripple { int center; float age; float speed; bool on; };
+class Ripples {
+public:
+  void clear(){ for (auto& r : ring) r.on = false; }
+  void trigger(int center, uint16_t n, uint8_t speed);  // center < 0 or past n: random pixel
+  void advance(const Params& p, float dt, uint16_t n);   // age, and retire rings past the strip (or the map)
+  void draw(Pixels px, const Params& p) const;           // rings only, no fade
+  bool any() const { for (const auto& r : ring) if (r.on) return true; return false; }
+  Ripple ring[MAX_RIPPLES];
+};
+extern Ripples gRipples;
+void triggerRipple(int center = -1);   // at the current strip length and speed
+
+class RippleMode : public Effect<RippleMode> {
+public:
+  static const bool kRipples = false;   // draws the rings itself
+  static const char* name(){ return "ripples"; }
+  static const char* label(){ return "Ripples (standalone)"; }
+  void render(Pixels px, const Params& p, const FrameTime& t);
+};
+
+// ---------- FRAME ----------------
+// Mode numbers are positions in this list.
+typedef EffectSet<Fireflies, Sync, Wave, Twinkle, Swarm, RippleMode> Modes;
+#define MODE_COUNT Modes::kCount
+extern Modes gModes;
+inline const char* modeName(uint8_t m){ return Modes::name(m); }     // nullptr past the last mode
+inline const char* modeLabel(uint8_t m){ return Modes::label(m); }
+
+void effectsReset(uint32_t seed);     // black strip, no flies or ripples, streams reseeded, compositor cut to gMode
@@ -0,0 +1,36 @@
+#pragma once
+#include <stdint.h>
+
+// Q16 fixed-point firefly envelope: rise -> hold -> fall, in "life seconds"
+// scaled by 65536. Stage boundaries and reciprocals are computed once at spawn
+// so the per-frame update is an add, a compare and one multiply.
+#define FLY_Q16(s) ((uint32_t)((s) * 65536.0))
+
+struct FlyEnv {
+  uint32_t phase;    // Q16 elapsed
+  uint32_t riseEnd;  // Q16 boundaries
+  uint32_t holdEnd;
+  uint32_t end;
+  uint16_t riseInv;  // (255<<16)/rise, maps the rise stage onto 0..255
+  uint16_t fallInv;  // (255<<16)/fall
+};
+
+extern const uint16_t kFlyLevel16[256];  // (i/255)^4 brightness, as palDim applies it, at 16 bits
+
+inline void flyEnvInit(FlyEnv& e, uint32_t rise, uint32_t hold, uint32_t fall){
+  e.phase = 0;
+  e.riseEnd = rise; e.holdEnd = rise + hold; e.end = rise + hold + fall;
+  e.riseInv = (uint16_t)((255UL << 16) / rise);
+  e.fallInv = (uint16_t)((255UL << 16) / fall);
+}
+
+// Advance by step (Q16) and return the envelope position 0..255 (up, held,
+// down); false once the fly is done.
+inline bool flyEnvStage(FlyEnv& e, uint32_t step, uint8_t& a){
+  uint32_t x = e.phase += step;
+  if (x >= e.end) return false;
+  if (x < e.riseEnd)      a = (uint8_t)((x * e.riseInv) >> 16);
+  else if (x < e.holdEnd) a = 255;
+  else                    a = (uint8_t)(255 - (((x - e.holdEnd) * e.fallInv) >> 16));
+  return true;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <FastLED.h>
+#include <string.h>
+#include "config.h"
+
+// Bitset of pixels that may be non-black. Writers mark what they light; the
+// fade kernels below walk only set bits and drop pixels once they reach black,
+// so fade cost follows activity instead of strip length.
+struct LitSet {
+  static const uint16_t kWords = (NUM_LEDS + 31) / 32;
+  uint32_t w[kWords];
+
+  void clear(){ memset(w, 0, sizeof(w)); }
+  void mark(uint16_t i){ w[i >> 5] |= 1UL << (i & 31); }
+  void markAll(uint16_t n){
+    memset(w, 0xFF, (n >> 5) * sizeof(uint32_t));
+    if (n & 31) w[n >> 5] |= (1UL << (n & 31)) - 1;
+  }
+  bool any() const { for (uint16_t k = 0; k < kWords; k++) if (w[k]) return true; return false; }
+  uint16_t count() const { uint16_t c = 0; for (uint16_t k = 0; k < kWords; k++) c += __builtin_popcount(w[k]); return c; }
+};
+
+extern LitSet gLit;
+
+// Same as FastLED's fadeToBlackBy(px, n, amount) over the lit pixels only.
+// Also rebuilds gPower's channel sums from the pixels it visits (every
+// non-black pixel is lit). On a compositor layer the sums are those of the
+// layer until the base mode draws or the blended frame is rescanned.
+void litFadeToBlackBy(CRGB* px, LitSet& lit, uint8_t amount);
@@ -0,0 +1,95 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Runtime instrumentation behind /metrics. Build with -DMETRICS=0 and every
+// probe below compiles to nothing, gMet included.
+#ifndef METRICS
+#define METRICS 1
+#endif
+
+#if METRICS
+#include "effects.h"
+
+// Timing is in CPU cycles (nanoseconds on the host) and converted to
+// microseconds only when reported. With power management the CPU clock
+// scales, so there it is esp_timer microseconds instead. Each record has one
+// writer task; a reader may see fields from two neighbouring updates, which
+// is fine for counters.
+#if defined(ARDUINO) && CONFIG_PM_ENABLE
+#define MET_TICKS_PER_US 1
+#elif defined(ARDUINO)
+#define MET_TICKS_PER_US (F_CPU / 1000000)
+#else
+#define MET_TICKS_PER_US 1000
+#endif
+uint32_t metTicks();
+
+struct MetTimer {
+  uint32_t n, max; uint64_t sum;   // ticks
+  void add(uint32_t t){ n++; sum += t; if (t > max) max = t; }
+};
+
+// Frame times in power-of-two microsecond buckets: bucket b counts frames of
+// [2^b, 2^(b+1)) us, bucket 0 also takes < 1 us, the last one everything above.
+#define MET_BUCKETS 17
+struct MetHist {
+  MetTimer t;
+  uint32_t bucket[MET_BUCKETS];
+  void add(uint32_t ticks){
+    t.add(ticks);
+    uint32_t us = ticks / MET_TICKS_PER_US;
+    uint8_t b = us ? 31 - __builtin_clz(us) : 0;
+    bucket[b < MET_BUCKETS ? b : MET_BUCKETS - 1]++;
+  }
+};
+
+enum MetStage : uint8_t { MS_RENDER, MS_POWER, MS_SHOW, MS_COUNT };     // render, power: loop(); show: transmit task
+enum MetHandler : uint8_t { MH_ASSET, MH_SET, MH_CTRL, MH_SCHEDULE, MH_WIFI, MH_METRICS, MH_MAP, MH_COUNT };  // web task
+#define MET_RT    MODE_COUNT         // frame[] slot for realtime ingest, after the built-in modes
+#define MET_MODES (MET_RT + 1)
+
+struct Metrics {
+  MetHist frame[MET_MODES];    // loop() render time per mode
+  MetTimer stage[MS_COUNT];
+  MetTimer handler[MH_COUNT];
+  uint32_t late;               // renders longer than the strip's wire time: the transmitter idled
+  uint32_t clamped;            // frames the power limit dimmed
+  uint32_t previewDrops;       // preview frames skipped for a backed-up viewer
+  uint32_t throttled;          // compositor layer draws skipped to stay in budget
+  uint32_t budget;             // wire time in ticks, for `late`
+};
+extern Metrics gMet;
+
+// What only the caller can read: heap, task stacks, pipeline and ingest counters.
+struct MetSystem {
+  uint32_t heapFree, heapMin, heapMaxAlloc;
+  uint32_t stackLoop, stackTx;           // bytes never used (high-water mark)
+  uint32_t published, transmitted;
+  uint32_t rtPackets, rtFrames, rtLost, rtIgnored;
+  uint32_t uptimeMs;
+};
+
+// JSON document for /metrics; returns its length, 0 if cap is too small.
+size_t metricsJson(const Metrics& m, const MetSystem& s, char* out, size_t cap);
+#define METRICS_JSON_MAX 3072
+
+struct MetScope {
+  MetTimer& t; uint32_t t0;
+  explicit MetScope(MetTimer& x) : t(x), t0(metTicks()) {}
+  ~MetScope(){ t.add(metTicks() - t0); }
+};
+
+#define MET_T0(v)          uint32_t v = metTicks()
+#define MET_STAGE(s, v)    gMet.stage[s].add(metTicks() - (v))
+#define MET_FRAME(mode, v) do { uint32_t d_ = metTicks() - (v); gMet.frame[mode].add(d_); \
+                                gMet.stage[MS_RENDER].add(d_); if (d_ > gMet.budget) gMet.late++; } while (0)
+#define MET_COUNT(field)   (gMet.field++)
+#define MET_HANDLER(h)     MetScope met_scope_(gMet.handler[h])
+#else
+#define MET_T0(v)
+#define MET_STAGE(s, v)    ((void)0)
+#define MET_FRAME(mode, v) ((void)0)
+#define MET_COUNT(field)   ((void)0)
+#define MET_HANDLER(h)
+#endif
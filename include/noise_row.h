@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+#include "config.h"
+
+// Batched 1D slice of FastLED's 2D inoise8: out[i] = inoise8(x0 + i*dx, y),
+// bit for bit. The y-dependent terms are computed once per row and the
+// permutation hashes once per lattice cell (every 256/dx pixels), leaving
+// only the gradient lerps per pixel.
+void noiseRow8(uint8_t* out, uint16_t n, uint16_t x0, uint16_t dx, uint16_t y);
+
+// Temporal cache over noiseRow8 for a slowly moving y (time) axis. Rows are
+// evaluated exactly at keyframes every NOISE_KEY_STEP units of y and linearly
+// interpolated in between; sliding forward one keyframe costs one row.
+#define NOISE_KEY_SHIFT 4
+#define NOISE_KEY_STEP  (1 << NOISE_KEY_SHIFT)
+
+struct PixMap;
+struct NoiseCache {
+  uint8_t a[NUM_LEDS], b[NUM_LEDS];  // rows at keyframes k and k+1
+  uint16_t key = 0;                  // y of row a
+  uint16_t n = 0, x0 = 0, dx = 0;    // row geometry the cache was built for
+  uint16_t map = 0;                  // 0: a row; else the pixel map's version
+  bool valid = false;
+
+  void sample(uint8_t* out, uint16_t count, uint16_t x0, uint16_t dx, uint16_t y);
+  // The same over space: out[i] = inoise8(x*s, y*s, z*s + t) at each mapped
+  // pixel, with t (time) keyframed and interpolated as y is above.
+  void sampleMap(uint8_t* out, const PixMap& m, uint8_t s, uint16_t t);
+
+private:
+  template <typename Fill> void advance(uint16_t k, bool rebuild, Fill fill);
+  void lerp(uint8_t* out, uint16_t count, uint16_t y, uint16_t k);
+};
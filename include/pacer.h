@@ -0,0 +1,85 @@
+#pragma once
+#include <stdint.h>
+#include "seqlock.h"
+
+// ---- Frame pacing ----
+// loop() renders on a fixed step instead of as often as it can. Due time
+// builds up in an accumulator. Each frame takes exactly one period from it,
+// so dt and the frame clock stay constant however late a frame starts. More
+// than PACE_MAX_STEPS behind (a stall), the whole periods past that are
+// dropped and counted: the animation pauses rather than taking one large
+// step, and the frame clock trails the wall clock by exactly what was
+// dropped. Between frames loop() blocks (see paceSleep in main.cpp).
+//
+// The period adapts once per stats window. If frames take longer than the
+// target period (after the compositor's throttling), the period stretches to
+// the average frame plus 1/16, so the pacer stops falling behind. Once frames
+// fit again it goes back down toward the target. Either way dt changes at
+// most once a window.
+//
+// A rendered frame only goes out when it differs from the last one shown.
+// frameHash() checks that; an unchanged frame is re-sent every
+// PACE_REFRESH_MS anyway. A dark or frozen scene then costs one render and
+// one hash per period, and nothing on the wire.
+//
+// All times come in as arguments, so the host drives it from a virtual clock.
+#define PACE_FPS        60     // target when Params.fps is 0
+#define PACE_MAX_FPS    120
+#define PACE_MAX_STEPS  4
+#define PACE_REFRESH_MS 1000
+#define PACE_WINDOW_US  1000000   // stats are published once per window
+
+extern uint8_t gTargetFps;     // frames per second; 0 = PACE_FPS
+
+// One window's worth, published for /pace. x10 values keep a decimal.
+struct PaceStats {
+  uint16_t targetFps;
+  uint16_t fpsX10;        // frames rendered
+  uint16_t shownX10;      // of those, frames sent to the strip
+  uint16_t dutyX10;       // percent of the window loop() was not asleep
+  uint32_t periodUs;       // adapted (see above)
+  uint32_t frames, shown, unchanged, dropped;   // since boot
+};
+
+class FramePacer {
+public:
+  void begin(uint32_t nowUs, uint32_t periodUs);
+  void setPeriod(uint32_t us){ mTarget = mPeriod = us ? us : 1; }
+  uint32_t period() const { return mTarget; }   // what setPeriod() asked for; PaceStats has the adapted one
+
+  // 0: a frame is due, take it with step(); else the us until one is.
+  uint32_t wait(uint32_t nowUs);
+  float step();                               // one period off the accumulator; dt in s
+  uint32_t clockMs() const { return (uint32_t)(mFrameUs / 1000); }   // frame clock: when the frame step() took starts
+  void hold(uint32_t nowUs);                  // not pacing (realtime ingest): nothing builds up
+  void sleeping(uint32_t nowUs){ mSleepAt = nowUs; mAsleep = true; }
+
+  // A rendered frame's hash; true if it should go out.
+  bool changed(uint32_t hash, uint32_t nowMs);
+  bool idle() const { return mIdle; }         // the last frame was unchanged
+  uint32_t dropped() const { return mDropped; }   // periods dropped since begin()
+
+  // Rolls the stats window at nowUs and adapts the period; true when it did
+  // and `out` is fresh.
+  bool report(uint32_t nowUs, uint16_t targetFps, PaceStats& out);
+
+private:
+  uint32_t mTarget = 1000000 / PACE_FPS, mPeriod = 1000000 / PACE_FPS;
+  uint32_t mLast = 0;          // when the accumulator was last topped up
+  uint32_t mAcc = 0;           // us due and not yet rendered
+  uint64_t mClockUs = 0, mFrameUs = 0;   // next frame's time; the current one's
+  uint32_t mHash = 0, mShownMs = 0;
+  bool mShownAny = false, mIdle = false;
+  uint32_t mSleepAt = 0; bool mAsleep = false;
+  uint32_t mWinStart = 0, mSleptUs = 0;
+  uint32_t mFrames = 0, mShown = 0, mUnchanged = 0, mDropped = 0;
+  uint32_t mWinFrames = 0, mWinShown = 0;
+};
+
+// Word hash of n pixels plus what scales them on the wire. px must be word
+// aligned; the pipeline buffers are.
+struct CRGB;
+uint32_t frameHash(const CRGB* px, uint16_t n, uint8_t brightness, const uint8_t* scale, uint8_t segs);
+
+extern FramePacer gPacer;
+extern SeqLock<PaceStats> gPacePub;   // loop() -> /pace, once per window
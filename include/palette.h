@@ -0,0 +1,15 @@
+#pragma once
+#include <FastLED.h>
+
+// Lazily rebuilt CHSV->CRGB tables, keyed on gHueBase/gSaturation. Each getter
+// compares its key and rebuilds only when a slider (or the hue drift) moved.
+const CRGB* palVal();    // [v] = CHSV(gHueBase, gSaturation, v)
+const CRGB* palHue();    // [h] = CHSV(h, gSaturation, 255), for per-pixel hue offsets
+const CRGB* palSwarm();  // [n] = Swarm's CHSV(gHueBase + scale8(n,20), gSaturation, scale8(n,220))
+
+// CHSV(h, s, v) from full = CHSV(h, s, 255): hsv2rgb_rainbow applies value
+// last, as scale8 by scale8_video(v, v), so this matches it exactly.
+inline CRGB palDim(const CRGB& full, uint8_t v){
+  uint8_t s = scale8_video(v, v);
+  return CRGB(scale8(full.r, s), scale8(full.g, s), scale8(full.b, s));
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <stdint.h>
+#include "seqlock.h"
+#include "spsc_queue.h"
+
+// Web-facing parameters. Handlers (AsyncTCP task) edit a private copy and
+// publish it; loop() takes at most one consistent snapshot per frame and
+// applies the fields that changed, so the scheduler's mode and the hue drift
+// are only overridden when the user actually moved that control.
+// fps is the render target (0: PACE_FPS, see pacer.h); it took what was padding
+// in the stored scene, so a scene saved before it loads with 0.
+struct Params { uint8_t mode, brightness, density, speed, hue, sat, lifespan, fade; bool drift; uint8_t preview, fps; };
+
+// ----- Simple scheduler -----
+// Items may also override scene parameters while they run; bit f of `set`
+// marks val[f] as present.
+enum SchedField : uint8_t { SF_BRIGHT, SF_DENSITY, SF_SPEED, SF_HUE, SF_SAT, SF_LIFE, SF_FADE, SF_DRIFT, SF_COUNT };
+struct SchedItem { uint8_t mode; uint32_t duration_ms; uint8_t set; uint8_t val[SF_COUNT]; uint16_t xfade_ms; };  // xfade_ms: crossfade into this item, 0 cuts
+#define MAX_SCHEDULE_ITEMS 64
+struct Schedule { SchedItem items[MAX_SCHEDULE_ITEMS]; uint8_t count; };
+
+extern SeqLock<Params>   gParamsPub;
+extern SeqLock<Schedule> gSchedPub;
+extern SpscQueue<int16_t, 16> gRippleQ;  // ripple triggers: pixel index, -1 = random
+
+// Writer side (web task only)
+Params& paramsEdit();
+void paramsPublish();
+
+// Render side
+void paramsRestore(const Params& p);  // saved scene into the globals; call before paramsInit
+void paramsInit();    // seed the block from the current globals; call before the web server starts
+bool paramsApply();   // apply a newer snapshot if one is complete; true if it was
+const Params& paramsCurrent();         // last applied snapshot (what the user set)
+Params paramsLive();                   // the render globals now: schedule overrides and hue drift included
+void schedEnter(const SchedItem& it);  // switch to a schedule item's mode and overrides
@@ -0,0 +1,68 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "params.h"
+
+// Key/value backend: Preferences (NVS) on the device, a write-counting mock
+// on the host. get() returns 0 when the key is absent or its size differs;
+// put() returns false when the bytes were not all written.
+class KvStore {
+public:
+  virtual size_t get(const char* key, void* buf, size_t len) = 0;
+  virtual bool put(const char* key, const void* buf, size_t len) = 0;
+};
+
+uint32_t crc32(const void* data, size_t len, uint32_t crc = 0);
+
+// One blob under one key. save() skips the flash write when the contents
+// match what was last loaded or saved; a failed write is not remembered, so
+// the next save() of the same bytes tries again.
+struct BlobSlot {
+  const char* key;
+  uint32_t crc = 0;
+  bool known = false;
+  explicit BlobSlot(const char* k) : key(k) {}
+  bool load(KvStore& kv, void* buf, size_t len);
+  bool save(KvStore& kv, const void* buf, size_t len);   // true if it wrote them
+};
+
+// The scene (web-facing Params plus the schedule) as one versioned blob.
+// touch() marks it changed; tick() writes once things have been quiet for
+// PERSIST_QUIET_MS, or PERSIST_MAX_MS after the first change if they never
+// settle, so a slider drag costs one write instead of one per event. A write
+// that fails is retried PERSIST_QUIET_MS later.
+#define PERSIST_QUIET_MS 3000
+#define PERSIST_MAX_MS   30000
+#define SCENE_MAGIC      0x4646   // "FF"
+#define SCENE_VERSION    1
+
+// crc covers params and schedule. It sits ahead of them: a CRC appended to
+// its own data makes the whole-blob CRC BlobSlot compares a constant.
+struct SceneBlob { uint16_t magic, version; uint32_t crc; Params params; Schedule schedule; };
+
+class ScenePersist {
+public:
+  explicit ScenePersist(KvStore& kv) : mKv(kv) {}
+  bool load(Params& p, Schedule& s);   // false: nothing stored, other version, or corrupt
+  void touch(uint32_t now);
+  bool tick(uint32_t now, const Params& p, const Schedule& s);   // true if it wrote
+
+private:
+  KvStore& mKv;
+  BlobSlot mSlot{"scene"};
+  SceneBlob mBlob;
+  bool mDirty = false;
+  uint32_t mFirst = 0, mLast = 0;
+};
+
+#ifdef ARDUINO
+// One Preferences namespace; opened per call so any task may use it.
+class NvsStore : public KvStore {
+public:
+  explicit NvsStore(const char* ns) : mNs(ns) {}
+  size_t get(const char* key, void* buf, size_t len) override;
+  bool put(const char* key, const void* buf, size_t len) override;
+private:
+  const char* mNs;
+};
+#endif
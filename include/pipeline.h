@@ -0,0 +1,40 @@
+#pragma once
+#include <atomic>
+#include <FastLED.h>
+#include "config.h"
+#include "segments.h"
+
+// Render/transmit hand-off over two frame buffers. The render side fills
+// frame k into buffer k&1 while the transmit side is still clocking frame k-1
+// out of the other one. A side only waits when it gets a whole frame ahead,
+// so the frame period approaches max(render, transmit) instead of the sum.
+// Single producer, single consumer; the shared state is two frame counters.
+class FramePipe {
+public:
+  // scale: brightness per output segment, after power limiting
+  struct Frame { const CRGB* px; uint8_t brightness; uint32_t seq; const uint8_t* scale; };
+
+  // Render side. back() waits until its buffer is off the wire. Without
+  // per-segment scales every segment gets `brightness`.
+  CRGB* back();
+  void publish(uint8_t brightness, const uint8_t* scale = nullptr);
+
+  // Transmit side. acquire() waits for the next published frame; every frame
+  // is delivered once, in order.
+  Frame acquire();
+  void release();
+
+  uint32_t published() const { return mPublished.load(std::memory_order_relaxed); }
+  uint32_t transmitted() const { return mReleased.load(std::memory_order_relaxed); }
+
+private:
+  alignas(4) CRGB mBuf[2][NUM_LEDS];   // word aligned for the blend kernels
+  uint8_t mBright[2] = { 0, 0 };
+  uint8_t mScale[2][MAX_SEGMENTS];
+  std::atomic<uint32_t> mPublished{0};  // frames handed to the transmitter
+  std::atomic<uint32_t> mReleased{0};   // frames fully transmitted
+  std::atomic<void*> mRenderTask{nullptr};  // for wakeups; unused on the host
+  std::atomic<void*> mTxTask{nullptr};
+};
+
+extern FramePipe gPipe;
@@ -0,0 +1,57 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "config.h"
+
+// Physical pixel positions, for installs strung through trees and over
+// pergolas rather than along a line. Uploaded coordinates are integers in any
+// unit; they are quantized once to 0..255 on every axis with one common scale
+// (the longest side spans 0..255, so spheres stay round) and kept as three
+// bytes per pixel, in flash and in RAM. A coarse grid of MAP_GRID^3 cells
+// lists the pixels in each cell, so a shell or a box visits only the cells it
+// touches. With no map loaded (count 0) the effects run on the strip index.
+#define MAP_GRID_SHIFT 5                  // cells of 32 units
+#define MAP_GRID       (256 >> MAP_GRID_SHIFT)
+#define MAP_CELLS      (MAP_GRID * MAP_GRID * MAP_GRID)
+
+struct PixMap {
+  uint16_t count;                         // mapped pixels; must equal gNumLeds to be used
+  uint16_t version;                       // bumped by every build, for caches over the map
+  uint8_t x[NUM_LEDS], y[NUM_LEDS], z[NUM_LEDS];
+  uint16_t cellStart[MAP_CELLS + 1];      // cell c holds order[cellStart[c] .. cellStart[c+1])
+  uint16_t order[NUM_LEDS];               // pixel indices sorted by cell
+
+  // Quantized xyz (3 bytes per pixel, the stored form) -> tables and grid.
+  void build(const uint8_t* xyz, uint16_t n);
+  static uint16_t cellOf(uint8_t x, uint8_t y, uint8_t z){
+    return ((x >> MAP_GRID_SHIFT) * MAP_GRID + (y >> MAP_GRID_SHIFT)) * MAP_GRID + (z >> MAP_GRID_SHIFT);
+  }
+};
+extern PixMap gMap;
+bool mapActive();   // a map covers the current strip
+
+// Upload body: integers, three per pixel, with anything else between them as
+// a separator, so "x,y,z" lines and [[x,y,z],...] JSON both parse. A fraction
+// is rounded. Fed in chunks as they arrive; no heap. The staging, in the
+// uploaded units, is the caller's: NUM_LEDS * 3 values, lent for the upload.
+class MapParser {
+public:
+  void begin(int16_t* raw);
+  bool feed(const uint8_t* p, size_t n);  // false once the input is invalid
+  // Quantizes into xyz (3 * count bytes), which may be the staging itself;
+  // false unless a whole number of triples, at least one, arrived.
+  bool finish(uint8_t* xyz, uint16_t& count);
+  uint16_t pixels() const { return mVals / 3; }
+
+private:
+  void endNumber();
+  int16_t* mRaw;
+  uint32_t mVals;
+  int32_t mCur;
+  bool mIn, mNeg, mMinus, mFrac, mFracSeen, mRoundUp, mBad;
+};
+
+#ifdef ARDUINO
+bool mapLoad(uint8_t* xyz);                // from Preferences into xyz (NUM_LEDS * 3), then builds gMap
+bool mapSave(const uint8_t* xyz, uint16_t n);   // n = 0 clears the map; false if flash did not take it
+#endif
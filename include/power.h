@@ -0,0 +1,70 @@
+#pragma once
+#include <FastLED.h>
+#include "segments.h"
+
+// Power accounting kept up to date while a frame renders, so the limiter has
+// nothing to scan. Per segment, the channel sums of every pixel are held in
+// gPower; whatever writes leds[] keeps them current:
+//   fade kernels (litset.h)  rebuild them from the lit pixels they visit
+//   powerAdd()               additive writes (flies, twinkles, rings)
+//   powerFill*()             modes that write every pixel
+//   powerCopy()              frames that arrive over the network
+//   powerScan()              composited frames (compositor.h)
+// The model and its rounding are FastLED's (power_mgt.cpp), per controller,
+// so the limit matches what setMaxPowerInVoltsAndMilliamps() would pick.
+#define POWER_VOLTS   5
+#define POWER_RED_MW  80   // 16 mA at full red
+#define POWER_GREEN_MW 55  // 11 mA
+#define POWER_BLUE_MW 75   // 15 mA
+#define POWER_DARK_MW 5    // 1 mA per pixel, lit or not
+
+struct PowerSum { uint32_t r, g, b; };
+
+struct PowerAcct {
+  PowerSum seg[MAX_SEGMENTS];
+  uint16_t end[MAX_SEGMENTS];   // one past each segment's last pixel; the last one takes any rest
+  uint8_t count;
+
+  void setLayout(const Layout& l);
+  void clear(){ memset(seg, 0, sizeof(seg)); }
+  uint8_t segOf(uint16_t i) const { uint8_t s = 0; while (s + 1 < count && i >= end[s]) s++; return s; }
+};
+extern PowerAcct gPower;
+
+// leds[i] += c, with the sums and the lit set kept in step.
+struct LitSet;
+void powerAdd(CRGB* px, LitSet& lit, uint16_t i, const CRGB& c);
+
+// px[0..n) = f(i) for every pixel, rebuilding the sums as it goes.
+template <typename F> inline void powerFillWith(CRGB* px, uint16_t n, F f){
+  uint16_t i = 0;
+  for (uint8_t s = 0; s < gPower.count; s++){
+    PowerSum a = {};
+    for (uint16_t e = s + 1 < gPower.count && gPower.end[s] < n ? gPower.end[s] : n; i < e; i++){ CRGB c = f(i); px[i] = c; a.r += c.r; a.g += c.g; a.b += c.b; }
+    gPower.seg[s] = a;
+  }
+}
+// Sums rebuilt by a kernel that visits pixels in order (the lit-set walks):
+// add() every non-black pixel; the segment only ever moves forward.
+struct PowerWalk {
+  uint8_t s = 0;
+  PowerSum a = {};
+  PowerWalk(){ gPower.clear(); }
+  void add(uint16_t i, const CRGB& c){
+    if (i >= gPower.end[s] && s + 1 < gPower.count){ gPower.seg[s] = a; a = {}; s = gPower.segOf(i); }
+    a.r += c.r; a.g += c.g; a.b += c.b;
+  }
+  ~PowerWalk(){ gPower.seg[s] = a; }
+};
+
+void powerFill(CRGB* px, uint16_t n, const CRGB& c);          // fill_solid
+void powerCopy(CRGB* dst, const CRGB* src, uint16_t n);       // memcpy, summing src
+void powerScan(const CRGB* px, uint16_t n);                   // sums of px[0..n) from scratch
+
+// Limiter. Scales the target brightness to keep the whole install within
+// maxMa and each segment within its own budget (Segment::ma, 0 = none), so a
+// bright run on one injection point dims only that run. Writes one
+// brightness per segment and the estimated draw after limiting.
+struct PowerOut { uint8_t scale[MAX_SEGMENTS]; uint16_t ma[MAX_SEGMENTS]; uint32_t totalMa; bool clamped; };
+void powerLimit(const Layout& l, uint8_t brightness, uint32_t maxMa, PowerOut& out);
+uint32_t powerUnscaledMw(const PowerSum& s, uint16_t pixels);  // FastLED's calculate_unscaled_power_mW
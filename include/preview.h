@@ -0,0 +1,25 @@
+#pragma once
+#include <FastLED.h>
+
+// Preview stream encoding. A frame is a 3-byte header, [flags][count lo][count hi],
+// followed by ops that each start with a LEB128 varint (run << 2) | op:
+//   PV_SKIP    run pixels unchanged since the previous frame
+//   PV_LITERAL run RGB triplets follow
+//   PV_REPEAT  one RGB triplet follows, repeated run times
+// Deltas are against the last frame the encoder emitted; a key frame is a
+// delta against black, so dark modes stay small either way.
+enum { PV_SKIP = 0, PV_LITERAL = 1, PV_REPEAT = 2 };
+#define PV_FLAG_KEY 0x01
+
+extern uint8_t gPreviewFps;  // preview frames per second; 0 = off
+
+// A key frame goes out at least this often, so a viewer that missed a delta
+// (a message the socket dropped, a client that joined mid-stream and missed
+// the key it asked for) is back in step within that time.
+#define PREVIEW_KEY_MS 1000
+
+// Worst-case encoded size for n pixels.
+#define PREVIEW_MAX_BYTES(n) (3 + (size_t)(n) * 4 + 8)
+
+// Encodes cur against prev (or black when key), then copies cur into prev.
+size_t previewEncode(const CRGB* cur, CRGB* prev, uint16_t n, bool key, uint8_t* out);
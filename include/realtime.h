@@ -0,0 +1,58 @@
+#pragma once
+#include <stddef.h>
+#include <FastLED.h>
+#include "config.h"
+
+// Realtime pixel ingest from a show controller over UDP: DDP and E1.31/sACN.
+// Both sockets are non-blocking and polled from the render loop, so leds[]
+// has a single writer. Each datagram is peeked for its header and then read
+// with a scatter list whose second entry points into the pixel buffer, so the
+// payload lands in place without a staging copy; bytes past the strip are
+// truncated by the socket layer.
+#define RT_DDP_PORT      4048
+#define RT_E131_PORT     5568
+#define RT_E131_UNIVERSE 1      // first universe; 170 RGB pixels per universe
+#define RT_E131_PIXELS   170
+#define RT_MAX_UNIVERSES ((NUM_LEDS + RT_E131_PIXELS - 1) / RT_E131_PIXELS)
+#define RT_TIMEOUT_MS    2500   // silence before the built-in modes take over again
+
+// What one datagram holds. hdr is the header length; off/len place the
+// payload in the pixel buffer as byte offsets, already clipped to the strip.
+// E1.31 also reports its universe, sync address and stream state.
+struct RtSpan {
+  uint16_t hdr; uint32_t off, len;
+  bool data, push, drop, sync, terminated;
+  uint16_t universe, syncUniverse;
+};
+
+// Header parsers; got is how many header bytes are available. Portable so
+// the host can test them without sockets.
+RtSpan rtParseDdp(const uint8_t* h, size_t got, uint16_t n);
+RtSpan rtParseE131(const uint8_t* h, size_t got, uint16_t n);
+
+struct RtStats { uint32_t packets, frames, lost, ignored; };
+
+class RtIngest {
+public:
+  bool begin(uint16_t ddpPort = RT_DDP_PORT, uint16_t e131Port = RT_E131_PORT);
+  // Drains waiting datagrams into px. Returns true as soon as one completes a
+  // frame (DDP push, last E1.31 universe or sync) so the caller can publish
+  // it before the next frame's packets land.
+  bool poll(CRGB* px, uint16_t n);
+  bool active() const;   // data seen within RT_TIMEOUT_MS and stream not terminated
+
+  RtStats stats = {};
+
+private:
+  int recvOne(int fd, bool ddp, CRGB* px, uint16_t n);
+  bool sequence(bool ddp, const uint8_t* h);
+
+  int mDdp = -1, mE131 = -1;
+  uint32_t mLastMs = 0;
+  bool mHeard = false;
+  uint8_t mDdpSeq = 0;
+  uint8_t mUniSeq[RT_MAX_UNIVERSES] = {};
+  uint16_t mSyncUniverse = 0;  // nonzero: E1.31 frames wait for this sync
+};
+
+extern RtIngest gRt;
@@ -0,0 +1,34 @@
+#pragma once
+#include <stdint.h>
+
+// xoshiro128** : four words of state, 32-bit shifts, rotates and two small
+// multiplies per draw, so it stays cheap on the ESP32. Each effect draws from
+// its own stream; one seed reproduces a run exactly, and one mode's draws
+// never shift another's sequence.
+struct Rng {
+  uint32_t s[4];
+
+  void seed(uint32_t v){   // splitmix32 spreads any seed over the state
+    for (int i = 0; i < 4; i++){
+      uint32_t z = (v += 0x9E3779B9u);
+      z = (z ^ (z >> 16)) * 0x85EBCA6Bu; z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+      s[i] = z ^ (z >> 16);
+    }
+  }
+  uint32_t next(){
+    uint32_t r = rotl(s[1] * 5, 7) * 9, t = s[1] << 9;
+    s[2] ^= s[0]; s[3] ^= s[1]; s[1] ^= s[2]; s[0] ^= s[3];
+    s[2] ^= t; s[3] = rotl(s[3], 11);
+    return r;
+  }
+  uint32_t below(uint32_t n){ return (uint32_t)(((uint64_t)next() * n) >> 32); }        // [0, n)
+  uint16_t range(uint16_t a, uint16_t b){ return a + below((uint32_t)b - a + 1); }      // [a, b]
+  uint8_t  u8(){ return next() >> 24; }
+
+private:
+  static uint32_t rotl(uint32_t x, int k){ return (x << k) | (x >> (32 - k)); }
+};
+
+enum RngStream : uint8_t { RNG_FLY, RNG_TWINKLE, RNG_RIPPLE, RNG_COUNT };
+extern Rng gRng[RNG_COUNT];
+void rngSeed(uint32_t seed);   // every stream, each from its own offset of seed
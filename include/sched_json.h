@@ -0,0 +1,61 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "params.h"
+
+// Incremental /schedule body parser. Bytes are fed as the chunks arrive and
+// go through a byte-at-a-time JSON state machine straight into a staging
+// Schedule; nothing is buffered and nothing allocates. Accepts
+//   {"items":[{"mode":2,"seconds":30,"bright":120,"hue":40}, ...]}
+// or the bare array. Durations come from "seconds", "minutes" or "ms"
+// (decimals allowed); "xfade" is a crossfade into the item in seconds (up to
+// 60, none by default); "bright", "density", "speed", "hue", "sat", "life",
+// "fade" and "drift" are optional per-item overrides. Unknown keys and
+// values of any shape are skipped. Items without a duration or with a mode
+// past the last one are dropped, as are items past MAX_SCHEDULE_ITEMS.
+class SchedParser {
+public:
+  void begin();
+  bool feed(const uint8_t* p, size_t n);  // false once the input is invalid
+  bool finish();                          // true if a whole document parsed
+
+  const Schedule& result() const { return mSched; }
+  size_t errorAt() const { return mPos; }  // byte offset of the first bad byte
+  uint16_t dropped() const { return mDropped; }
+
+private:
+  enum State : uint8_t { ST_VALUE, ST_KEY_OR_END, ST_KEY, ST_COLON, ST_NEXT,
+                         ST_STRING, ST_STR_ESC, ST_HEX, ST_NUMBER, ST_LITERAL, ST_DONE, ST_ERROR };
+  enum { MAX_DEPTH = 16, KEY_LEN = 12 };
+
+  bool step(uint8_t c);       // false: reprocess c in the new state
+  bool open(bool object);
+  bool close(bool object);
+  void scalar(int64_t milli); // number (x1000) or bool (0/1000) at the current key
+  void endValue();
+  uint8_t keyId() const;
+
+  Schedule mSched;
+  SchedItem mItem;
+  bool mItemTimed;
+  uint16_t mDropped;
+  size_t mPos;
+  State mState;
+  uint8_t mDepth, mItemsDepth;  // mItemsDepth: depth inside the items array, 0 = not found yet
+  uint16_t mObjBits;            // bit d set: container at depth d+1 is an object
+  char mKey[KEY_LEN];
+  uint8_t mKeyLen;
+  bool mKeyItems;               // current root key is "items"
+  bool mFirst;                  // container just opened: may close empty
+  bool mInKey;                  // escape belongs to a key, not a value
+  uint8_t mHex;                 // hex digits left in a unicode escape
+  const char* mLit;             // literal being matched
+  uint8_t mLitIdx;
+  // number: grammar position, sign, integer part, fraction (to 1/1000), exponent
+  uint8_t mNumPart;
+  bool mNeg, mExpNeg;
+  int64_t mInt;
+  uint16_t mFracMilli;
+  uint8_t mFracDigits;
+  int16_t mExpVal;
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include <FastLED.h>
+#include "config.h"
+
+// Output layout: one logical pixel buffer split across several data pins,
+// each on its own RMT channel. FastLED's ESP32 RMT driver starts every
+// controller before it waits, so segments go out in parallel and the wire
+// time is set by the longest segment, not the total. Effects still address
+// 0..gNumLeds-1; segment i covers the pixels after segment i-1.
+#define MAX_SEGMENTS 8   // RMT channels on the ESP32
+
+// ma: current budget of the supply feeding this segment, 0 = only the global
+// MAX_MA applies (see power.h).
+struct Segment { uint8_t pin; uint16_t count; uint16_t ma; };
+struct Layout  { uint8_t count; Segment seg[MAX_SEGMENTS]; };
+
+extern Layout gLayout;
+
+uint16_t layoutTotal(const Layout& l);
+bool layoutValid(const Layout& l);       // pins supported, counts > 0, total <= NUM_LEDS
+bool layoutParse(const char* s, Layout& l);  // "pin:count[:mA],pin:count[:mA],..."
+
+// Wire-time model for WS281x at 800 kHz: 24 bits x 1.25 us per pixel on the
+// longest segment, plus the latch gap.
+#define WIRE_US_PER_PIXEL 30
+#define WIRE_LATCH_US     80
+uint32_t layoutWireUs(const Layout& l);
+
+#ifdef ARDUINO
+bool layoutLoad();                     // from Preferences; falls back to LED_PIN x NUM_LEDS
+void layoutSave(const Layout& l);      // takes effect on the next boot
+void layoutAttach();                   // one FastLED controller per segment
+void layoutShow(const CRGB* px, const uint8_t* scale);  // point controllers at px, show segment i at scale[i]
+#endif
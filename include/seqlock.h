@@ -0,0 +1,33 @@
+#pragma once
+#include <atomic>
+#include <string.h>
+
+// Single-writer sequence lock for small POD blocks. The writer never waits;
+// a reader that overlaps a write gets false and keeps its previous copy, so
+// the render loop never spins on a preempted writer.
+template <typename T>
+class SeqLock {
+public:
+  void write(const T& v){
+    uint32_t s = mSeq.load(std::memory_order_relaxed);
+    mSeq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(&mData, &v, sizeof(T));
+    mSeq.store(s + 2, std::memory_order_release);
+  }
+
+  // Copies the block if a complete version newer than `seen` is available.
+  bool read(T& out, uint32_t& seen) const {
+    uint32_t s0 = mSeq.load(std::memory_order_acquire);
+    if ((s0 & 1) || s0 == seen) return false;
+    memcpy(&out, &mData, sizeof(T));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (mSeq.load(std::memory_order_relaxed) != s0) return false;
+    seen = s0;
+    return true;
+  }
+
+private:
+  std::atomic<uint32_t> mSeq{0};
+  T mData;
+};
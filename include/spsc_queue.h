@@ -0,0 +1,29 @@
+#pragma once
+#include <atomic>
+#include <stdint.h>
+
+// Lock-free single-producer/single-consumer ring. N must be a power of two.
+// push() fails instead of blocking when the consumer is a full ring behind.
+template <typename T, uint16_t N>
+class SpscQueue {
+  static_assert((N & (N - 1)) == 0, "N must be a power of two");
+public:
+  bool push(const T& v){
+    uint16_t h = mHead.load(std::memory_order_relaxed);
+    if ((uint16_t)(h - mTail.load(std::memory_order_acquire)) == N) return false;
+    mBuf[h & (N - 1)] = v;
+    mHead.store(h + 1, std::memory_order_release);
+    return true;
+  }
+  bool pop(T& v){
+    uint16_t t = mTail.load(std::memory_order_relaxed);
+    if (t == mHead.load(std::memory_order_acquire)) return false;
+    v = mBuf[t & (N - 1)];
+    mTail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  T mBuf[N];
+  std::atomic<uint16_t> mHead{0}, mTail{0};
+};
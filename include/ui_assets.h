@@ -0,0 +1,384 @@
+// Generated by tools/embed_ui.py from ui/; do not edit.
+#pragma once
+#include <stdint.h>
+#ifdef ARDUINO
+#include <Arduino.h>  // PROGMEM
+#else
+#define PROGMEM
+#endif
+
+struct UiAsset { const char* url; const char* type; const uint8_t* gz; uint32_t len, rawLen; const char* etag; };
+
+// ui/index.html: 15478 bytes raw, 13777 minified, 5199 gzipped
+static const uint8_t UI_INDEX_GZ[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xad,0x5b,0xe9,0x92,0xdb,0x46,
+  0x92,0xfe,0xdf,0x4f,0x51,0xa6,0xc2,0x06,0x28,0xa2,0xc1,0xa3,0x0f,0xb5,0x48,0x82,
+  0x1a,0x59,0x47,0x58,0x1b,0xba,0xd6,0x2d,0xaf,0x7f,0x74,0x28,0x1c,0x45,0xa0,0x48,
+  0x96,0x1a,0x04,0x60,0x1c,0x64,0xf7,0x52,0x8c,0x98,0x77,0xd8,0x77,0xd8,0x57,0xd8,
+  0xff,0xfb,0x28,0xf3,0x24,0xfb,0x65,0x55,0x81,0x04,0x49,0x50,0xea,0xf1,0x4e,0x4c,
+  0xb8,0x45,0xd4,0x91,0x95,0xe7,0x97,0x99,0x05,0xcc,0xf0,0x87,0x20,0xf6,0xf3,0xfb,
+  0x44,0xb0,0x59,0x3e,0x0f,0x47,0x43,0xf3,0x57,0xf0,0x60,0x34,0x9c,0x8b,0x9c,0xb3,
+  0x88,0xcf,0x85,0xb7,0x90,0x62,0x99,0xc4,0x69,0xce,0xfc,0x38,0xca,0x45,0x94,0x7b,
+  0xd6,0x52,0x06,0xf9,0xcc,0x0b,0xc4,0x42,0xfa,0xe2,0x54,0x3d,0x38,0x32,0x92,0xb9,
+  0xe4,0xe1,0x69,0xe6,0xf3,0x50,0x78,0x5d,0x6b,0x34,0xcc,0x65,0x1e,0x8a,0xd1,0x6b,
+  0x99,0x8a,0x49,0x28,0x45,0x36,0x6c,0xeb,0x01,0x36,0xcc,0xf2,0x7b,0xfc,0xdb,0x4f,
+  0xe3,0x38,0x5f,0x9d,0x9e,0x8e,0xa7,0xfd,0x47,0x9d,0x71,0x27,0xe8,0xf6,0x06,0xa7,
+  0xa7,0x3e,0x4f,0x83,0xfe,0xa3,0x6e,0xaf,0xfb,0xa4,0x77,0x81,0xc7,0x5c,0xdc,0xe5,
+  0xfd,0x47,0xe2,0x52,0xf8,0x13,0x9a,0x9d,0x17,0xb9,0xc0,0xf4,0xd3,0x0b,0xde,0x1b,
+  0x77,0xf0,0xcc,0x7d,0xbf,0xff,0xe8,0x42,0x88,0xce,0xa5,0x8f,0xa7,0x94,0xcb,0xb0,
+  0xff,0xa8,0x37,0x3e,0xeb,0x9d,0x5f,0xe2,0x71,0xc6,0xa3,0x20,0x14,0x18,0xe0,0x4f,
+  0x7b,0xe7,0xdd,0xf5,0xe3,0xd5,0x38,0xbe,0x3b,0xcd,0xe4,0x7f,0xca,0x68,0xda,0x1f,
+  0xc7,0x69,0x20,0xd2,0x53,0x8c,0xac,0xc7,0x71,0x70,0xbf,0x9a,0xf3,0x74,0x2a,0xa3,
+  0x7e,0x67,0x30,0xe6,0xfe,0xed,0x34,0x8d,0x8b,0x28,0xe8,0x2f,0x78,0x6a,0x13,0x77,
+  0xcd,0x81,0x1f,0x87,0x71,0x6a,0x9e,0x89,0xa3,0xe6,0x60,0x02,0x45,0xf4,0xbb,0x97,
+  0xc9,0x5d,0xbb,0xeb,0x9e,0x5f,0xb0,0xec,0x3e,0xcb,0xc5,0xfc,0xb4,0x90,0xce,0x29,
+  0x4f,0x92,0x50,0x9c,0xea,0x01,0xe7,0x5a,0x4c,0x63,0xc1,0x7e,0x7b,0xe3,0xfc,0x1a,
+  0x8f,0xe3,0x3c,0x76,0x7e,0x11,0xe1,0x42,0xe4,0xd2,0xe7,0xce,0xf3,0x14,0xba,0x5a,
+  0xbb,0xcb,0x94,0x27,0x38,0xfc,0x4e,0xeb,0xb0,0x7f,0x75,0xd5,0x49,0xee,0x06,0x86,
+  0x99,0xb3,0x5e,0x72,0xc7,0x78,0x91,0xc7,0x83,0x84,0x07,0x01,0x71,0xdd,0x61,0xdd,
+  0xab,0xe4,0x6e,0xed,0x92,0x92,0x56,0x07,0x9c,0xd2,0x68,0x73,0x60,0x24,0x4b,0x79,
+  0x20,0x8b,0xac,0xdf,0x3d,0x07,0xbd,0x72,0x3b,0x6d,0x2e,0x89,0xd3,0x04,0x83,0xb8,
+  0xa4,0x92,0x19,0x0f,0xe2,0x25,0x88,0x43,0x1c,0x75,0x00,0x4b,0xa7,0x63,0x6e,0x77,
+  0x1c,0xfa,0x9f,0xdb,0xbb,0x6a,0xae,0x67,0xbd,0x52,0x41,0x34,0x0b,0x2e,0xb0,0x79,
+  0x1d,0xf2,0xb1,0x08,0x57,0x81,0xcc,0x92,0x90,0xdf,0xf7,0x27,0xa1,0xb8,0x1b,0x7c,
+  0x29,0xb2,0x5c,0x4e,0xee,0x4f,0x8d,0x9b,0xf4,0xb3,0x84,0xc3,0x3d,0xc6,0x22,0x5f,
+  0x0a,0x11,0x0d,0x78,0x28,0xa7,0xd1,0xa9,0x84,0x5e,0xb2,0xbe,0x8f,0x69,0x91,0x6e,
+  0x98,0xe9,0x29,0xb2,0x97,0x24,0xdb,0x82,0x87,0xab,0x18,0xfb,0x64,0x7e,0xdf,0x77,
+  0xaf,0x2e,0x94,0xa6,0x4f,0x21,0xa0,0xe4,0xf8,0x37,0x2a,0xe6,0x22,0x95,0x7e,0x3f,
+  0xe7,0xe3,0x22,0xe4,0x29,0x3d,0x67,0xeb,0x4c,0x84,0xc2,0xcf,0xe1,0x7f,0x49,0x91,
+  0xdf,0x90,0x2f,0x7b,0x29,0x8f,0xa6,0xe2,0xb3,0x33,0x2e,0xf2,0x3c,0x8e,0x56,0x5a,
+  0xb5,0xdd,0x4e,0xe7,0xc7,0xf5,0xc1,0x9a,0x15,0x3c,0x08,0xac,0x9c,0x56,0x2d,0x8c,
+  0xa1,0xe6,0xda,0x9d,0xc9,0x28,0x5f,0x55,0x87,0x95,0xef,0x69,0xcb,0x93,0x17,0x89,
+  0xbe,0xfb,0x54,0xcc,0x4b,0x09,0x4e,0xb5,0x04,0xdd,0x0e,0x89,0x90,0xc6,0xcb,0x8d,
+  0x5e,0xa6,0xa9,0x0c,0x06,0xf4,0x07,0x8e,0x33,0xc7,0x48,0x2e,0xe8,0xac,0x62,0x1e,
+  0xc1,0x36,0x93,0x94,0xe1,0xbf,0xc1,0x94,0x27,0xca,0x1c,0xeb,0xbf,0xcd,0x45,0x20,
+  0x39,0xb3,0xb7,0xfe,0xf0,0xe4,0x1c,0x04,0x9b,0x2b,0x45,0xf1,0x28,0x91,0xf5,0xda,
+  0x1d,0xe7,0x91,0xb1,0xd0,0x69,0x1e,0x83,0x5a,0xa7,0x6a,0x75,0x62,0x4d,0xf9,0x81,
+  0x76,0x0d,0x72,0xf2,0x5d,0x1f,0xa1,0xd5,0x07,0xde,0x44,0x5a,0x30,0x8e,0xff,0xa8,
+  0x73,0xd9,0xeb,0x76,0xc6,0x5a,0xf4,0xa5,0x90,0xd3,0x59,0xde,0x7f,0xd2,0xe9,0xa8,
+  0x63,0xdd,0x4c,0xc0,0xda,0x01,0x4f,0xef,0xab,0x0e,0xf9,0xa8,0x37,0x39,0xbb,0x38,
+  0xbf,0x2a,0xf7,0x07,0x4f,0x45,0x47,0x70,0xac,0xe7,0xe9,0x6a,0xa6,0xf7,0xeb,0x43,
+  0x77,0xf8,0xb8,0xaa,0x63,0x83,0x62,0xba,0x39,0x88,0x17,0x22,0x9d,0x84,0x70,0xd2,
+  0x99,0x0c,0x02,0x11,0xad,0xdd,0x09,0xa0,0x43,0xa4,0xdf,0xb1,0xcf,0xd5,0xc5,0xc6,
+  0x40,0x1b,0xb5,0xac,0xdd,0xcc,0x9f,0x89,0xe0,0x34,0x94,0x59,0xbe,0xa2,0x3f,0xa7,
+  0x0a,0x8c,0xfa,0x51,0x1c,0x89,0xc1,0x06,0x05,0x36,0x01,0x57,0x2e,0x27,0xaf,0xdd,
+  0xf5,0xf5,0x1a,0x6f,0x26,0x43,0xee,0x09,0xf1,0xa8,0x33,0xe9,0x9e,0xf5,0x4a,0x8d,
+  0xf7,0xbb,0x30,0x45,0x16,0x87,0x32,0x60,0x8f,0x7a,0xe7,0x3d,0x7e,0xc6,0xeb,0x4c,
+  0xb1,0x31,0x5c,0x05,0x0b,0x54,0xdc,0x0d,0xfc,0x22,0xcd,0x20,0xef,0x34,0xe5,0x63,
+  0x38,0xa8,0x82,0xb7,0xd2,0xbb,0xc9,0xbe,0xa5,0x6a,0xcf,0x0f,0x54,0x7b,0x5e,0xa7,
+  0x5a,0x4d,0x00,0xae,0x3e,0x8f,0x03,0x44,0x29,0x0f,0xa6,0x62,0x55,0x35,0xf1,0x25,
+  0x99,0x38,0x9b,0xf3,0x30,0x5c,0xed,0x39,0xfd,0xa1,0xda,0xd7,0xc3,0xb6,0x06,0xf5,
+  0x61,0x5b,0x27,0x0f,0x42,0xd5,0xd1,0x30,0x90,0x0b,0xe6,0x87,0x3c,0xcb,0x3c,0x02,
+  0x3a,0x24,0x96,0xde,0x36,0x1d,0xb0,0x17,0x20,0x9a,0xc6,0x61,0x28,0x52,0x6c,0xea,
+  0xe9,0xc5,0x32,0xf0,0x1a,0x3c,0xf9,0x99,0x47,0x91,0x48,0x1b,0x66,0x6b,0x83,0x42,
+  0xb1,0xc1,0x14,0x7d,0xaf,0x51,0x1a,0x81,0x0c,0xd6,0x18,0x3d,0xff,0xc8,0x88,0xfb,
+  0x3e,0x65,0xa6,0x08,0x28,0xc0,0xee,0xe3,0x22,0x65,0xc9,0x0c,0x93,0x2c,0x8f,0xd9,
+  0x70,0xbc,0x3d,0xef,0xf4,0x5a,0xe4,0x45,0x32,0x6c,0x8f,0x47,0x0c,0x82,0xb3,0x38,
+  0x11,0x11,0xcd,0xcf,0xf2,0x3c,0xe9,0xb7,0xdb,0xdd,0xa7,0x3d,0xb7,0x7b,0x79,0xe5,
+  0x9e,0xbb,0xdd,0xf6,0x52,0x4e,0xa4,0x5a,0x07,0x0a,0x5f,0x62,0x19,0x31,0xa4,0x41,
+  0x60,0x58,0x9c,0xde,0xba,0xc3,0x36,0xb8,0xac,0xca,0x45,0xa0,0x3b,0x1a,0x2a,0x2c,
+  0x1c,0xbd,0x03,0x27,0x48,0x6e,0x0a,0x8e,0x48,0x12,0xe2,0x0c,0x0a,0xd1,0x03,0xf8,
+  0xa1,0x57,0x55,0x36,0x93,0x60,0xa3,0x17,0xb3,0x38,0xce,0xc0,0xed,0x4c,0xb0,0x31,
+  0xc7,0x0f,0x1e,0xc9,0x39,0xcf,0x65,0x1c,0xb9,0xec,0x13,0xc6,0x7e,0x95,0x94,0x50,
+  0x98,0xc6,0x32,0x06,0x02,0xf1,0x92,0x45,0xf8,0x8f,0xd8,0xc9,0x18,0x86,0x86,0x62,
+  0x3e,0xe2,0xd1,0xfd,0xb0,0x8d,0x7f,0x95,0x32,0x18,0xcf,0x40,0x84,0x51,0xcc,0x40,
+  0x51,0x87,0x2c,0x03,0x4c,0xd4,0x63,0xc9,0xf6,0xcf,0x29,0x99,0x3b,0x12,0x59,0x06,
+  0xe6,0x13,0xec,0xd4,0xcb,0x00,0xc4,0x24,0xc4,0x62,0xac,0xa6,0x49,0x0e,0xcc,0x6d,
+  0xa5,0x50,0x50,0xca,0xb6,0x50,0x4a,0x6b,0xf5,0x52,0x36,0x97,0x91,0xd7,0x65,0x40,
+  0x31,0xaf,0x77,0x71,0xc1,0x40,0xa7,0x10,0xde,0x55,0xe7,0x40,0xf0,0x0f,0x60,0x10,
+  0xce,0xc5,0xe2,0x22,0x27,0x52,0xa1,0x58,0x88,0xd0,0x65,0x6f,0xe3,0xa5,0x48,0x99,
+  0x9c,0x68,0x4b,0x7e,0xbc,0xfe,0x8d,0x4d,0x45,0x9e,0xb1,0x25,0x4f,0xe7,0xa5,0x28,
+  0x1b,0x81,0x4a,0x09,0x5e,0x8a,0x28,0x43,0xbe,0x60,0x6d,0xf6,0x86,0x12,0x8f,0xfa,
+  0x5d,0x27,0x4a,0xa0,0xe7,0x1e,0x24,0x8b,0x59,0xab,0x84,0xe9,0x28,0x61,0x90,0x41,
+  0x8c,0x30,0x67,0x17,0x07,0xc2,0xfc,0x02,0x93,0xcc,0x61,0x06,0x16,0x92,0x0a,0x60,
+  0x80,0x14,0x76,0xf0,0x73,0xb9,0xc0,0x3f,0x39,0xcc,0xe4,0x0b,0xe0,0x3a,0xc5,0x59,
+  0x20,0xe0,0x78,0x20,0x9e,0x37,0x77,0xc5,0xf9,0x9e,0x95,0xae,0x13,0x21,0x82,0x5a,
+  0xa9,0x32,0x9a,0x79,0x90,0x4c,0x6a,0x65,0xc5,0x3c,0x5b,0x89,0x2e,0x0e,0xcd,0xf3,
+  0xbc,0xf4,0x43,0x46,0x49,0x27,0x3e,0xaa,0xfc,0x5f,0x0a,0x51,0xcb,0xd6,0xac,0x10,
+  0x0f,0x62,0x0a,0xeb,0x2a,0x4a,0xde,0x7a,0xcc,0xf9,0xa1,0x92,0x7f,0xa6,0xf8,0x50,
+  0xe0,0x33,0x60,0x22,0xe2,0x63,0xc4,0x45,0x90,0xca,0x49,0xce,0x26,0x71,0xca,0xb2,
+  0x62,0x8c,0xea,0x12,0x8e,0x02,0xed,0xa6,0xc0,0xcf,0x7f,0x52,0xbd,0x3c,0x2f,0x52,
+  0x2d,0x6e,0xad,0x8e,0xf9,0xc3,0x22,0x00,0xeb,0x6a,0x85,0xe9,0x75,0x0e,0x15,0xfc,
+  0x82,0x04,0x61,0x49,0x91,0xc2,0xcd,0x4a,0xbf,0x27,0x41,0x12,0x8e,0xda,0x31,0x64,
+  0x93,0x12,0xb8,0x8e,0x6a,0xfe,0xad,0x9c,0x08,0xc5,0x6b,0x1d,0xc7,0x21,0x26,0x1f,
+  0xc4,0x32,0x2d,0x7c,0xa8,0x4f,0x90,0x97,0x87,0x71,0x34,0x65,0x82,0xfb,0x33,0xc3,
+  0x21,0xb9,0xfc,0x02,0x5c,0x1a,0x09,0x3c,0xf6,0x67,0x21,0xfd,0x5b,0xfc,0x1a,0x87,
+  0x32,0xba,0xad,0xb3,0x82,0x81,0x9d,0x4d,0x3e,0x62,0xaf,0x79,0x50,0xef,0x43,0x13,
+  0x1e,0x3c,0x4c,0x08,0x5a,0xa8,0x84,0x80,0xa2,0x8d,0xea,0x4b,0x31,0x7a,0xe7,0xf5,
+  0x72,0x4c,0xa0,0x66,0x85,0xba,0xcb,0x59,0x0c,0xbf,0xc9,0x90,0xc4,0xe1,0x5c,0xa1,
+  0xe0,0x69,0x46,0xc0,0x3f,0x0e,0xc1,0xdf,0x56,0x28,0x5a,0x2d,0xd2,0x2a,0x98,0xee,
+  0xe5,0xa3,0x6f,0x15,0x05,0x95,0x4c,0xae,0x0a,0x11,0x64,0xf3,0xc6,0x8e,0x1c,0xa8,
+  0x31,0xfc,0x5b,0xd4,0xe2,0x0a,0x78,0x94,0x47,0xab,0x11,0x51,0xa6,0x16,0xf2,0x0b,
+  0x33,0x61,0x8e,0x2d,0x4b,0x15,0xa4,0x40,0x74,0x08,0x8c,0x82,0x48,0xcd,0x6f,0xb4,
+  0xa4,0x19,0x35,0x69,0x43,0x8b,0x8e,0x72,0x8d,0x0e,0x48,0x55,0x46,0xf9,0x39,0x8f,
+  0x46,0x2f,0x52,0x81,0x5a,0xd2,0xa4,0x18,0x64,0x3c,0xb5,0xf8,0x40,0x59,0x9f,0x80,
+  0xea,0x53,0x91,0xaa,0xa4,0x22,0xee,0x60,0x0a,0xaa,0x4e,0x10,0x67,0x80,0x36,0x93,
+  0x63,0x28,0x0d,0x41,0x2e,0x16,0x4f,0x94,0x42,0x51,0xa6,0xa4,0x10,0x5e,0x25,0xa3,
+  0xfa,0x8c,0xb9,0x2b,0x85,0x2e,0xce,0x2e,0x95,0x52,0x66,0x67,0xfb,0x12,0xa2,0xac,
+  0x56,0xfa,0x7a,0x4b,0x58,0x9a,0xa4,0x82,0x9a,0x51,0x14,0x0c,0x67,0xa3,0xa1,0xcf,
+  0xa3,0x05,0x72,0x1d,0x44,0x4a,0x16,0x2f,0xf4,0x6f,0xdd,0x97,0x5e,0xc1,0x09,0x74,
+  0x31,0xe4,0x9d,0x5f,0x95,0xf4,0xb6,0x6d,0xc0,0x6e,0x81,0xd6,0xe9,0xd4,0xd4,0xa1,
+  0x80,0xbe,0xa9,0x38,0x4d,0x85,0xc1,0x92,0x7e,0x22,0xef,0x04,0xd5,0xdd,0x01,0x58,
+  0x6c,0xeb,0x73,0x4b,0x3f,0xfe,0xa8,0x59,0x62,0x29,0xa9,0xb2,0xce,0x89,0x93,0xc5,
+  0x83,0x5c,0x38,0x59,0x54,0x90,0xe3,0xac,0xf4,0xde,0xee,0xa1,0xf3,0xbe,0x4e,0xd1,
+  0x93,0x67,0x2c,0x81,0x5f,0xea,0xe2,0x1b,0x12,0xc2,0x90,0x68,0x1e,0xc8,0x6f,0xf3,
+  0x99,0xc4,0x1c,0xb8,0x67,0x76,0x07,0x7e,0x1b,0x4f,0x26,0x4d,0x97,0x7d,0xa0,0x1a,
+  0x26,0xa3,0xd2,0x81,0x62,0x92,0x4d,0x34,0x05,0xca,0x51,0x41,0x1a,0x27,0x89,0x08,
+  0x1c,0xd4,0x14,0x39,0x22,0x57,0x14,0x22,0x70,0x8f,0x40,0xe6,0x5f,0x35,0x9c,0xe2,
+  0x57,0xa9,0x47,0x9b,0x4d,0xeb,0xe0,0x13,0x56,0x89,0xbc,0x3e,0xea,0x93,0xec,0x61,
+  0x41,0x9f,0x64,0x1a,0xb8,0x4c,0x7e,0xee,0x75,0xc0,0x82,0x48,0xbc,0x12,0x74,0x2f,
+  0x8f,0xea,0x4e,0x1b,0x16,0x0a,0xdb,0x2a,0xd1,0x65,0x66,0x2e,0x9f,0x71,0xba,0xe8,
+  0x00,0xcb,0x71,0xa1,0x01,0x22,0x23,0xfe,0x79,0xa6,0x7e,0x87,0x84,0x1a,0x54,0x5d,
+  0x92,0xf2,0x48,0x67,0x19,0x79,0xba,0xd2,0xbb,0x20,0x3b,0xc8,0xc4,0x35,0x32,0x91,
+  0x49,0xd1,0xfe,0xbe,0x89,0x26,0xf1,0x56,0x9a,0x7f,0xa9,0x62,0x7f,0x97,0xa7,0xaf,
+  0xa5,0xd6,0xe9,0x9e,0x98,0xd7,0x14,0x9c,0xc4,0x91,0xa9,0x5b,0x33,0xaa,0xa6,0x58,
+  0x91,0x09,0x5d,0x53,0xea,0x7b,0x1b,0x04,0x0b,0xaa,0xaf,0x3c,0xbd,0xa7,0x95,0x73,
+  0x2a,0x53,0xc6,0xe8,0xaa,0x1c,0x86,0x82,0x97,0xb6,0xaa,0x98,0x60,0xd4,0x22,0x41,
+  0x4f,0xaa,0xee,0x2c,0x1d,0xa3,0x50,0x66,0x6a,0x50,0x99,0xfc,0x16,0xd3,0x9b,0x3a,
+  0x7d,0xdb,0x59,0x35,0x6a,0xc4,0xd1,0xa0,0xd7,0x2e,0xc2,0x6f,0xa6,0xe1,0xeb,0x37,
+  0x2f,0xf7,0x6c,0x4e,0x47,0x45,0xcb,0xeb,0x4c,0x06,0x0d,0x06,0xa4,0xf5,0x05,0xe0,
+  0x1a,0x9c,0x79,0x8d,0xf7,0x5a,0x36,0x75,0x45,0xd5,0xa8,0x49,0x8f,0x1f,0x71,0x00,
+  0x16,0x04,0xb5,0xf4,0x68,0xb2,0xa1,0xfd,0xa9,0x91,0x98,0x85,0x7b,0xf4,0xcb,0xfd,
+  0x8d,0x6f,0xd6,0x10,0x3b,0x08,0xdb,0x20,0x88,0xdd,0x74,0xc4,0x0d,0xdd,0xce,0x04,
+  0x01,0x38,0x05,0x4e,0x07,0x41,0x69,0x8e,0x2d,0xd4,0xf2,0x23,0x1b,0x67,0xc8,0xac,
+  0x5e,0x43,0x75,0x22,0x7f,0x64,0xd4,0xb7,0x34,0x46,0xd7,0x39,0x4f,0x73,0xa6,0x9a,
+  0x18,0xf6,0x4b,0x9c,0x67,0x49,0x0c,0xb0,0xe7,0x47,0xb8,0x7a,0x00,0xdd,0xc6,0xe8,
+  0x03,0xb5,0x40,0xca,0x89,0x98,0xe9,0x8d,0x78,0x8d,0x3c,0x5a,0x0a,0xb8,0x09,0xa4,
+  0xc8,0x1a,0xc8,0x06,0xf7,0x08,0x88,0x85,0x08,0xb6,0xbe,0x85,0x76,0x64,0x2b,0xd1,
+  0x3e,0x3b,0x0d,0xd5,0x41,0x36,0x36,0x1e,0xf3,0x2e,0x9b,0xd6,0x79,0x07,0x7c,0x7d,
+  0x50,0xb9,0xf6,0xd9,0xd3,0x79,0x7d,0xd7,0x35,0xeb,0xd5,0x10,0x42,0x46,0xbc,0x26,
+  0x3f,0x2c,0x76,0xfa,0xca,0x6a,0x11,0x59,0xc8,0x30,0x20,0x38,0x94,0x73,0x6a,0xac,
+  0x72,0x39,0x17,0x00,0x45,0x6a,0x21,0x75,0x23,0xc6,0x55,0xde,0x72,0xa0,0xb5,0x9c,
+  0x05,0xa6,0x26,0x74,0x28,0xf1,0x50,0x7f,0x34,0x26,0x33,0x52,0x6f,0xe8,0xb2,0x97,
+  0x29,0x9f,0x52,0xe0,0xa7,0x42,0x45,0x8a,0xcb,0x3e,0x96,0x4b,0xae,0x81,0x2e,0x34,
+  0xf3,0xea,0xfa,0xe3,0x59,0xaf,0x6c,0x24,0x33,0x65,0xbe,0x30,0x8e,0x93,0x4a,0x6d,
+  0x7a,0x3c,0x10,0xa8,0x97,0xdc,0x38,0xee,0xb6,0xa5,0x44,0x88,0xbd,0xdb,0xeb,0x2a,
+  0x0f,0x9a,0x21,0xc3,0x73,0x4d,0xbf,0xa9,0x0e,0xa9,0x20,0x69,0x54,0xcc,0xc7,0xd4,
+  0x6c,0x69,0xba,0x88,0xfb,0x4a,0xb3,0x73,0x55,0x66,0xa0,0xce,0x61,0x02,0xdd,0x0b,
+  0x14,0xec,0x6a,0x1c,0xa7,0x7b,0x2d,0xfc,0x0a,0xdd,0x8b,0xa7,0x9b,0xc4,0xf6,0x5d,
+  0xba,0xf0,0xdb,0xc6,0x71,0x87,0x32,0xbb,0xb7,0x4e,0xd3,0x18,0x41,0x84,0x22,0xa7,
+  0xc4,0x46,0x39,0x51,0x39,0x7d,0x86,0x2c,0xf8,0x8f,0xbf,0xff,0x17,0x49,0x03,0x1e,
+  0x1c,0x46,0x0f,0x60,0x01,0x93,0xcd,0xa3,0x65,0xf5,0x8b,0x34,0xce,0x32,0x55,0x50,
+  0xca,0xa8,0x2e,0xff,0xec,0x48,0xf7,0xba,0x2c,0x3c,0xb5,0x78,0x97,0x26,0x05,0x75,
+  0xdc,0x8b,0x07,0xab,0x4f,0x8b,0xf9,0x20,0x01,0xaf,0x8d,0x50,0xaa,0x3e,0x25,0x2f,
+  0x9b,0xa4,0xf1,0x5c,0xa1,0xb5,0x2a,0x8c,0xe2,0x02,0xd5,0x10,0x8a,0x4f,0x9d,0xfa,
+  0xfd,0xa2,0xbe,0xc7,0xd4,0x12,0xfd,0x96,0x6d,0x0b,0xb5,0x2c,0x94,0x01,0x15,0x78,
+  0xd4,0x7d,0xa8,0xfa,0x41,0x11,0x39,0x56,0xa0,0x92,0x4d,0x23,0x9e,0xec,0xca,0x45,
+  0xf7,0xd4,0x8d,0xd1,0x31,0x9f,0xab,0x07,0x15,0x20,0xe3,0x1b,0x1c,0x64,0x42,0xca,
+  0xe0,0xc7,0xf7,0xf0,0x54,0x55,0xe8,0xb4,0x2d,0x1b,0xbd,0xa0,0x9f,0xfb,0xc8,0x83,
+  0xe4,0xa4,0xf7,0x6e,0xb3,0x91,0x61,0x5a,0x04,0x94,0xad,0x4c,0x0a,0xaa,0xe7,0x08,
+  0xc9,0x3c,0x50,0xe8,0x71,0x10,0xc3,0x07,0xa5,0x71,0x43,0x5f,0x41,0x32,0x6d,0xac,
+  0x11,0xa5,0xd5,0xcc,0xe0,0x8e,0x8a,0xf2,0x4c,0xbd,0x2c,0x81,0x43,0xc2,0x28,0xa1,
+  0xae,0x90,0xb7,0x99,0xb7,0xc0,0x4c,0xa8,0x72,0xb2,0x12,0x87,0x51,0xfb,0x4a,0x07,
+  0xd2,0x45,0xd3,0x92,0xca,0x8b,0x1d,0xbb,0xa1,0xa0,0xf0,0x51,0x58,0xe4,0x23,0x50,
+  0x84,0x34,0x7f,0x66,0x1e,0x58,0x1d,0x05,0xb1,0x5f,0xcc,0x61,0x3d,0x17,0x65,0xd4,
+  0xab,0x50,0xd0,0xcf,0x9f,0xef,0xdf,0x04,0xb6,0x0c,0x9a,0x83,0x13,0xbd,0x12,0x98,
+  0x93,0x0b,0x6f,0xb5,0x1e,0x9c,0x4c,0x44,0xee,0xcf,0x6c,0xab,0x8d,0x5e,0x87,0xcf,
+  0xa5,0xd5,0x74,0xc1,0x4c,0x64,0xa7,0xde,0x28,0x75,0xbf,0x64,0x71,0x64,0x37,0xcd,
+  0xc8,0x17,0x6f,0xb4,0x32,0x9b,0xc7,0xde,0xb1,0x13,0xac,0xf2,0x86,0xce,0x6a,0x0e,
+  0x98,0x9c,0xd8,0x3f,0x8c,0x9b,0x40,0x41,0xf4,0xcf,0xd1,0xe0,0x04,0x8f,0x5f,0xd8,
+  0x4f,0x3f,0xb1,0x2f,0x2e,0x4f,0x9a,0x2b,0x36,0x76,0x95,0x97,0xb8,0xa6,0x4b,0xf2,
+  0xac,0x71,0x18,0xfb,0xb7,0xd6,0x80,0xad,0x4f,0xd6,0x4d,0xd7,0xe7,0xc4,0x95,0xdd,
+  0xc4,0xa1,0x6b,0x30,0x1d,0x0a,0xdd,0x33,0x64,0xde,0xcd,0xe7,0x2d,0xcb,0x6a,0xe4,
+  0x38,0xc7,0x73,0xe2,0x58,0xef,0x9a,0x97,0x72,0xc7,0x49,0x8e,0x27,0x77,0xce,0x13,
+  0xdb,0x8e,0x1c,0x09,0xfa,0xd6,0x10,0x63,0xd4,0xdc,0xeb,0xa0,0xb4,0x5a,0xb2,0x65,
+  0x8d,0xac,0x56,0xd4,0xb2,0x86,0x6d,0x3d,0x33,0xc2,0x11,0x74,0xd9,0x67,0x5b,0x90,
+  0xea,0xe4,0xcf,0xcc,0xb6,0x88,0x28,0x06,0x25,0x49,0xfa,0xcb,0xa7,0x77,0x6f,0x3d,
+  0x22,0x3b,0x60,0x34,0x65,0x60,0xf8,0x70,0xf6,0x44,0x57,0x96,0x65,0x06,0xb2,0x4b,
+  0x97,0x00,0xc9,0x43,0x79,0x27,0x45,0xe4,0x2b,0xa6,0x8a,0x24,0xb0,0x9b,0x2b,0x75,
+  0xa8,0xb9,0x6e,0x23,0x79,0xc5,0x5d,0xfe,0xc2,0xbc,0x6f,0xa3,0x99,0xcd,0x84,0x12,
+  0x41,0xb3,0x58,0xde,0x68,0xd5,0x2c,0xdf,0xce,0x54,0xd7,0xab,0x1b,0xa0,0x9a,0xd5,
+  0xe5,0x78,0x75,0x2d,0x7a,0xca,0x9a,0x95,0x7a,0x74,0x87,0x26,0xaf,0x63,0x57,0x8f,
+  0x56,0xd7,0xd1,0x45,0x43,0xcd,0x42,0x33,0x5c,0x5d,0x49,0xe0,0x5b,0xb3,0xd2,0x0c,
+  0x57,0x57,0x26,0x8b,0x9a,0x75,0x6a,0x70,0x87,0x5e,0x92,0xd5,0x91,0x53,0xa3,0x66,
+  0xdd,0xda,0xb8,0xce,0xeb,0x37,0xaf,0xde,0xbe,0xbc,0xf6,0x56,0xea,0x56,0xb9,0xe3,
+  0x68,0xa5,0xf7,0xbb,0x8e,0x51,0x67,0xbf,0xe7,0x28,0x55,0xf5,0xcf,0x1c,0x28,0xa2,
+  0x7f,0xee,0x40,0xcc,0xfe,0x85,0x43,0x32,0xf4,0x2f,0x1d,0x62,0xb0,0xff,0xc4,0x51,
+  0x8d,0x78,0xff,0xca,0xd1,0x8d,0x76,0xff,0xa9,0x93,0x2c,0x80,0xfb,0x0e,0xce,0xeb,
+  0x77,0xbb,0x6b,0xed,0xe7,0xcb,0x0c,0x79,0x24,0x0c,0x1d,0x16,0xc8,0x34,0xbf,0x47,
+  0x8c,0x3a,0x6c,0x12,0x16,0xd9,0xec,0xdf,0x55,0x0b,0xe6,0x4d,0x78,0x98,0x89,0x8a,
+  0x87,0x2c,0x33,0x2a,0xd6,0xc8,0x49,0x68,0x23,0x30,0xe2,0x77,0x31,0xbe,0x46,0x24,
+  0x89,0xdc,0xb6,0x96,0x59,0xbf,0xdd,0xb6,0x5a,0x08,0x2c,0x7d,0x6d,0x3c,0x8b,0xb3,
+  0xbc,0x85,0x50,0xcf,0x28,0x3c,0x97,0x99,0x3b,0x96,0x11,0xc0,0xf3,0x13,0xc1,0xb8,
+  0xc5,0xd3,0x94,0xdf,0x8f,0x8b,0xc9,0x04,0xc1,0x3b,0x00,0x2d,0x37,0x8e,0xfc,0x10,
+  0x55,0x8f,0xa7,0x9c,0xb2,0xe4,0x6a,0x40,0xc5,0xcf,0x27,0x14,0x46,0xe8,0x80,0x6c,
+  0x7d,0xb4,0x83,0xc4,0xd5,0x01,0xbd,0x35,0xa9,0xaa,0xe4,0xa6,0xc2,0xe0,0x44,0x8a,
+  0x30,0xf8,0x0f,0x1e,0x12,0xfc,0xac,0x0c,0x1a,0x10,0xa2,0x7a,0x9e,0xa5,0xd4,0x61,
+  0xb1,0x67,0xcc,0x56,0x7e,0xa9,0x9e,0x10,0x0b,0xfa,0x82,0xe3,0x59,0xb7,0xdf,0x69,
+  0xb2,0x3e,0x6b,0x61,0x0e,0x5b,0x8d,0x39,0x00,0x0f,0x1b,0xca,0xaa,0x29,0xfd,0xc8,
+  0xd1,0x9c,0x61,0x81,0xb3,0x80,0x0a,0x94,0xca,0x6e,0x64,0xf0,0xd9,0x5b,0x28,0xc0,
+  0xf9,0xa1,0xa2,0x39,0x1c,0x5e,0xd5,0x63,0x9e,0x12,0xb5,0x54,0x80,0x48,0x96,0x6f,
+  0x6e,0x34,0x55,0xa7,0x67,0xab,0x75,0x4d,0x05,0x45,0x15,0x39,0x68,0x90,0xf4,0x5c,
+  0x63,0x0d,0xed,0x21,0x32,0xc8,0xbc,0x0f,0xe3,0x2f,0x28,0xbe,0xdc,0x5b,0x71,0x9f,
+  0xd9,0x8a,0x1b,0x03,0x84,0x98,0x73,0x91,0x97,0xa7,0xf9,0x6c,0x07,0x11,0x97,0x19,
+  0x41,0x22,0xb4,0x8d,0x36,0x3d,0xb8,0xbf,0x56,0xa8,0xec,0x79,0x5d,0x9c,0xa2,0x26,
+  0x5d,0x6d,0x10,0x11,0x3c,0x9f,0xc7,0xc8,0x0c,0xa3,0xce,0x5f,0x10,0xc2,0x9c,0xc6,
+  0xd6,0xac,0xdd,0x66,0xb7,0x42,0x24,0x48,0x3f,0x3c,0x14,0x99,0x8f,0x6a,0x73,0x03,
+  0xe8,0xe4,0x38,0xbf,0xa1,0x06,0xbe,0x7a,0x4e,0x6e,0x60,0x6f,0xb9,0x7d,0xdc,0x83,
+  0x2d,0xe9,0x11,0x15,0xc0,0x2b,0x4e,0x18,0x05,0x55,0x4b,0xe5,0x12,0xe3,0x9b,0xde,
+  0x63,0xf9,0xd9,0xd3,0x71,0x41,0x4a,0x1f,0xe8,0xa1,0x56,0xf7,0xb3,0xb7,0x31,0x04,
+  0xce,0x6d,0x2a,0x77,0xa2,0x2c,0x66,0x8f,0x09,0xed,0x98,0x80,0xce,0x98,0x92,0x50,
+  0x2d,0x73,0x75,0x34,0xfc,0xe0,0x79,0x05,0x10,0x72,0x82,0x8a,0x5b,0xd9,0xca,0x80,
+  0xbc,0x9e,0x24,0x87,0x0d,0x50,0xd7,0xe6,0x82,0x55,0xf7,0x90,0x89,0x40,0xe6,0x50,
+  0xe9,0x1b,0x5d,0x97,0x64,0xe0,0xb6,0xcf,0x80,0xea,0x24,0xe6,0xaf,0x6f,0xaf,0x91,
+  0x59,0xfd,0x99,0xf2,0x9c,0x72,0x03,0x31,0x76,0x52,0x46,0x1c,0xfd,0xbe,0xd1,0x28,
+  0xef,0x94,0xe8,0xea,0x6c,0x70,0xd3,0x31,0x98,0xe8,0x28,0xc4,0x73,0x14,0x9e,0x39,
+  0x1a,0xac,0x1c,0x8d,0x44,0x8e,0xf1,0x65,0x87,0x00,0xc7,0x51,0x70,0xf2,0x79,0xa3,
+  0x40,0xca,0xd0,0x0a,0xd1,0xc9,0xa9,0x51,0xe8,0xbc,0x5a,0x00,0x76,0xa8,0xfe,0x10,
+  0xc8,0x17,0xb6,0x0e,0x0c,0x75,0xf4,0x33,0xcb,0x9f,0xd1,0x85,0x86,0xd5,0xb7,0x54,
+  0xbd,0x65,0x39,0x4c,0xc7,0xa2,0x4a,0x0a,0x83,0x3d,0xf7,0xdf,0x89,0xb3,0xa6,0x56,
+  0xfb,0xda,0xe4,0xab,0xcd,0xbd,0x9e,0x55,0x73,0xa2,0xe5,0x87,0x12,0x89,0xb7,0x24,
+  0x5e,0xa1,0x6a,0xf6,0x61,0xaa,0x63,0x08,0x6e,0x82,0x81,0xee,0x2f,0x7e,0x15,0x13,
+  0xf4,0x35,0x3a,0x24,0x8c,0x96,0x69,0xf8,0x78,0x42,0x4e,0x8c,0xe0,0x56,0x79,0xfb,
+  0xb1,0x07,0xbd,0xd6,0xfb,0x78,0xc9,0xac,0x56,0xe2,0x42,0x61,0x2d,0x8b,0xe1,0xaf,
+  0xa3,0x1e,0xb3,0x59,0xbc,0x8c,0xfe,0xd0,0x83,0x74,0xa9,0xe2,0xa8,0x32,0x8a,0x8d,
+  0x8b,0xec,0x5e,0xcd,0x07,0x45,0x7e,0xff,0x47,0xe2,0x03,0xda,0x7e,0x74,0xad,0xba,
+  0x74,0xba,0x3e,0xd9,0xe1,0x57,0x81,0x18,0xbd,0x0f,0x4a,0x81,0x29,0x76,0x65,0xca,
+  0x61,0x3d,0x85,0x65,0x0a,0x87,0x93,0xc5,0xc7,0xbb,0xfd,0xb8,0xe8,0xec,0xe8,0x60,
+  0x51,0x22,0xaf,0xa9,0xa9,0x1e,0x08,0xbf,0xe6,0xa6,0x92,0x5c,0xfa,0x5b,0x10,0x4c,
+  0x08,0x3c,0x47,0xdf,0xc8,0xa7,0xc2,0x13,0xde,0x28,0x59,0xe8,0xb0,0xde,0xe3,0x08,
+  0x05,0x14,0xcf,0x39,0xb9,0xef,0x2e,0x62,0x57,0x60,0x5a,0xf3,0xe9,0x18,0xd1,0xd6,
+  0x55,0x01,0x34,0xc9,0xf1,0x46,0x84,0xc8,0x1b,0xdf,0x74,0x3f,0x7f,0xb5,0x11,0xc7,
+  0x9f,0x87,0xc3,0xab,0xa6,0xc2,0x28,0x52,0x84,0x89,0x27,0xc4,0x68,0xf4,0xf8,0xac,
+  0x59,0xab,0x1b,0x9a,0x50,0xeb,0xc7,0x37,0x9d,0xcf,0x3f,0x75,0xf5,0x22,0x77,0x22,
+  0xc3,0xd0,0x2e,0x55,0x1a,0x7b,0x67,0x0e,0x93,0x5e,0x07,0x80,0x30,0x93,0xa8,0x81,
+  0xe2,0xe1,0xd8,0x10,0x26,0x14,0x94,0xc3,0x08,0x8c,0xd0,0xba,0x85,0xd7,0x41,0x97,
+  0x3d,0xa3,0xbf,0xfe,0xe0,0x24,0x88,0x57,0xcc,0x07,0x63,0x71,0xab,0x05,0x38,0x59,
+  0xb4,0x3c,0xdb,0xff,0xa9,0x73,0xf7,0x64,0xd2,0x7c,0xfc,0x8e,0xe7,0x33,0x37,0x89,
+  0x97,0x36,0x72,0x2f,0x41,0x5d,0x36,0x6b,0x79,0x4f,0xe0,0xa9,0x9a,0x3a,0xad,0xba,
+  0xea,0x34,0xb7,0xa5,0x9f,0xb7,0xf8,0xf1,0xdc,0x61,0x69,0x11,0x79,0x6a,0xe3,0x04,
+  0x5e,0x94,0xda,0x8b,0xf6,0xb9,0x66,0x1b,0xf3,0x9e,0x47,0x00,0x2b,0x5b,0x1e,0xd6,
+  0x10,0xb4,0x28,0xa0,0x2a,0xa7,0x00,0xca,0x5a,0x24,0xa8,0xd6,0x46,0xf5,0x5a,0x8c,
+  0x95,0xbd,0xec,0xd8,0x89,0x5b,0x58,0x0f,0xe9,0x21,0x1b,0xe9,0x80,0xc5,0x8a,0xc0,
+  0xe3,0xb3,0xc1,0x3e,0xa9,0x15,0xf5,0x51,0x36,0x49,0x78,0x0b,0x25,0xdc,0x0e,0x69,
+  0xee,0xb6,0xd5,0x72,0x64,0xab,0xd5,0x3c,0x4a,0x7b,0x87,0xee,0x99,0x4e,0x4a,0xc9,
+  0xe2,0x65,0xca,0x97,0x76,0xb4,0x6f,0x4f,0x33,0x5a,0x9a,0xd3,0x8f,0xc3,0x4c,0xcb,
+  0x8a,0x3e,0xd4,0x56,0x99,0xba,0xf9,0xf5,0x6b,0x17,0x3a,0x88,0x97,0x66,0xc2,0x17,
+  0x32,0xb4,0xa3,0x36,0xad,0xd4,0x53,0x72,0x3e,0x55,0x96,0x7d,0x43,0xf7,0xdc,0x2f,
+  0xe1,0x5b,0x36,0xcd,0x39,0xb4,0x83,0x9c,0xdf,0xf0,0x4f,0x46,0x84,0xbd,0x06,0xc4,
+  0xf9,0x8a,0xf6,0x28,0x37,0xbc,0x39,0xa7,0x84,0x40,0x82,0xdc,0x9c,0xe1,0xd7,0x60,
+  0x67,0x82,0xd2,0x42,0x39,0x85,0xdf,0x7b,0x93,0xbd,0xca,0x64,0x6f,0x7f,0xf2,0xec,
+  0x33,0xbd,0x30,0x23,0xd1,0x8d,0x5c,0x0b,0x53,0xcd,0xe9,0xbb,0x7d,0x0b,0x1a,0x9a,
+  0x7a,0xfe,0x82,0xba,0x11,0x85,0x25,0x77,0x08,0xbe,0x5e,0x40,0xd5,0x3a,0x06,0xf5,
+  0xc5,0x3f,0x09,0x31,0xc0,0x46,0xd7,0xdc,0xfe,0x93,0x3c,0xea,0x59,0x77,0x21,0x66,
+  0x54,0xeb,0x8a,0xdf,0xd9,0xbd,0x73,0x25,0xf1,0xe3,0xab,0x66,0xcb,0x4a,0xee,0x10,
+  0x8d,0x53,0x17,0x08,0xbc,0xd5,0x09,0xd8,0xa3,0x8f,0xa0,0x34,0xb6,0x2c,0xca,0x9a,
+  0x47,0x03,0xb3,0x61,0x92,0xfa,0x4b,0xcf,0xb4,0x04,0xba,0xc1,0xb4,0xaa,0xe8,0xb1,
+  0xd7,0x0e,0xa8,0x37,0x43,0xe4,0xfe,0x58,0x57,0x69,0x1d,0x2c,0x1c,0xad,0xa6,0x2a,
+  0xf9,0x37,0x77,0x64,0x70,0xd7,0xdc,0xb6,0x63,0xa1,0xdc,0xf6,0x63,0xbe,0x7a,0x6f,
+  0x63,0x5a,0x32,0xaa,0xa0,0xe9,0xcc,0x50,0xba,0xaa,0x33,0x7d,0x4f,0x5f,0xec,0x59,
+  0xdb,0xcf,0x56,0x2c,0x35,0x15,0xa4,0x7c,0x3a,0xa5,0x37,0xa6,0xba,0x9a,0x50,0x43,
+  0x10,0x11,0x9e,0xe8,0xe2,0x1c,0x34,0x94,0x77,0xa5,0x44,0xf3,0x39,0xf3,0x58,0x25,
+  0x74,0x64,0x6e,0xbe,0xf1,0xc9,0xda,0x97,0x1d,0xd8,0x20,0xcb,0x30,0xbf,0x1d,0xfc,
+  0xf1,0xb2,0xa3,0xa8,0x6d,0xa4,0xc1,0xac,0x55,0xbd,0x73,0x53,0x5f,0x99,0x98,0x4e,
+  0xd6,0x3a,0x69,0xed,0x4c,0x6e,0xbf,0x3c,0x41,0x33,0xa6,0x7a,0x3f,0xe2,0x9e,0x8e,
+  0xa4,0xdf,0x4d,0x46,0xed,0x59,0xdd,0x3e,0xd5,0x74,0xd3,0x16,0x7b,0x3e,0x1f,0x75,
+  0x9e,0xe1,0x6f,0xcb,0x9a,0x33,0xab,0xd9,0x47,0xf3,0xc6,0x5a,0xc4,0x22,0xd6,0x67,
+  0x16,0xfe,0x12,0xad,0x3b,0x4a,0xd7,0xcf,0x2c,0xf6,0xbf,0xff,0x83,0x44,0x52,0x3e,
+  0xb7,0xac,0x8c,0xa9,0x34,0x6e,0xf6,0xd0,0x42,0x5d,0x04,0x54,0x4b,0x14,0xbd,0x0b,
+  0x89,0xa9,0xbc,0x23,0x29,0x97,0xef,0x30,0xf6,0xcd,0x3b,0x8b,0xc3,0x6b,0x12,0xfa,
+  0x1c,0x80,0xb2,0xb1,0xd7,0x48,0xc5,0x3c,0x5e,0x08,0xba,0xcd,0xb0,0xc1,0x59,0x70,
+  0xd7,0xb2,0x9a,0x8d,0xd1,0xaf,0x6a,0x70,0x73,0xe7,0xa0,0xed,0x77,0x98,0xd0,0xc9,
+  0xa2,0xea,0x52,0x11,0x99,0x5b,0x2c,0x28,0xa9,0x8b,0x85,0xb2,0xe9,0xa7,0x94,0x47,
+  0x19,0xb2,0x0b,0xc1,0x8c,0x72,0x63,0x8b,0x62,0xa5,0x8d,0xfe,0x5b,0x46,0x58,0x4b,
+  0x6e,0xa5,0xf3,0xfc,0x51,0xb2,0xf4,0x5a,0xcf,0x50,0x05,0x4d,0xca,0x64,0x58,0xf2,
+  0x52,0x4c,0x78,0x11,0xe6,0x76,0xf3,0xf8,0xce,0x38,0x29,0x79,0x39,0xa9,0xd9,0x57,
+  0x3a,0x18,0xdd,0x59,0x79,0xad,0x7d,0x66,0xa7,0x35,0xcc,0x82,0x4f,0xbd,0x25,0x8f,
+  0xb5,0x87,0x02,0xa5,0xd5,0x6e,0xcf,0xcb,0xe3,0x6d,0x85,0xad,0xd7,0x70,0xaf,0x6c,
+  0xb6,0x6f,0x68,0x0d,0xd0,0xa5,0x7c,0x76,0xb3,0x04,0xea,0x16,0x6a,0xab,0xd3,0x6d,
+  0x1e,0x4e,0xe4,0x31,0xc2,0x9c,0x37,0xbf,0xdd,0xbd,0x0f,0x74,0xd4,0xf2,0x84,0xbe,
+  0xdf,0x78,0x81,0xdc,0x13,0xd8,0xa1,0x34,0x33,0x15,0x78,0xde,0x38,0xf1,0x7c,0xdb,
+  0x07,0xa9,0xeb,0x89,0x9b,0xf9,0x67,0xf6,0xf5,0x2b,0xb3,0x2d,0xf5,0x99,0x90,0xd5,
+  0x9a,0xab,0xd6,0x83,0x60,0xb6,0x3c,0x46,0x5d,0x7b,0x10,0x96,0x98,0x8b,0xb1,0xef,
+  0xd7,0x71,0x65,0xc8,0x22,0xe6,0x5a,0xbb,0xf7,0x12,0xa6,0xad,0x35,0xf3,0x32,0x2a,
+  0x63,0x9a,0x60,0x0f,0x09,0x77,0x93,0x2e,0xba,0x57,0x78,0xda,0xec,0x25,0x9d,0xeb,
+  0xad,0x5f,0xbf,0x76,0x9a,0xdb,0x7b,0x24,0xe1,0x1f,0xdb,0x7f,0xf1,0xd4,0x61,0x9b,
+  0xfd,0xd7,0xc2,0xdf,0xdb,0x4f,0xe2,0xe5,0x71,0xce,0x43,0xec,0xb7,0xb1,0xfe,0x31,
+  0x20,0xa4,0x05,0x72,0x64,0x4a,0x66,0xeb,0x99,0x21,0x43,0x19,0x51,0x2e,0xea,0x0e,
+  0xa8,0x81,0xc1,0x4a,0x39,0x2f,0xe6,0xac,0x9b,0x95,0x4d,0x57,0x6e,0x5a,0xf2,0xb9,
+  0x53,0xde,0xec,0xf6,0xf5,0x9e,0xf5,0xc6,0xad,0xe8,0x26,0xf6,0x08,0x97,0x97,0x15,
+  0x21,0x5f,0x57,0x6e,0x11,0x0c,0x97,0xc4,0x8b,0xda,0x3e,0x42,0x0d,0xcc,0x4a,0x84,
+  0x50,0x6f,0xfd,0x03,0xa1,0xa7,0x4b,0x09,0x23,0x9e,0x6c,0x9b,0xd7,0x26,0xbb,0xf9,
+  0xff,0x34,0x0e,0x7b,0xdd,0x02,0x0e,0x56,0x4d,0x6d,0xb5,0xc4,0xd7,0x81,0xba,0xf1,
+  0xd7,0x84,0x9a,0x53,0x99,0x7f,0xd7,0x53,0x97,0x32,0x0a,0xe2,0xa5,0xbb,0x85,0x17,
+  0xaf,0xf4,0x4f,0x5b,0xc2,0x2d,0xf7,0xfd,0x5f,0xaa,0xa8,0x38,0x4a,0x92,0x9a,0x7e,
+  0x92,0x7f,0x7b,0xf5,0xfa,0x80,0x0e,0xa3,0xea,0xd4,0xdf,0x22,0x6d,0x9a,0x97,0xcd,
+  0xcd,0xeb,0x03,0x9c,0x7e,0xd3,0xed,0x19,0x32,0x98,0x58,0xcd,0x45,0x3e,0x8b,0x83,
+  0xbe,0xf5,0xf1,0xc3,0xf5,0x27,0x3c,0xd3,0x47,0x88,0x40,0xeb,0xfe,0xca,0x32,0x6d,
+  0xc7,0x29,0x15,0xdf,0x00,0x6f,0xfa,0x3c,0x5b,0xea,0x4a,0xbd,0x4d,0x6d,0x8b,0xb5,
+  0x76,0x18,0x7d,0xab,0xd8,0x67,0xff,0x76,0xfd,0xe1,0xbd,0x4b,0x6f,0x70,0xa3,0xa9,
+  0x9c,0xdc,0xdb,0x2b,0xfd,0x15,0x47,0x79,0xc6,0xba,0x59,0xb6,0x5a,0x95,0xdc,0xae,
+  0xda,0x89,0xdf,0xcd,0x6b,0xd0,0x6a,0x87,0xa4,0xde,0xdb,0x85,0xaa,0x18,0x38,0xd6,
+  0x26,0xa1,0xf4,0xdb,0x06,0x70,0x11,0x1e,0xbf,0x6c,0x2d,0x5f,0xb3,0x12,0x1a,0x16,
+  0xe1,0x5e,0xd5,0x00,0x2a,0xd5,0x9a,0x41,0xcc,0x75,0xd7,0xfe,0xaf,0xa9,0x19,0x8e,
+  0xa5,0xf4,0x86,0xce,0xe9,0x8d,0x23,0x49,0xbd,0xb1,0xcd,0xea,0x0d,0xca,0xd1,0x44,
+  0xd0,0xcd,0x32,0x19,0xec,0xa5,0xf3,0xbf,0x9c,0x35,0x03,0x11,0xbe,0xa7,0xce,0x8b,
+  0x2e,0x71,0x6b,0xf3,0x25,0xd4,0x54,0x0f,0xd3,0x35,0x3d,0xe3,0xc6,0x9c,0x86,0xaa,
+  0xac,0xdc,0x4a,0x28,0x33,0x62,0xfc,0x99,0xa4,0x1b,0x63,0x63,0x38,0xda,0x7b,0x60,
+  0x7a,0x85,0xe5,0xc7,0xef,0xcb,0xd5,0x2b,0xe0,0x07,0xc3,0x79,0x76,0xdc,0x19,0xf4,
+  0x8b,0xf0,0x12,0xbe,0x5c,0x78,0xeb,0x7c,0x9b,0x58,0x93,0x6f,0xed,0xa3,0xb7,0xd9,
+  0xdb,0xbc,0x40,0x97,0x55,0x28,0x44,0xd9,0x37,0xbd,0xee,0x5d,0x36,0xdd,0xef,0xdd,
+  0x5f,0x51,0x3f,0x4d,0x1f,0x02,0xd1,0x8b,0x7a,0xb4,0xe1,0xdb,0x7b,0xa7,0x5d,0xdf,
+  0x87,0xa0,0x35,0x51,0xa9,0x02,0xad,0xee,0x76,0x66,0x45,0xee,0xd1,0xcf,0x1c,0xfa,
+  0xf6,0x2d,0xeb,0x27,0x14,0x6c,0x27,0x5b,0x6d,0x7f,0x83,0xcd,0x5d,0xb9,0x28,0x24,
+  0x0e,0xc3,0x72,0x7b,0x4b,0x72,0x94,0x8c,0x79,0xbb,0xfd,0xf0,0x84,0x9b,0x4d,0xbd,
+  0xef,0xab,0x6e,0x40,0xeb,0x76,0xf5,0xf7,0x29,0xbd,0xa7,0x8f,0xa7,0x76,0x5f,0xa0,
+  0xff,0xe3,0xef,0xff,0x6d,0x99,0xdb,0x88,0x38,0x44,0x2f,0xd7,0xd9,0x18,0x14,0x8f,
+  0xaa,0xcf,0xff,0xa7,0x5e,0xdf,0xd0,0x2b,0x18,0x97,0x98,0xa0,0x3b,0xa6,0x02,0xe9,
+  0x6a,0x75,0xc8,0xc7,0x0b,0xfd,0xb9,0xb4,0x08,0xfa,0xa8,0x44,0xbe,0xb8,0x32,0xa9,
+  0x5a,0x72,0x87,0x00,0xf2,0x1d,0xb5,0xed,0x8a,0xb3,0x51,0xaf,0x8e,0xd6,0xfb,0x78,
+  0xff,0x83,0x00,0xfa,0x2b,0x02,0x97,0x3d,0xff,0xc8,0x64,0x66,0x3e,0x83,0xdd,0x75,
+  0x16,0x1c,0xd1,0x6a,0x29,0x9a,0xc3,0x1e,0x52,0x6e,0xf5,0x1e,0x03,0x83,0x4e,0xf7,
+  0x42,0x5d,0x36,0xab,0x76,0xfa,0xe0,0xbc,0xeb,0xdc,0x7c,0xb7,0x42,0x9a,0xb4,0x89,
+  0x7d,0xe2,0x15,0x50,0xa0,0xf5,0xb8,0x1b,0xe4,0x87,0xdb,0xdf,0xc6,0x99,0xfe,0x3f,
+  0x32,0x81,0xaf,0x41,0xf5,0xa5,0xdc,0x9c,0xdf,0xb3,0x19,0x7d,0x38,0x93,0x2d,0x65,
+  0x4e,0x50,0xb8,0x11,0x88,0x78,0x57,0xd0,0x5f,0x75,0x71,0x30,0x60,0x55,0x20,0xa1,
+  0x56,0x84,0xef,0xb0,0xf2,0x2a,0x4d,0xe3,0xb4,0xe4,0x85,0xa4,0xd1,0x9c,0x94,0xc7,
+  0xad,0x55,0x9e,0xdf,0xf7,0xe6,0x61,0xdb,0xbc,0x0d,0x64,0xe5,0x3b,0x42,0xfd,0xad,
+  0x7d,0x5b,0xfd,0x7f,0xb7,0xfe,0x0f,0x7b,0x12,0x69,0xe4,0xd1,0x35,0x00,0x00,
+};
+
+// ui/wifi.html: 956 bytes raw, 878 minified, 562 gzipped
+static const uint8_t UI_WIFI_GZ[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x6d,0x53,0x4d,0x8f,0xd3,0x30,
+  0x10,0xfd,0x2b,0xc3,0x01,0xd2,0x48,0xf9,0xd8,0xe5,0x00,0xa8,0x75,0x22,0x81,0x96,
+  0x15,0x7b,0x81,0xd5,0x16,0xc4,0x11,0x39,0xf1,0xa4,0x99,0xd6,0xb1,0xad,0x78,0xd2,
+  0x6e,0x58,0xf5,0xbf,0xaf,0x93,0x14,0xd0,0x4a,0x5c,0xe2,0xf1,0xf8,0xcd,0x1b,0xbf,
+  0x97,0xb1,0x78,0xa5,0x6c,0xcd,0xa3,0x43,0x68,0xb9,0xd3,0xa5,0xb8,0x7c,0x51,0xaa,
+  0x52,0x74,0xc8,0x12,0x8c,0xec,0xb0,0x38,0x12,0x9e,0x9c,0xed,0x19,0x6a,0x6b,0x18,
+  0x0d,0x17,0xd1,0x89,0x14,0xb7,0x85,0xc2,0x23,0xd5,0x98,0xce,0x9b,0x84,0x0c,0x31,
+  0x49,0x9d,0xfa,0x5a,0x6a,0x2c,0xae,0xa3,0x52,0x30,0xb1,0xc6,0xf2,0x27,0xa5,0xb7,
+  0x04,0x5b,0xe4,0xc1,0x89,0x7c,0x49,0x81,0xf0,0x3c,0x86,0xb5,0xb2,0x6a,0x7c,0x6a,
+  0x02,0x67,0xda,0xc8,0x8e,0xf4,0xb8,0xf6,0xa3,0x67,0xec,0xd2,0x81,0x92,0x54,0x3a,
+  0xa7,0x31,0x5d,0x12,0xc9,0x16,0x77,0x16,0xe1,0xc7,0x5d,0xf2,0x60,0x2b,0xcb,0x36,
+  0xf9,0x82,0xfa,0x88,0x4c,0xb5,0x4c,0x3e,0xf6,0xa1,0xe7,0xc6,0x49,0xa5,0xc8,0xec,
+  0xd6,0xd7,0x1f,0xdc,0xe3,0x99,0x8c,0x1b,0x38,0xa9,0x06,0x66,0x6b,0x16,0x76,0x4f,
+  0xbf,0x71,0x7d,0xfd,0xce,0x3d,0xfe,0x03,0x5e,0x85,0x4d,0x27,0xfb,0x1d,0x99,0x75,
+  0xc8,0xc3,0xd5,0x66,0x16,0x11,0xf2,0x57,0xaf,0xcf,0x5a,0x56,0xa8,0x9f,0x14,0x79,
+  0xa7,0xe5,0xb8,0xae,0xb4,0xad,0x0f,0x17,0x6c,0xca,0xd6,0xcd,0xb5,0x67,0x91,0x2f,
+  0x12,0x44,0xbe,0x98,0x35,0x49,0x09,0xc6,0xbd,0x2d,0x6f,0xa9,0xc7,0x46,0x13,0x7a,
+  0x78,0x21,0x3c,0x9c,0x88,0xc6,0xf6,0x1d,0x04,0x57,0x5b,0xab,0x8a,0xe8,0xfe,0xdb,
+  0xf6,0x7b,0x04,0xb2,0x66,0xb2,0xa6,0x88,0xf2,0x13,0x35,0xf4,0xcb,0xcb,0x23,0x06,
+  0xdf,0xe6,0xfe,0xe5,0x76,0x7b,0x77,0x23,0xf2,0x25,0x16,0xb3,0xa6,0xe5,0x67,0x44,
+  0xde,0x93,0x8a,0x80,0x54,0x31,0x05,0x10,0xee,0x58,0x63,0x6b,0xb5,0xc2,0xbe,0x88,
+  0xbe,0x22,0x9f,0x6c,0x7f,0x98,0x81,0x7f,0x89,0xee,0xa5,0xf7,0x21,0xab,0xfe,0x4b,
+  0xe6,0xc2,0x61,0x04,0xd3,0x04,0x2c,0xf1,0x04,0x8c,0x5e,0x92,0xfe,0xa9,0x87,0x55,
+  0xa5,0xa5,0x39,0xc0,0x01,0xd1,0x79,0xe0,0x16,0x61,0xba,0xaf,0x02,0x6b,0x30,0x0e,
+  0xcd,0x16,0xc3,0x2f,0x54,0x7e,0xa8,0x3a,0xe2,0xa8,0xdc,0x06,0x04,0xbc,0x91,0x9d,
+  0xdb,0xc0,0x03,0x56,0xd6,0xb2,0xc8,0x17,0x5c,0x30,0x6e,0xb2,0xa3,0x14,0x0e,0x66,
+  0x23,0x8b,0xc8,0x3a,0x59,0x13,0x8f,0xeb,0xec,0x7d,0x54,0xde,0xcc,0x83,0x05,0x27,
+  0xd2,0x1a,0xfa,0xb9,0x0e,0xa4,0x51,0xc0,0xfd,0x08,0x6c,0x61,0x6f,0xc9,0xcc,0xfd,
+  0xcd,0x45,0xee,0x68,0x07,0x08,0x63,0x89,0x3d,0xaa,0x4c,0xe4,0x6e,0x9a,0xaf,0xba,
+  0x27,0xc7,0x65,0x83,0x5c,0xb7,0xab,0xe0,0x6e,0x6b,0xc3,0x80,0x45,0x71,0x16,0xaa,
+  0xcc,0xaa,0x2f,0xca,0x3e,0xdb,0x7b,0x6b,0x56,0xf1,0x25,0xb3,0x2f,0xca,0x27,0xa0,
+  0x66,0xb5,0xcf,0x26,0x4f,0x63,0x08,0x8f,0x62,0xe8,0x02,0x63,0xb6,0x43,0xfe,0xac,
+  0x71,0x0a,0x3f,0x8d,0x77,0x6a,0xb5,0x78,0x1f,0x67,0x47,0xa9,0x07,0x2c,0x16,0xf4,
+  0x06,0xce,0x71,0x56,0xcb,0xa9,0xd1,0x2a,0x0e,0x3c,0xe7,0x78,0x13,0x86,0x63,0xe9,
+  0x0f,0x41,0xee,0x3c,0x18,0xf9,0xfc,0xb0,0x9e,0x01,0xe7,0x7f,0x6c,0x17,0x6e,0x03,
+  0x00,0x00,
+};
+
+static const UiAsset kUiAssets[] = {
+  { "/", "text/html; charset=utf-8", UI_INDEX_GZ, 5199, 15478, "\"04e8ddffec90b29d\"" },
+  { "/wifi", "text/html; charset=utf-8", UI_WIFI_GZ, 562, 956, "\"7ddb15d77a8cf79a\"" },
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include <stdint.h>
+
+#define WIFI_AP_SSID "Fireflies-Setup"
+#define WIFI_AP_PASS ""   // open AP
+
+// Saved networks as plain data, so the web task can publish edits through a
+// SeqLock like the other web-side state.
+#define MAX_WIFI_NETS 10
+struct WifiNet  { char ssid[33]; char pass[65]; };
+struct WifiList { WifiNet net[MAX_WIFI_NETS]; uint8_t count; };
+
+// Last good access point, for reconnecting without a scan.
+struct WifiFast { char ssid[33]; uint8_t bssid[6]; uint8_t channel; };
+
+struct WifiSeen { char ssid[33]; int8_t rssi; uint8_t bssid[6]; uint8_t channel; };
+
+enum WifiLink : uint8_t { WL_LINK_IDLE, WL_LINK_CONNECTING, WL_LINK_UP, WL_LINK_FAILED };
+
+// What the manager needs from the radio. Every call returns immediately;
+// results are picked up on later ticks. WiFi.h on the device, a scripted
+// mock on the host.
+class WifiDriver {
+public:
+  virtual void staMode(bool keepAp) = 0;
+  virtual void scanStart() = 0;
+  virtual int  scanResults(WifiSeen* out, int max) = 0;  // -1 still scanning
+  virtual void connect(const char* ssid, const char* pass, const uint8_t* bssid, uint8_t channel) = 0;
+  virtual WifiLink link() = 0;
+  virtual void disconnect() = 0;
+  virtual void startAP() = 0;
+  virtual int  apClients() = 0;
+};
+
+// Connection state machine, ticked from loop(); nothing in it waits.
+//   boot -> FAST (cached BSSID/channel, no scan) -> SCAN -> CONNECT each
+//   saved network seen, strongest first -> UP, or AP when none works.
+// A dropped link retries the same AP, then rescans. While in AP mode with
+// nobody connected to it, the saved networks are rescanned periodically.
+#define WIFI_FAST_MS     3000
+#define WIFI_SCAN_MS     8000    // give up on a scan that never completes
+#define WIFI_CONNECT_MS  8000    // per candidate; auth failures end it sooner
+#define WIFI_AP_RETRY_MS 120000
+
+enum WifiState : uint8_t { WS_IDLE, WS_FAST, WS_SCAN, WS_CONNECT, WS_UP, WS_AP };
+
+class WifiManager {
+public:
+  explicit WifiManager(WifiDriver& d) : mDrv(d) {}
+
+  void begin(const WifiList& nets, const WifiFast* fast, uint32_t now);
+  void setNetworks(const WifiList& nets) { mNets = nets; }
+  void retry(uint32_t now);   // walk the saved networks again (scan first)
+  void tick(uint32_t now);
+
+  WifiState state() const { return mState; }
+  bool up() const { return mState == WS_UP; }
+  // Set on every new connection; the caller persists it and clears the flag.
+  bool fastChanged = false;
+  const WifiFast& fast() const { return mFast; }
+
+private:
+  void enter(WifiState s, uint32_t now);
+  void connectNext(uint32_t now);
+
+  WifiDriver& mDrv;
+  WifiList mNets = {};
+  WifiFast mFast = {};
+  WifiState mState = WS_IDLE;
+  uint32_t mSince = 0;
+  // scan candidates: index into mNets plus the AP that was strongest for it
+  struct Cand { uint8_t net; uint8_t bssid[6]; uint8_t channel; int8_t rssi; };
+  Cand mCand[MAX_WIFI_NETS];
+  uint8_t mCandCount = 0, mCandNext = 0;
+  uint8_t mCur = 0xFF;   // net being joined / joined
+};
+
+#ifdef ARDUINO
+WifiDriver& wifiRadio();   // the ESP32 station/AP, event driven
+#endif
@@ -0,0 +1,54 @@
+#include <string.h>
+#include "accum.h"
+#include "power.h"
+
+// Two 16-bit lanes times an 8-bit scale, floor(v * s / 256) each: the high
+// bytes times s fit their lane (255 * 255), the low bytes' share is under 1.
+static inline uint32_t scale16x2(uint32_t w, uint32_t s){
+  const uint32_t kEven = 0x00FF00FFu;
+  return ((w >> 8) & kEven) * s + ((((w & kEven) * s) >> 8) & kEven);
+}
+
+// A run is 96 channels, so every run starts word aligned.
+void accFade(uint16_t* acc, const LitSet& lit, uint16_t n, uint8_t scale){
+  for (uint16_t k = 0; k < LitSet::kWords && (k << 5) < n; k++){
+    if (!lit.w[k]) continue;
+    uint16_t i = k << 5, c = (n - i < 32 ? n - i : 32) * 3;
+    uint16_t* p = (uint16_t*)__builtin_assume_aligned(acc + i * 3, 4);
+    uint16_t j = 0;
+    for (; j + 2 <= c; j += 2){ uint32_t w; memcpy(&w, p + j, 4); w = scale16x2(w, scale); memcpy(p + j, &w, 4); }
+    if (j < c) p[j] = (uint16_t)((p[j] * scale) >> 8);
+  }
+}
+
+void accOut(uint16_t* acc, CRGB* px, LitSet& lit, uint32_t f){
+  PowerWalk sum;
+  const uint8_t phase = (uint8_t)(f << 6);
+  for (uint16_t k = 0; k < LitSet::kWords; k++){
+    uint32_t m = lit.w[k];
+    if (!m) continue;
+    uint32_t keep = m;
+    do {
+      uint8_t b = __builtin_ctz(m); m &= m - 1;
+      uint16_t i = (k << 5) + b;
+      uint16_t* a = acc + i * 3;
+      CRGB& c = px[i];
+      if (a[0] < ACC_SNAP && a[1] < ACC_SNAP && a[2] < ACC_SNAP){ a[0] = a[1] = a[2] = 0; c = CRGB::Black; keep &= ~(1UL << b); continue; }
+      uint8_t d = (uint8_t)(i * 0x9D) + phase;
+      for (uint8_t ch = 0; ch < 3; ch++){ uint32_t v = (a[ch] + d) >> 8; c.raw[ch] = v > 255 ? 255 : (uint8_t)v; }
+      sum.add(i, c);
+    } while (m);
+    lit.w[k] = keep;
+  }
+}
+
+void accLoad(uint16_t* acc, const CRGB* px, const LitSet& lit, uint16_t n){
+  memset(acc, 0, n * 3 * sizeof(uint16_t));
+  for (uint16_t k = 0; k < LitSet::kWords; k++){
+    for (uint32_t m = lit.w[k]; m; m &= m - 1){
+      uint16_t i = (k << 5) + __builtin_ctz(m);
+      if (i >= n) break;
+      for (uint8_t ch = 0; ch < 3; ch++) acc[i * 3 + ch] = px[i].raw[ch] * 257;
+    }
+  }
+}
@@ -0,0 +1,188 @@
+#include <Arduino.h>
+#include <string.h>
+#include "compositor.h"
+#include "metrics.h"
+#include "params.h"
+#include "power.h"
+
+Compositor gComp;
+
+// ---- Blend kernels ----
+// Each op takes four channel bytes per word and keeps every byte in its own
+// lane: no carry or borrow crosses into the next channel.
+static const uint32_t kHi = 0x80808080u, kLo = 0x7F7F7F7Fu, kEven = 0x00FF00FFu;
+
+// Low seven bits add without leaving the lane; bit 7 is added by xor, and the
+// lanes that carried out of it become 0xFF.
+static inline uint32_t addSat(uint32_t a, uint32_t b){
+  uint32_t s = ((a & kLo) + (b & kLo)) ^ ((a ^ b) & kHi);
+  uint32_t c = ((a & b) | ((a | b) & ~s)) & kHi;
+  return s | ((c << 1) - (c >> 7));
+}
+// Two channels per 16-bit lane; 255 * 256 is the largest a lane holds.
+static inline uint32_t mix(uint32_t a, uint32_t b, uint32_t w){
+  const uint32_t v = 256 - w;
+  uint32_t e = (((a & kEven) * v + (b & kEven) * w) >> 8) & kEven;
+  uint32_t o = (((a >> 8) & kEven) * v + ((b >> 8) & kEven) * w) & ~kEven;
+  return e | o;
+}
+
+// dst[i] = f(a[i], b[i]) over n pixels, a word at a time. The tail goes
+// through the same op with the byte in the low lane.
+template <typename F> static inline void words(CRGB* dst, const CRGB* a, const CRGB* b, uint16_t n, F f){
+  uint8_t* d = (uint8_t*)__builtin_assume_aligned(dst, 4);
+  const uint8_t* x = (const uint8_t*)__builtin_assume_aligned(a, 4);
+  const uint8_t* y = (const uint8_t*)__builtin_assume_aligned(b, 4);
+  const uint32_t bytes = (uint32_t)n * 3;
+  uint32_t i = 0;
+  for (; i + 4 <= bytes; i += 4){
+    uint32_t u, v;
+    memcpy(&u, x + i, 4); memcpy(&v, y + i, 4);
+    u = f(u, v);
+    memcpy(d + i, &u, 4);
+  }
+  for (; i < bytes; i++) d[i] = (uint8_t)f(x[i], y[i]);
+}
+
+void blendAdd(CRGB* dst, const CRGB* src, uint16_t n){ words(dst, dst, src, n, addSat); }
+// A plain byte loop: compilers vectorize it where there is SIMD, and the
+// word trick (a compare per lane through the top bits) came out slower.
+void blendMax(CRGB* dst, const CRGB* src, uint16_t n){
+  uint8_t* d = (uint8_t*)dst;
+  const uint8_t* s = (const uint8_t*)src;
+  for (uint32_t i = 0; i < (uint32_t)n * 3; i++) d[i] = d[i] > s[i] ? d[i] : s[i];
+}
+void blendAlpha(CRGB* dst, const CRGB* a, const CRGB* b, uint16_t n, uint16_t w){
+  words(dst, a, b, n, [w](uint32_t u, uint32_t v){ return mix(u, v, w); });
+}
+
+// f over the 32-pixel runs with a lit pixel. A run is 24 words, so every
+// run starts word aligned.
+template <typename F> static inline void litRuns(CRGB* dst, const CRGB* src, const LitSet& lit, uint16_t n, F f){
+  for (uint16_t k = 0; k < LitSet::kWords && (k << 5) < n; k++){
+    if (!lit.w[k]) continue;
+    uint16_t i = k << 5;
+    f(dst + i, src + i, n - i < 32 ? n - i : 32);
+  }
+}
+
+void blendAddLit(CRGB* dst, const CRGB* src, const LitSet& lit, uint16_t n){
+  litRuns(dst, src, lit, n, [](CRGB* d, const CRGB* s, uint16_t c){ words(d, d, s, c, addSat); });
+}
+void blendMaxLit(CRGB* dst, const CRGB* src, const LitSet& lit, uint16_t n){
+  litRuns(dst, src, lit, n, blendMax);
+}
+
+// ---- Compositor ----
+void Compositor::reset(){
+  fill_solid(mIn.px, NUM_LEDS, CRGB::Black); mIn.lit.clear();
+  fill_solid(mRings.px, NUM_LEDS, CRGB::Black); mRings.lit.clear();
+  mOut = mNext = gMode;
+  mArm = mFadeMs = 0;
+  mRingsOn = false;
+  mFrame = 0; skipped = 0;
+  for (uint8_t l = 0; l < L_COUNT; l++){ mCost[l] = 0; mDiv[l] = 1; mDt[l] = 0; }
+}
+
+void Compositor::frame(CRGB* out, float dt){
+  const Params p = paramsLive();
+  const uint16_t n = gNumLeds;
+  if (mFadeMs && gFrameMs - mFadeStart >= mFadeMs) endFade();
+  if (gMode != (mFadeMs ? mNext : mOut)){
+    if (mFadeMs) endFade();
+    if (mArm){
+      mNext = gMode; mFadeMs = mArm; mFadeStart = gFrameMs;
+      fill_solid(mIn.px, NUM_LEDS, CRGB::Black); mIn.lit.clear();
+      gModes.enter(mNext, Pixels{ mIn.px, n, &mIn.lit });
+    } else { mOut = gMode; gModes.enter(mOut, Pixels{ leds, n, &gLit }); }
+  }
+  mArm = 0;
+  mFrame++;
+  const uint8_t shown = mFadeMs ? mNext : mOut;
+
+  // The rings draw first: the base mode then leaves the power sums exact for
+  // leds[], which is all a frame without blending needs.
+  const FrameTime t = { gFrameMs, gFrameMs / 1000.0f, dt };
+  gRipples.advance(p, dt, n);
+  if (!Modes::ripples(shown)){
+    if (mRingsOn){ fill_solid(mRings.px, NUM_LEDS, CRGB::Black); mRings.lit.clear(); mRingsOn = false; }
+  } else if ((mRingsOn || gRipples.any()) && draw(L_RINGS, 0xFF, Pixels{ mRings.px, n, &mRings.lit }, p, t))
+    mRingsOn = mRings.lit.any();
+
+  draw(L_BASE, mOut, Pixels{ leds, n, &gLit }, p, t);
+  if (mFadeMs) draw(L_FADE, mNext, Pixels{ mIn.px, n, &mIn.lit }, p, t);
+
+  uint32_t t0 = micros();
+  const CRGB* under = leds;
+  if (mFadeMs){
+    mIn.w = (uint16_t)(((gFrameMs - mFadeStart) << 8) / mFadeMs);
+    blend(out, under, mIn, n); under = out;
+  }
+  if (mRingsOn){ blend(out, under, mRings, n); under = out; }
+  if (under != out) memcpy(out, leds, n * sizeof(CRGB));
+  else powerScan(out, n);
+  measure(L_MIX, micros() - t0);
+  pace();
+}
+
+// Mode m (0xFF: the ring layer) into px, unless the layer sits this frame
+// out; then it keeps its last frame and the time is saved for the next draw.
+// Layers are phased apart so two at the same divisor take turns.
+bool Compositor::draw(uint8_t l, uint8_t m, Pixels px, const Params& p, FrameTime t){
+  mDt[l] += t.dt;
+  if ((mFrame + l) % mDiv[l]){ skipped++; MET_COUNT(throttled); return false; }
+  t.dt = mDt[l]; mDt[l] = 0;
+  uint32_t t0 = micros();
+  if (m == 0xFF) mRingFx.render(px, p, t);
+  else gModes.frame(m, px, p, t);
+  measure(l, micros() - t0);
+  return true;
+}
+
+// out = under (op) l. under is leds[] for the first layer over the base, out
+// after that; alpha reads it in place, add and max start from a copy.
+void Compositor::blend(CRGB* out, const CRGB* under, const Layer& l, uint16_t n){
+  if (l.mode == BLEND_ALPHA){ blendAlpha(out, under, l.px, n, l.w); return; }
+  if (under != out) memcpy(out, under, n * sizeof(CRGB));
+  if (l.mode == BLEND_ADD) blendAddLit(out, l.px, l.lit, n);
+  else blendMaxLit(out, l.px, l.lit, n);
+}
+
+// The incoming layer becomes the base.
+void Compositor::endFade(){
+  memcpy(leds, mIn.px, sizeof(mIn.px));
+  gLit = mIn.lit;
+  mOut = mNext;
+  mFadeMs = 0;
+  mCost[L_BASE] = mCost[L_FADE];
+  mDiv[L_BASE] = 1; mDt[L_BASE] = 0;
+}
+
+uint32_t Compositor::estimateUs() const {
+  uint32_t e = mCost[mFadeMs ? L_FADE : L_BASE] + mCost[L_MIX];
+  if (mFadeMs) e += mCost[L_BASE] / mDiv[L_BASE];
+  if (mRingsOn) e += mCost[L_RINGS] / mDiv[L_RINGS];
+  return e >> 4;
+}
+
+// Over budget: the next layer in line draws half as often. Under it, the
+// last one throttled is restored, but only if the frame would then still be
+// under 3/4 of the budget, so a layer does not flip between two rates.
+void Compositor::pace(){
+  if (!mBudget) return;
+  const uint8_t order[2] = { L_BASE, L_RINGS };
+  const bool live[2] = { mFadeMs != 0, mRingsOn };
+  const uint32_t est = estimateUs();
+  if (est > mBudget){
+    for (uint8_t i = 0; i < 2; i++)
+      if (live[i] && mDiv[order[i]] < COMP_MAX_DIV){ mDiv[order[i]] *= 2; return; }
+    return;
+  }
+  for (int8_t i = 1; i >= 0; i--){
+    uint8_t l = order[i];
+    if (mDiv[l] == 1) continue;
+    uint32_t c = mCost[l] >> 4;
+    if (est + c / (mDiv[l] / 2) - c / mDiv[l] < mBudget * 3 / 4) mDiv[l] /= 2;
+    return;
+  }
+}
@@ -0,0 +1,26 @@
+#include "ctrl_proto.h"
+#include "effects.h"
+
+CtrlResult ctrlDecode(const uint8_t* buf, size_t len, Params& p){
+  CtrlResult r = { 0, 0, (len & 1) == 0 };
+  for (size_t i = 0; i + 1 < len; i += 2){
+    uint8_t v = buf[i + 1];
+    switch (buf[i]){
+      case CF_MODE:    if (v >= MODE_COUNT){ r.ok = false; return r; } p.mode = v; break;
+      case CF_BRIGHT:  p.brightness = v; break;
+      case CF_DENSITY: p.density = v; break;
+      case CF_SPEED:   p.speed = v; break;
+      case CF_HUE:     p.hue = v; break;
+      case CF_SAT:     p.sat = v; break;
+      case CF_LIFE:    p.lifespan = v; break;
+      case CF_FADE:    p.fade = v; break;
+      case CF_DRIFT:   p.drift = v != 0; break;
+      case CF_PREVIEW: p.preview = v; break;
+      case CF_FPS:     p.fps = v; break;
+      case CF_RIPPLE:  r.ripples++; continue;
+      default:         r.ok = false; return r;
+    }
+    r.params++;
+  }
+  return r;
+}
@@ -0,0 +1,243 @@
+#include <Arduino.h>
+#include <FastLED.h>
+#include <math.h>
+#include "accum.h"
+#include "compositor.h"
+#include "effects.h"
+#include "litset.h"
+#include "palette.h"
+#include "params.h"
+#include "power.h"
+#include "rng.h"
+#include "pixmap.h"
+
+alignas(4) CRGB leds[NUM_LEDS];   // word aligned for the blend kernels
+uint16_t gNumLeds = NUM_LEDS;
+uint32_t gFrameMs = 0;
+
+Rng gRng[RNG_COUNT];
+void rngSeed(uint32_t seed){ for (uint8_t i = 0; i < RNG_COUNT; i++) gRng[i].seed(seed + i * 0x632BE5ABu); }
+
+// runtime params
+uint8_t gBrightness = 80;
+uint8_t gMode = 0;      // index into Modes
+uint8_t gDensity = 35;  // meaning varies by mode
+uint8_t gSpeed = 50;
+uint8_t gHueBase = 45;
+uint8_t gSaturation = 200;
+bool    gAutoHueDrift = true;
+
+// NEW: lifespan + background fade
+uint8_t gLifespan = 50; // 1–100; lower = shorter life (faster on/off)
+uint8_t gFade     = 240; // 200–250; lower = faster fade-to-black
+
+// ---------- FIREFLIES -----------
+void Fireflies::spawn(uint16_t n, const Params& p){
+  uint16_t s = mFree;
+  if (s == kNone) return;
+  mFree = mNext[s];
+  Rng& r = gRng[RNG_FLY];
+  mIdx[s] = r.below(n);
+  uint32_t rise = r.range(FLY_Q16(0.15), FLY_Q16(0.35)), hold = r.range(FLY_Q16(0.05), FLY_Q16(0.25));
+  flyEnvInit(mEnv[s], rise, hold, r.range(FLY_Q16(0.25), FLY_Q16(0.55)));
+  mHue[s] = p.drift ? (p.hue + r.below(12)) : p.hue;
+  mActive[mCount++] = s;
+}
+void Fireflies::reset(){
+  mCount = 0;
+  memset(mAcc, 0, sizeof(mAcc)); mTick = 0;
+  for(int i=0;i<MAX_FIREFLIES;i++) mNext[i] = i+1 < MAX_FIREFLIES ? i+1 : kNone;
+  mFree = 0;
+}
+
+void Fireflies::render(Pixels px, const Params& p, const FrameTime& t){
+  // spawn to target density: density% of one fly per 4 pixels (125 at 500 LEDs),
+  // with the per-frame spawn budget growing with the target on long strips
+  uint16_t cap = min<uint16_t>(MAX_FIREFLIES, px.n / 4);
+  uint16_t target = (uint32_t)p.density * cap / 100;
+  for(uint16_t s=0, budget=4+target/64; s<budget && mCount<target; s++) spawn(px.n, p);
+
+  // Background fade at 16 bits, so trails keep dimming below the last 8-bit
+  // steps instead of sticking there; embers under ACC_SNAP go black. Only
+  // runs with lit pixels are visited.
+  accFade(mAcc, *px.lit, px.n, p.fade);
+
+  // Lifespan scaler: lower lifespan => faster time progression. Folded into
+  // one Q16 step per frame; the per-fly loop below is integer only.
+  float lifeScale = 0.6f + 1.6f * (1.0f - (p.lifespan / 100.0f)); // 100 → slow/long, 1 → fast/short
+  float speedScalar = (0.08f + 0.6f*(p.speed/100.0f)) * lifeScale;
+  uint32_t step = (uint32_t)(t.dt * speedScalar * 65536.0f);
+
+  const CRGB* hue = palHue();
+  for (uint16_t k = 0; k < mCount; ){
+    uint16_t s = mActive[k];
+    uint8_t a;
+    if (!flyEnvStage(mEnv[s], step, a)){
+      mNext[s] = mFree; mFree = s;      // retire: push free, swap-remove
+      mActive[k] = mActive[--mCount];
+      continue;
+    }
+    accAdd(mAcc, *px.lit, mIdx[s], hue[mHue[s]], kFlyLevel16[a]);
+    k++;
+  }
+  accOut(mAcc, px.px, *px.lit, mTick++);
+}
+// Whatever the last mode left fades out from where it is.
+void Fireflies::enter(Pixels px){ accLoad(mAcc, px.px, *px.lit, px.n); }
+
+// ---------- SYNC / WAVE ----------
+// FastLED's beatsin8(bpm, 10, 255), on the frame clock instead of millis()
+void Sync::render(Pixels px, const Params& p, const FrameTime& t){
+  uint16_t bpm88 = (10 + p.speed/2) << 8;
+  uint8_t beat = 10 + scale8(sin8((uint16_t)((t.ms * bpm88 * 280) >> 16) >> 8), 245);
+  powerFill(px.px, px.n, palVal()[beat]); px.lit->markAll(px.n);
+}
+// With a pixel map the two sines run across x and y instead of the strip.
+void Wave::render(Pixels px, const Params& p, const FrameTime& t){
+  const CRGB* pal = palVal();
+  const float w1 = t.t*(2+p.speed/2), w2 = t.t*(1+p.speed/3);
+  if (mapActive()){
+    powerFillWith(px.px, px.n, [&](uint16_t i){
+      uint8_t b1=sin8((gMap.x[i]*2)+w1); uint8_t b2=sin8((gMap.y[i]*3)-w2);
+      return pal[qadd8(b1/2,b2/2)];
+    });
+  } else {
+    powerFillWith(px.px, px.n, [&](uint16_t i){
+      uint8_t b1=sin8((i*2)+w1); uint8_t b2=sin8((i*3)-w2);
+      return pal[qadd8(b1/2,b2/2)];
+    });
+  }
+  px.lit->markAll(px.n);
+}
+
+// ---------- TWINKLE --------------
+void Twinkle::render(Pixels px, const Params& p, const FrameTime&){
+  litFadeToBlackBy(px.px, *px.lit, 12);
+  Rng& r = gRng[RNG_TWINKLE];
+  if(r.u8() < p.density){ int i = r.below(px.n); uint8_t h = p.hue + r.below(18); powerAdd(px.px, *px.lit, i, palDim(palHue()[h], 160 + r.below(95))); }
+}
+
+// ---------- SWARM (Perlin) -------
+// Same field as inoise8(i*4, t*(10+speed)), sampled through the row cache:
+// exact rows every NOISE_KEY_STEP time units, interpolated in between. With
+// a pixel map, 3D noise at each pixel's position drifting along z instead.
+void Swarm::render(Pixels px, const Params& p, const FrameTime& t){
+  const CRGB* pal = palSwarm();
+  uint16_t y = (uint16_t)(uint32_t)(t.t* (10+p.speed));
+  if (mapActive()) mNoise.sampleMap(mN, gMap, 4, y);
+  else mNoise.sample(mN, px.n, 0, 4, y);
+  powerFillWith(px.px, px.n, [&](uint16_t i){ return pal[mN[i]]; });
+  px.lit->markAll(px.n);
+}
+
+// ---------- RIPPLES --------------
+// Each ring is the band radius-2 < d < radius on both sides of the center, so
+// it is drawn directly from its span: ~3 pixels per side, with the partial
+// coverage of the edge pixels used as an anti-aliasing weight.
+Ripples gRipples;
+void Ripples::trigger(int center, uint16_t n, uint8_t speed){ for(auto &r:ring) if(!r.on){ r.center=(center>=0 && center<n) ? center : gRng[RNG_RIPPLE].below(n); r.age=0; r.speed=0.9f+(speed/140.0f); r.on=true; break; } }
+void triggerRipple(int center){ gRipples.trigger(center, gNumLeds, gSpeed); }
+
+static inline void ringPixel(Pixels px, int i, const CRGB& c, uint8_t cover){
+  if (i < 0 || i >= px.n || !cover) return;
+  CRGB v = c; v.nscale8_video(cover);
+  powerAdd(px.px, *px.lit, i, v);
+}
+// Mapped: the ring is a spherical shell MAP_RING_UNITS thick around the
+// center pixel's position, brightest mid-shell. Distance from mid-shell is
+// taken as (d^2 - mid^2) / 2mid, so a pixel costs a few integer ops and no
+// square root, and only grid cells the shell passes through are visited.
+#define MAP_RING_UNITS 12
+#define MAP_RIPPLE_END 442   // corner to corner of the 256^3 map space
+static void ringShell(Pixels px, uint16_t center, float radius, const CRGB& c){
+  const float mid = radius - MAP_RING_UNITS / 2.0f;
+  const int32_t m2 = (int32_t)(mid * mid), band = (int32_t)(mid * MAP_RING_UNITS);  // weight 0 at |d^2 - m2| = band
+  if (band < 1) return;
+  const int32_t lo2 = m2 - band, hi2 = m2 + band, k = (255 << 16) / band;
+  const int cx = gMap.x[center], cy = gMap.y[center], cz = gMap.z[center];
+  const int R = (int)radius + 1;
+  auto cells = [R](int c0, int& a, int& b){ a = max(0, c0 - R) >> MAP_GRID_SHIFT; b = min(255, c0 + R) >> MAP_GRID_SHIFT; };
+  // squared distance from the center to the nearest and farthest point of a cell along one axis
+  auto span = [](int c0, int g, int32_t& near, int32_t& far){
+    int a = g << MAP_GRID_SHIFT, b = a + (1 << MAP_GRID_SHIFT) - 1;
+    int n = c0 < a ? a - c0 : c0 > b ? c0 - b : 0, f = max(abs(c0 - a), abs(c0 - b));
+    near += n * n; far += f * f;
+  };
+  int x0, x1, y0, y1, z0, z1;
+  cells(cx, x0, x1); cells(cy, y0, y1); cells(cz, z0, z1);
+  for (int gx = x0; gx <= x1; gx++){
+    int32_t nx = 0, fx = 0;
+    span(cx, gx, nx, fx);
+    for (int gy = y0; gy <= y1; gy++){
+      int32_t nxy = nx, fxy = fx;
+      span(cy, gy, nxy, fxy);
+      if (nxy >= hi2) continue;
+      for (int gz = z0; gz <= z1; gz++){
+        uint16_t cell = (gx * MAP_GRID + gy) * MAP_GRID + gz;
+        if (gMap.cellStart[cell] == gMap.cellStart[cell + 1]) continue;   // most of the space is empty
+        int32_t near = nxy, far = fxy;
+        span(cz, gz, near, far);
+        if (far <= lo2 || near >= hi2) continue;
+        for (uint16_t j = gMap.cellStart[cell]; j < gMap.cellStart[cell + 1]; j++){
+          uint16_t i = gMap.order[j];
+          int dx = gMap.x[i] - cx, dy = gMap.y[i] - cy, dz = gMap.z[i] - cz;
+          int32_t e = dx * dx + dy * dy + dz * dz - m2;
+          if (e < 0) e = -e;
+          if (e < band) ringPixel(px, i, c, 255 - (uint8_t)((e * k) >> 16));
+        }
+      }
+    }
+  }
+}
+
+void Ripples::advance(const Params& p, float dt, uint16_t n){
+  const float end = mapActive() ? MAP_RIPPLE_END : n;
+  for(auto &r:ring){
+    if(!r.on) continue;
+    r.age += dt*r.speed;
+    if (r.age * (8 + p.density/2.0f) > end) r.on = false;
+  }
+}
+
+void Ripples::draw(Pixels px, const Params& p) const {
+  const bool mapped = mapActive();
+  for(const auto &r:ring){
+    if(!r.on) continue;
+    float radius = r.age * (8 + p.density/2.0f);
+    if (mapped){
+      ringShell(px, r.center, radius, palVal()[(uint8_t)(255.0f * (1.0f - radius / MAP_RIPPLE_END))]);
+      continue;
+    }
+    if(radius>px.n) continue;
+    CRGB c = palVal()[(uint8_t)(255.0f * (1.0f - (radius/px.n)))];
+    float inner = radius - 2;
+    for(int d = max(0, (int)floorf(inner + 0.5f)); d <= (int)ceilf(radius - 0.5f); d++){
+      // overlap of the pixel [d-0.5, d+0.5] with the band [inner, radius]
+      float cover = min(d + 0.5f, radius) - max(d - 0.5f, inner);
+      if (cover <= 0) continue;
+      uint8_t w = (uint8_t)(min(cover, 1.0f) * 255.0f);
+      ringPixel(px, r.center + d, c, w);
+      if (d) ringPixel(px, r.center - d, c, w);
+    }
+  }
+}
+// Standalone mode, and the compositor's ring layer: the rings own the
+// buffer, so they fade it too
+void RippleMode::render(Pixels px, const Params& p, const FrameTime&){
+  litFadeToBlackBy(px.px, *px.lit, 18);
+  gRipples.draw(px, p);
+}
+
+// ---------- FRAME ----------------
+Modes gModes;
+
+void effectsReset(uint32_t seed){
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
+  gLit.clear();
+  gPower.clear();
+  gModes.reset();
+  gRipples.clear();
+  gComp.reset();
+  rngSeed(seed);
+  gFrameMs = 0;
+}
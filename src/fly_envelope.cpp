@@ -0,0 +1,29 @@
+#include "fly_envelope.h"
+
+// kFlyLevel16[i] = 65535 * (i/255)^4: the old i*i/255 curve followed by palDim's
+// scale8_video(v, v), without the two 8-bit roundings: below i = 64 that
+// chain gives only 0 or 1, the quarter of the envelope a tail is made of.
+const uint16_t kFlyLevel16[256] = {
+      0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      0,    0,    1,    1,    1,    1,    2,    2,    2,    3,    4,    4,
+      5,    6,    7,    8,   10,   11,   13,   14,   16,   18,   21,   23,
+     26,   29,   32,   36,   40,   44,   48,   53,   58,   64,   69,   76,
+     82,   89,   97,  105,  113,  122,  132,  142,  152,  164,  175,  188,
+    201,  215,  229,  244,  260,  277,  294,  312,  331,  351,  372,  394,
+    417,  440,  465,  490,  517,  545,  574,  604,  635,  667,  701,  736,
+    772,  809,  848,  888,  929,  972, 1017, 1063, 1110, 1159, 1210, 1262,
+   1316, 1372, 1430, 1489, 1550, 1613, 1678, 1744, 1813, 1884, 1957, 2032,
+   2109, 2188, 2269, 2353, 2439, 2527, 2618, 2711, 2806, 2904, 3005, 3108,
+   3214, 3322, 3434, 3548, 3664, 3784, 3907, 4032, 4161, 4292, 4427, 4565,
+   4706, 4850, 4997, 5148, 5302, 5460, 5621, 5786, 5954, 6126, 6302, 6481,
+   6664, 6851, 7042, 7237, 7436, 7639, 7847, 8058, 8273, 8493, 8718, 8946,
+   9179, 9417, 9659, 9906,10158,10414,10675,10941,11212,11488,11769,12055,
+  12347,12643,12945,13252,13565,13883,14207,14537,14872,15213,15559,15912,
+  16271,16635,17006,17383,17766,18155,18551,18953,19362,19777,20199,20627,
+  21063,21505,21954,22410,22874,23344,23822,24307,24799,25299,25806,26321,
+  26843,27373,27911,28457,29011,29573,30143,30721,31308,31903,32506,33118,
+  33739,34368,35006,35652,36308,36973,37646,38329,39022,39723,40434,41154,
+  41884,42624,43373,44133,44902,45681,46470,47270,48080,48900,49730,50571,
+  51423,52285,53159,54043,54938,55844,56761,57690,58630,59581,60544,61519,
+  62505,63503,64513,65535,
+};
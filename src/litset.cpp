@@ -0,0 +1,21 @@
+#include "litset.h"
+#include "power.h"
+
+LitSet gLit;
+
+void litFadeToBlackBy(CRGB* px, LitSet& lit, uint8_t amount){
+  PowerWalk sum;
+  for (uint16_t k = 0; k < LitSet::kWords; k++){
+    uint32_t m = lit.w[k];
+    if (!m) continue;
+    uint32_t keep = m;
+    do {
+      uint8_t b = __builtin_ctz(m); m &= m - 1;
+      CRGB& c = px[(k << 5) + b];
+      c.fadeToBlackBy(amount);
+      if (!(c.r | c.g | c.b)) keep &= ~(1UL << b);
+      else sum.add((k << 5) + b, c);
+    } while (m);
+    lit.w[k] = keep;
+  }
+}
@@ -4,571 +4,274 @@
 #include <FastLED.h>
 #include <math.h>
 #include <Preferences.h>
-
-// --------- USER CONFIG ----------
-#define LED_PIN       5
-#define NUM_LEDS      500
-#define LED_TYPE      WS2811
-#define COLOR_ORDER   GRB
-#define MAX_MA        2000
+#if CONFIG_PM_ENABLE
+#include <esp_pm.h>
+#endif
+#include "config.h"
+#include "effects.h"
+#include "compositor.h"
+#include "pipeline.h"
+#include "params.h"
+#include "segments.h"
+#include "ctrl_proto.h"
+#include "preview.h"
+#include "realtime.h"
+#include "sched_json.h"
+#include "wifi_manager.h"
+#include "persist.h"
+#include "metrics.h"
+#include "power.h"
+#include "litset.h"
+#include "pixmap.h"
+#include "pacer.h"
+#include "ui_assets.h"
 
 const char* WIFI_SSID = "Kamaji";
 const char* WIFI_PASS = "princesselizabeth";
 // --------------------------------
 
-CRGB leds[NUM_LEDS];
 AsyncWebServer server(80);
+AsyncWebSocket ws("/ws");
+AsyncWebSocket preview("/preview");
+std::atomic<bool> gPreviewKey{true};   // next preview frame must be a key frame
+TaskHandle_t gLoopTask = nullptr, gTxTask = nullptr;   // stack high-water marks for /metrics
+SeqLock<PowerOut> gPowerPub;   // loop() -> /power, once per frame
 
 // ---- Wi-Fi state / storage ----
+// The list and the last good access point are one blob each in the "wifi"
+// namespace; a write only happens when the bytes differ from what is stored.
 Preferences prefs;
-String savedSsid = "";
-String savedPass = "";
-bool inApMode = false;
-const char* AP_SSID = "Fireflies-Setup";
-const char* AP_PASS = ""; // open AP
-
-// Multiple saved networks
-struct WifiCred { String ssid; String pass; };
-#define MAX_WIFI_NETS 10
-WifiCred gNets[MAX_WIFI_NETS];
-int gNetCount = 0;
+NvsStore gWifiKv("wifi");
+BlobSlot gNetsSlot("nets"), gFastSlot("fast");
+
+// Saved networks: the web task edits gNets and publishes it; loop() hands
+// snapshots to the connection manager, which runs in loop() and never waits.
+WifiList gNets = {};
+SeqLock<WifiList> gNetsPub;
+uint32_t gNetsSeq = 0;
+std::atomic<bool> gWifiRetry{false};   // /wifi_try -> loop()
+std::atomic<bool> gBuiltinUp{false};   // loop() -> web task: joined WIFI_SSID
+WifiManager gWifi(wifiRadio());
 
+void saveWifiList(){
+  gNetsSlot.save(gWifiKv, &gNets, sizeof(gNets));
+  gNetsPub.write(gNets);
+}
 void loadWifiList(){
-  gNetCount = 0;
+  if (gNetsSlot.load(gWifiKv, &gNets, sizeof(gNets)) && gNets.count <= MAX_WIFI_NETS){ gNetsPub.write(gNets); return; }
+  // Older firmware: one key per field. Read them once, then store the blob.
+  gNets = {};
   prefs.begin("wifi", false);
   int n = prefs.getInt("n", 0);
   for (int i=0; i<n && i<MAX_WIFI_NETS; i++){
     String s = prefs.getString(("s"+String(i)).c_str(), "");
     String p = prefs.getString(("p"+String(i)).c_str(), "");
-    if (s.length()>0) gNets[gNetCount++] = {s,p};
+    if (s.length()>0){
+      WifiNet& w = gNets.net[gNets.count++];
+      strlcpy(w.ssid, s.c_str(), sizeof(w.ssid)); strlcpy(w.pass, p.c_str(), sizeof(w.pass));
+    }
   }
   // Backward compat: migrate single ssid/pass if present
-  if (gNetCount==0){
+  if (gNets.count==0){
     String s = prefs.getString("ssid", "");
     String p = prefs.getString("pass", "");
     if (s.length()>0){
-      gNets[gNetCount++] = {s,p};
-      prefs.putInt("n", gNetCount);
-      prefs.putString("s0", s);
-      prefs.putString("p0", p);
+      WifiNet& w = gNets.net[gNets.count++];
+      strlcpy(w.ssid, s.c_str(), sizeof(w.ssid)); strlcpy(w.pass, p.c_str(), sizeof(w.pass));
     }
   }
+  for (int i=0; i<n && i<MAX_WIFI_NETS; i++){ prefs.remove(("s"+String(i)).c_str()); prefs.remove(("p"+String(i)).c_str()); }
+  prefs.remove("n"); prefs.remove("ssid"); prefs.remove("pass");
   prefs.end();
+  saveWifiList();
 }
-void saveWifiList(){
-  prefs.begin("wifi", false);
-  prefs.putInt("n", gNetCount);
-  for (int i=0;i<gNetCount;i++){
-    prefs.putString(("s"+String(i)).c_str(), gNets[i].ssid);
-    prefs.putString(("p"+String(i)).c_str(), gNets[i].pass);
+int findWifi(const String& s){
+  for (int i=0;i<gNets.count;i++) if (s == gNets.net[i].ssid) return i;
+  return -1;
+}
+// The built-in network goes to the manager as a fallback behind the saved
+// ones; it joins the saved list once the device has actually associated with
+// it. loop() flags that; the web task, which owns gNets, stores it the next
+// time a handler reads or edits the list.
+WifiList withBuiltin(const WifiList& l){
+  WifiList w = l;
+  bool have = !WIFI_SSID[0];
+  for (int i=0;i<w.count && !have;i++) have = !strcmp(w.net[i].ssid, WIFI_SSID);
+  if (!have && w.count < MAX_WIFI_NETS){
+    WifiNet& n = w.net[w.count++];
+    strlcpy(n.ssid, WIFI_SSID, sizeof(n.ssid)); strlcpy(n.pass, WIFI_PASS, sizeof(n.pass));
   }
-  prefs.end();
+  return w;
+}
+void adoptBuiltin(){
+  if (!gBuiltinUp.exchange(false) || findWifi(WIFI_SSID) >= 0 || gNets.count >= MAX_WIFI_NETS) return;
+  WifiNet& n = gNets.net[gNets.count++];
+  strlcpy(n.ssid, WIFI_SSID, sizeof(n.ssid)); strlcpy(n.pass, WIFI_PASS, sizeof(n.pass));
+  saveWifiList();
 }
 bool addWifi(const String& s, const String& p){
-  if (s.length()==0 || gNetCount>=MAX_WIFI_NETS) return false;
-  for (int i=0;i<gNetCount;i++){ if (gNets[i].ssid==s){ gNets[i].pass=p; saveWifiList(); return true; } }
-  gNets[gNetCount++] = {s,p};
+  adoptBuiltin();
+  if (s.length()==0 || s.length()>32 || p.length()>64) return false;
+  int i = findWifi(s);
+  if (i<0){ if (gNets.count>=MAX_WIFI_NETS) return false; i = gNets.count++; }
+  strlcpy(gNets.net[i].ssid, s.c_str(), sizeof(gNets.net[i].ssid));
+  strlcpy(gNets.net[i].pass, p.c_str(), sizeof(gNets.net[i].pass));
   saveWifiList();
   return true;
 }
 bool delWifi(int idx){
-  if (idx<0 || idx>=gNetCount) return false;
-  for (int i=idx;i<gNetCount-1;i++) gNets[i]=gNets[i+1];
-  gNetCount--;
+  adoptBuiltin();
+  if (idx<0 || idx>=gNets.count) return false;
+  for (int i=idx;i<gNets.count-1;i++) gNets.net[i]=gNets.net[i+1];
+  gNets.net[--gNets.count] = {};   // no stale password left in the blob
   saveWifiList();
   return true;
 }
 
-// runtime params
-uint8_t gBrightness = 80;
-uint8_t gMode = 0;      // 0=Fireflies 1=Sync 2=Wave 3=Twinkle 4=Swarm 5=Ripples
-uint8_t gDensity = 35;  // meaning varies by mode
-uint8_t gSpeed = 50;
-uint8_t gHueBase = 45;
-uint8_t gSaturation = 200;
-bool    gAutoHueDrift = true;
-
-// NEW: lifespan + background fade
-uint8_t gLifespan = 50; // 1–100; lower = shorter life (faster on/off)
-uint8_t gFade     = 240; // 200–250; lower = faster fade-to-black
-
-uint32_t lastFrame = 0;
 uint32_t tMs = 0;
 
 // ----- Simple scheduler -----
-struct SchedItem { uint8_t mode; uint32_t duration_ms; };
-#define MAX_SCHEDULE_ITEMS 20
-SchedItem gSchedule[MAX_SCHEDULE_ITEMS];
-uint8_t gScheduleCount = 0;
+// loop()'s own copy; the web task publishes new ones through gSchedPub.
+Schedule gSched = {};
+uint32_t gSchedSeq = 0;
 uint8_t gScheduleIndex = 0;
 uint32_t gSchedStart = 0;
 bool gScheduleEnabled = false;
 
-// ---------- FIREFLIES -----------
-struct Firefly { uint16_t idx; float phase, rise, fall, hold; uint8_t hue; bool active; };
-#define MAX_FIREFLIES 128
-Firefly flies[MAX_FIREFLIES];
-
-float frand(float a,float b){ return a+(b-a)*(float)esp_random()/(float)UINT32_MAX; }
-uint16_t urand16(uint16_t a,uint16_t b){ return a+(esp_random()%(uint32_t)(b-a+1)); }
-
-void spawnFly(Firefly &f){
-  f.idx = urand16(0, NUM_LEDS-1);
-  f.rise = frand(0.15,0.35); f.hold = frand(0.05,0.25); f.fall = frand(0.25,0.55);
-  f.phase=0; f.hue = gAutoHueDrift ? (gHueBase + random8(12)) : gHueBase; f.active=true;
-}
-void setupFireflies(){ for(int i=0;i<MAX_FIREFLIES;i++) flies[i].active=false; }
-
-void stepFireflies(float dt){
-  // spawn to target density
-  uint8_t target = map(gDensity, 0, 100, 0, MAX_FIREFLIES);
-  int active=0; for(auto &f:flies) if(f.active) active++;
-  for(int s=0;s<4 && active<target;s++){ for(auto &f:flies) if(!f.active){ spawnFly(f); active++; break; } }
-
-  // Stronger background fade so residuals actually reach black
-  for (int i=0;i<NUM_LEDS;i++){
-    leds[i].nscale8_video(gFade);
-    if (leds[i].r < 3 && leds[i].g < 3 && leds[i].b < 3) leds[i] = CRGB::Black; // snap tiny embers off
-  }
-
-  // Lifespan scaler: lower gLifespan => faster time progression
-  float lifeScale = 0.6f + 1.6f * (1.0f - (gLifespan / 100.0f)); // 100 → slow/long, 1 → fast/short
-
-  for (auto &f : flies){
-    if (!f.active) continue;
-
-    float speedScalar = (0.08f + 0.6f*(gSpeed/100.0f)) * lifeScale;
-    f.phase += dt * speedScalar;
-
-    float total = f.rise + f.hold + f.fall;
-    if (f.phase >= total){ f.active=false; continue; }
-
-    float x=f.phase, a=0.0f;
-    if (x < f.rise)               a = x / f.rise;
-    else if (x < f.rise + f.hold) a = 1.0f;
-    else                          a = 1.0f - ((x - (f.rise + f.hold)) / f.fall);
-
-    uint8_t v = (uint8_t)((a*a) * 255);
-    leds[f.idx] += CHSV(f.hue, gSaturation, v);
-  }
-
-  if (gAutoHueDrift && (millis() & 1023) < 16) gHueBase++;
-}
-
-// ---------- SYNC / WAVE ----------
-void stepSync(float){ uint8_t beat = beatsin8(10+(gSpeed/2), 10, 255); fill_solid(leds, NUM_LEDS, CHSV(gHueBase,gSaturation,beat)); }
-void stepWave(float t){
-  for(int i=0;i<NUM_LEDS;i++){
-    uint8_t b1=sin8((i*2)+(t*(2+gSpeed/2))); uint8_t b2=sin8((i*3)-(t*(1+gSpeed/3)));
-    leds[i]=CHSV(gHueBase,gSaturation,qadd8(b1/2,b2/2));
-  }
-}
-
-// ---------- TWINKLE --------------
-void stepTwinkle(float){
-  fadeToBlackBy(leds, NUM_LEDS, 12);
-  if(random8() < gDensity){ int i = random16(NUM_LEDS); leds[i] += CHSV(gHueBase + random8(18), gSaturation, random8(160,255)); }
-}
-
-// ---------- SWARM (Perlin) -------
-void stepSwarm(float t){
-  for(int i=0;i<NUM_LEDS;i++){
-    uint8_t n = inoise8(i*4, (uint32_t)(t* (10+gSpeed)) );
-    uint8_t v = scale8(n, 220);
-    leds[i] = CHSV(gHueBase + scale8(n,20), gSaturation, v);
-  }
-}
-
-// ---------- RIPPLES --------------
-#define MAX_RIPPLES 6
-struct Ripple { int center; float age; float speed; bool on; };
-Ripple rip[MAX_RIPPLES];
-void triggerRipple(){ for(auto &r:rip) if(!r.on){ r.center=random16(NUM_LEDS); r.age=0; r.speed=0.9f+(gSpeed/140.0f); r.on=true; break; } }
-void stepRipples(float dt){
-  fadeToBlackBy(leds, NUM_LEDS, 18);
-  for(auto &r:rip){
-    if(!r.on) continue;
-    r.age += dt*r.speed;
-    float radius = r.age * (8 + gDensity/2.0f);
-    if(radius>NUM_LEDS){ r.on=false; continue; }
-    for(int i=0;i<NUM_LEDS;i++){
-      float d=fabsf(i - r.center);
-      if(d<radius && d>radius-2){
-        uint8_t v = (uint8_t)(255.0f * (1.0f - (radius/NUM_LEDS)));
-        leds[i] += CHSV(gHueBase, gSaturation, v);
-      }
-    }
-  }
-}
-// Ripple overlay that can run on top of any base mode
-void stepRipplesOverlay(float dt){
-  stepRipples(dt);
-}
+// Scene (Params + schedule) in NVS: restored at boot, written a few seconds
+// after the last change (see persist.h).
+NvsStore gSceneKv("scene");
+ScenePersist gScene(gSceneKv);
+
+// /schedule upload in progress (web task only)
+SchedParser gSchedParser;
+AsyncWebServerRequest* gSchedOwner = nullptr;
+bool gSchedOk = false;
+
+// Preview state (the last frame sent and the encode buffer) and a map
+// upload's staging never need to live at once, so they share one block. A
+// /map upload takes it from the preview, which pauses until loop() has built
+// the map and hands it back; the next preview frame is then a key frame.
+enum : uint8_t { SCRATCH_FREE, SCRATCH_PREVIEW, SCRATCH_MAP };
+#define SCRATCH_BYTES (NUM_LEDS * 3 + PREVIEW_MAX_BYTES(NUM_LEDS))
+static_assert(SCRATCH_BYTES >= NUM_LEDS * 3 * sizeof(int16_t), "map staging must fit the preview block");
+alignas(4) uint8_t gScratch[SCRATCH_BYTES];
+std::atomic<uint8_t> gScratchUse{SCRATCH_FREE};
+bool scratchTake(uint8_t who){ uint8_t f = SCRATCH_FREE; return gScratchUse.compare_exchange_strong(f, who); }
+void scratchGive(){ gPreviewKey = true; gScratchUse = SCRATCH_FREE; }   // from the map: the preview's last frame is gone
+
+static_assert(sizeof(leds) + sizeof(gPipe) + sizeof(gComp) + sizeof(gModes) + sizeof(gMap) + sizeof(gScratch) + sizeof(gLit) <= DRAM_BUDGET,
+              "per-pixel buffers exceed DRAM_BUDGET: lower NUM_LEDS (see config.h)");
+
+// Pixel map: /map parses an upload into the scratch block, quantizes it there
+// (mapXyz()) and stores it, loop() rebuilds gMap from it and gives the block
+// back. The block belongs to the web task while gMapHeld is set, and to
+// loop() while gMapPending is set with a count.
+inline uint8_t* mapXyz(){ return gScratch; }
+uint16_t gMapCount = 0;
+std::atomic<bool> gMapPending{false};
+MapParser gMapParser;
+AsyncWebServerRequest* gMapOwner = nullptr;
+bool gMapOk = false, gMapHeld = false;
 
 // ------------- WEB UI -------------
-const char* HTML = R"HTML(
-<!doctype html><html><head><meta name=viewport content='width=device-width,initial-scale=1'>
-<title>Fireflies</title>
-<style>
-:root{--bg:#0b0d12;--card:#121725;--text:#e6ecf2;--muted:#95a2b0;--acc:#5ee06c;--rail:#2b3246;--handle:#2a9241;}
-*{box-sizing:border-box} body{margin:0;background:var(--bg);color:var(--text);font:16px/1.45 system-ui,-apple-system,Segoe UI,Roboto,Helvetica,Arial}
-.wrap{max-width:880px;margin:32px auto;padding:0 18px}
-.card{background:var(--card);border-radius:14px;padding:18px;margin:14px 0;box-shadow:0 6px 18px rgba(0,0,0,.28)}
-h2{margin:8px 0 14px}
-label{display:flex;justify-content:space-between;align-items:center;margin:12px 0 6px}
-.val{opacity:.85;font-variant-numeric:tabular-nums}
-select,input[type=range],button{width:100%}
-input[type=range]{accent-color:var(--acc)}
-.hint{color:var(--muted);font-size:.9em;margin:-2px 0 10px}
-.row{display:grid;grid-template-columns:1fr 1fr;gap:14px}
-@media (max-width:740px){.row{grid-template-columns:1fr}}
-.btn{margin-top:10px;padding:12px 14px;border:0;border-radius:10px;background:var(--acc);color:#06210b;font-weight:700}
-.btn.secondary{background:#2f3548;color:#d9e0ea}
-.bar{height:10px;border-radius:8px;background:var(--rail);overflow:hidden}
-.footer{color:var(--muted);font-size:.85em;margin-top:10px}
-.sched-list{list-style:none;margin:0;padding:0}
-.sched-item{display:flex;align-items:center;gap:8px;background:#0f1320;border:1px solid #242a3a;border-radius:10px;padding:10px;margin:8px 0;cursor:grab}
-.handle{width:14px;height:14px;border-radius:4px;background:var(--handle)}
-.mode-badge{font-weight:600}
-.small{font-size:.9em;color:var(--muted)}
-</style></head><body><div class=wrap>
-<h2>Fireflies Controller</h2>
-<div id="apBanner" class="hint" style="display:none">AP mode: connect your phone to <b>Fireflies-Setup</b> and open <b>http://192.168.4.1/wifi</b> to join a network.</div>
-<div class=card>
-  <label>Mode
-    <select id=mode>
-      <option value=0>Fireflies</option>
-      <option value=1>Sync Pulse</option>
-      <option value=2>Wave</option>
-      <option value=3>Twinkle</option>
-      <option value=4>Swarm</option>
-      <option value=5>Ripples (standalone)</option>
-    </select>
-  </label>
-  <div class=hint>Choose the base animation. The Ripple button below now works on <em>any</em> mode as an overlay.</div>
-
-  <div class=row>
-    <div>
-      <label>Brightness <span class=val id=vbright></span></label>
-      <input type=range id=bright min=1 max=255 value=80>
-      <div class=hint>Overall output level. Lower if your PSU gets warm.</div>
-    </div>
-    <div>
-      <label>Density / Intensity <span class=val id=vdensity></span></label>
-      <input type=range id=density min=0 max=100 value=35>
-      <div class=hint>How many lights are active at once (mode-dependent).</div>
-    </div>
-  </div>
-
-  <div class=row>
-    <div>
-      <label>Speed <span class=val id=vspeed></span></label>
-      <input type=range id=speed min=1 max=100 value=50>
-      <div class=hint>Animation tempo.</div>
-    </div>
-    <div>
-      <label>Hue <span class=val id=vhue></span></label>
-      <input type=range id=hue min=0 max=255 value=45>
-      <div class=hint>Base color; enable drift for subtle wandering.</div>
-    </div>
-  </div>
-
-  <div class=row>
-    <div>
-      <label>Saturation <span class=val id=vsat></span></label>
-      <input type=range id=sat min=0 max=255 value=200>
-      <div class=hint>Color purity. Lower for pastel fireflies.</div>
-    </div>
-    <div>
-      <label>Lifespan <span class=val id=vlife></span></label>
-      <input type=range id=life min=1 max=100 value=50>
-      <div class=hint>How long each firefly lives. Lower = quicker blink.</div>
-    </div>
-  </div>
-
-  <label>Background Fade <span class=val id=vfade></span></label>
-  <input type=range id=fade min=200 max=250 value=240>
-  <div class=hint>How fast the whole scene clears to black. Lower = faster.</div>
-
-  <div style="display:flex;align-items:center;gap:10px;margin-top:8px">
-    <input type=checkbox id=drift checked>
-    <label for=drift style="margin:0">Auto hue drift</label>
-  </div>
-
-  <button class=btn id=rippleBtn>Create Ripple</button>
-  <div class=hint>Triggers an expanding wave overlay on top of the current mode.</div>
-
-  <div class=card style="margin-top:16px">
-    <h3 style="margin:0 0 8px">Wi-Fi</h3>
-    <div class=hint>Save the networks you use. The device will try them at boot, in the order listed below.</div>
-
-    <ul id="wifiList" class="sched-list" style="margin-top:8px"></ul>
-
-    <div class=row>
-      <div>
-        <label>SSID</label>
-        <input id="nwSsid" placeholder="Network name">
-      </div>
-      <div>
-        <label>Password</label>
-        <input id="nwPass" type="password" placeholder="Password">
-      </div>
-    </div>
-    <div class=row>
-      <button class="btn secondary" id="addNet">Add network</button>
-      <a class="btn secondary" href="/wifi_setup">Start Setup Hotspot</a>
-    </div>
-    <div class=row>
-      <a class="btn secondary" href="/wifi">Open Wi-Fi Setup</a>
-      <button class="btn" id="tryNets">Try saved networks now</button>
-    </div>
-    <div class="small" id="wifiMsg" style="margin-top:6px;opacity:.85"></div>
-  </div>
-</div>
-
-<div class=card>
-  <h2 style="margin-top:0">Scheduler</h2>
-  <div class=hint>Build a simple timeline: choose a mode, set duration, press <b>Add</b>. Drag to reorder. Press <b>Send to ESP32</b> to start looping.</div>
-  <div class=row>
-    <div>
-      <label>Mode</label>
-      <select id=schMode>
-        <option value=0>Fireflies</option>
-        <option value=3>Twinkle</option>
-        <option value=4>Swarm</option>
-        <option value=2>Wave</option>
-        <option value=1>Sync Pulse</option>
-        <option value=5>Ripples (standalone)</option>
-      </select>
-    </div>
-    <div>
-      <label>Duration</label>
-      <div class=row>
-        <input type=number id=schMin min=0 max=180 value=0 style="width:100%" placeholder="min">
-        <input type=number id=schSec min=0 max=59 value=10 style="width:100%" placeholder="sec">
-      </div>
-      <div class="small" style="opacity:.8">Minutes and seconds (0–180 min, 0–59 sec).</div>
-    </div>
-  </div>
-  <div class=row>
-    <button class="btn" id=addItem>Add</button>
-    <button class="btn secondary" id=clearItems>Clear</button>
-  </div>
-  <ul class=sched-list id=schedList></ul>
-  <button class="btn" id=sendSched>Send to ESP32</button>
-  <div class="footer small">The schedule loops continuously on the device until you clear or send a new one.</div>
-</div>
-
-<script>
-// ----- Helpers -----
-const qs=id=>document.getElementById(id);
-const state={};
-
-fetch('/whoami').then(r=>r.json()).then(j=>{
-  const b=document.getElementById('apBanner'); if(!b) return;
-  if(j && j.ap){ b.style.display='block'; }
-}).catch(()=>{});
-
-function upd(){
-  qs('vbright').textContent=qs('bright').value;
-  qs('vdensity').textContent=qs('density').value;
-  qs('vspeed').textContent=qs('speed').value;
-  qs('vhue').textContent=qs('hue').value;
-  qs('vsat').textContent=qs('sat').value;
-  qs('vlife').textContent=qs('life').value;
-  qs('vfade').textContent=qs('fade').value;
-}
-
-function sendParams(){
-  const p=new URLSearchParams({
-    mode:qs('mode').value, bright:qs('bright').value, density:qs('density').value,
-    speed:qs('speed').value, hue:qs('hue').value, sat:qs('sat').value,
-    life:qs('life').value, fade:qs('fade').value, drift:qs('drift').checked?1:0
-  });
-  fetch('/set?'+p);
-}
-
-['mode','bright','density','speed','hue','sat','life','fade','drift'].forEach(id=>{
-  qs(id).addEventListener(id==='mode'?'change':'input', ()=>{ upd(); sendParams(); });
-});
-
-// Ripple overlay works on any mode now
-qs('rippleBtn').addEventListener('click', ()=>{ fetch('/ripple'); });
-
-upd();
-
-// ----- Scheduler UI (drag & drop) -----
-const list=qs('schedList');
-function renderSchedule(items){
-  list.innerHTML='';
-  items.forEach((it,idx)=>{
-    const li=document.createElement('li');
-    li.className='sched-item';
-    li.draggable=true;
-    li.dataset.idx=idx;
-    const mm = Math.floor(it.seconds/60), ss = it.seconds%60;
-    li.innerHTML = '<div class=handle></div>'
-      + '<div class=mode-badge>'+ modeName(it.mode) +'</div>'
-      + '<div class=small>'+ (mm>0?(mm+'m '):'') + ss + 's</div>'
-      + '<button class="btn secondary" style="width:auto" onclick="removeItem('+idx+')">Remove</button>';
-    li.addEventListener('dragstart', ev=>{ ev.dataTransfer.setData('text/plain', idx); });
-    li.addEventListener('dragover', ev=>ev.preventDefault());
-    li.addEventListener('drop', ev=>{
-      ev.preventDefault();
-      const from=+ev.dataTransfer.getData('text/plain'); const to=idx;
-      if(from===to) return;
-      const a=schedule[from]; schedule.splice(from,1); schedule.splice(to,0,a);
-      renderSchedule(schedule);
-    });
-    list.appendChild(li);
-  });
-}
-function modeName(m){ return ['Fireflies','Sync','Wave','Twinkle','Swarm','Ripples'][m] || ('Mode '+m); }
-let schedule=[];
-
-qs('addItem').addEventListener('click', ()=>{
-  const m = +qs('schMode').value;
-  const min = Math.max(0, Math.min(180, +qs('schMin').value||0));
-  const sec = Math.max(0, Math.min(59,  +qs('schSec').value||0));
-  let total = (min*60)+sec;
-  if (total < 1) total = 1; // minimum 1s
-  schedule.push({mode:m, seconds: total});
-  renderSchedule(schedule);
-});
-window.removeItem=function(i){ schedule.splice(i,1); renderSchedule(schedule); };
-qs('clearItems').addEventListener('click', ()=>{ schedule=[]; renderSchedule(schedule); });
-
-qs('sendSched').addEventListener('click', ()=>{
-  fetch('/schedule', {method:'POST', headers:{'Content-Type':'application/json'}, body: JSON.stringify({items:schedule})});
-});
-
-// ----- Wi-Fi list management -----
-function refreshWifiList(){
-  fetch('/wifi_list').then(r=>r.json()).then(arr=>{
-    const ul=document.getElementById('wifiList'); ul.innerHTML='';
-    arr.forEach((item,i)=>{
-      const li=document.createElement('li');
-      li.className='sched-item';
-      li.innerHTML = '<div class="handle"></div>'
-        + '<div class="mode-badge">'+ item.ssid +'</div>'
-        + '<button class="btn secondary" style="width:auto" onclick="delNet('+i+')">Remove</button>';
-      ul.appendChild(li);
-    });
-  }).catch(()=>{});
-}
-function delNet(i){ fetch('/wifi_del?i='+i).then(()=>refreshWifiList()); }
-document.getElementById('addNet').addEventListener('click', ()=>{
-  const s=document.getElementById('nwSsid').value.trim();
-  const p=document.getElementById('nwPass').value;
-  if(!s){ document.getElementById('wifiMsg').textContent='Enter an SSID.'; return; }
-  fetch('/wifi_add', {method:'POST', body:new URLSearchParams({ssid:s, pass:p})})
-    .then(()=>{ document.getElementById('nwPass').value=''; refreshWifiList(); });
-});
-document.getElementById('tryNets').addEventListener('click', ()=>{
-  const msg=document.getElementById('wifiMsg'); msg.textContent='Trying saved networks…';
-  fetch('/wifi_try').then(r=>r.json()).then(j=>{
-    msg.textContent = j.connected ? 'Connected! Check the Serial Monitor for IP.' : 'No saved networks worked. AP may be active.';
-  }).catch(()=>{ msg.textContent='Error contacting device.'; });
-});
-refreshWifiList();
-</script>
-</div></body></html>
-)HTML";
-
-void startAP(){
-  inApMode = true;
-  WiFi.mode(WIFI_AP);
-  WiFi.softAP(AP_SSID, AP_PASS);
-  IPAddress ip = WiFi.softAPIP();
-  Serial.println();
-  Serial.print("AP mode. Connect to "); Serial.print(AP_SSID);
-  Serial.print(" then visit http://"); Serial.println(ip);
-}
-
-bool tryConnectSTA(const char* ssid, const char* pass, uint32_t timeoutMs){
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(ssid, pass);
-  Serial.print("WiFi connect to '"); Serial.print(ssid); Serial.print("' ");
-  uint32_t start = millis();
-  while (WiFi.status() != WL_CONNECTED && (millis() - start) < timeoutMs) {
-    delay(300); Serial.print(".");
-  }
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.println();
-    Serial.print("IP: "); Serial.println(WiFi.localIP());
-    inApMode = false;
-    return true;
-  }
-  Serial.println();
-  Serial.println("WiFi connect timeout.");
-  return false;
-}
+// Pages live in ui/ and are embedded as gzip by tools/embed_ui.py (ui_assets.h).
 
+// Starts the connection manager: the cached access point if there is one,
+// else a scan. Returns at once; loop() ticks it.
 void setupWiFi(){
   Serial.begin(115200);
-  delay(50);
-
-  loadWifiList();  // new: list of networks
-
-  bool ok = false;
-  for (int i=0; i<gNetCount && !ok; i++){
-    ok = tryConnectSTA(gNets[i].ssid.c_str(), gNets[i].pass.c_str(), 10000);
-  }
+  loadWifiList();
+  WifiFast fast = {};
+  bool haveFast = gFastSlot.load(gWifiKv, &fast, sizeof(fast));
+  gWifi.begin(withBuiltin(gNets), haveFast ? &fast : nullptr, millis());
+}
 
-  if (!ok && String(WIFI_SSID).length()>0){
-    ok = tryConnectSTA(WIFI_SSID, WIFI_PASS, 10000);
-    if (ok){ addWifi(WIFI_SSID, WIFI_PASS); }
+// loop() side: list edits and retries from the web task, then one tick.
+void wifiTick(uint32_t now){
+  static WifiList nets;
+  static bool wasUp = false;
+  if (gNetsPub.read(nets, gNetsSeq)){ gWifi.setNetworks(withBuiltin(nets)); if (!gWifi.up()) gWifi.retry(now); }
+  if (gWifiRetry.exchange(false)) gWifi.retry(now);
+  gWifi.tick(now);
+  if (gWifi.up() && !wasUp && !strcmp(gWifi.fast().ssid, WIFI_SSID)) gBuiltinUp = true;
+  wasUp = gWifi.up();
+  if (gWifi.fastChanged){   // new access point: remember it for the next boot
+    gFastSlot.save(gWifiKv, &gWifi.fast(), sizeof(WifiFast));
+    gWifi.fastChanged = false;
   }
+}
 
-  if (!ok) startAP();
+// 304 when the browser already holds this build's page, else the gzipped
+// bytes streamed straight from flash (no String copy, no heap).
+void sendAsset(AsyncWebServerRequest* r, const UiAsset& a){
+  MET_HANDLER(MH_ASSET);
+  AsyncWebHeader* inm = r->getHeader("If-None-Match");
+  if (inm && inm->value() == a.etag){ r->send(304); return; }
+  AsyncWebServerResponse* res = r->beginResponse_P(200, a.type, a.gz, a.len);
+  res->addHeader("Content-Encoding", "gzip");
+  res->addHeader("ETag", a.etag);
+  res->addHeader("Cache-Control", "no-cache");  // always revalidate; a match costs a 304
+  r->send(res);
 }
 
 void setupWeb(){
-  server.on("/", HTTP_GET, [](AsyncWebServerRequest* r){ r->send(200,"text/html; charset=utf-8",HTML); });
+  // UI pages: gzipped in flash by tools/embed_ui.py, revalidated by ETag
+  for (const UiAsset& a : kUiAssets)
+    server.on(a.url, HTTP_GET, [&a](AsyncWebServerRequest* r){ sendAsset(r, a); });
 
+  // Handlers never touch the render globals; they edit and publish a Params block.
   server.on("/set", HTTP_GET, [](AsyncWebServerRequest* req){
-    if(req->hasParam("mode"))    gMode = req->getParam("mode")->value().toInt();
-    if(req->hasParam("bright"))  gBrightness = req->getParam("bright")->value().toInt();
-    if(req->hasParam("density")) gDensity = req->getParam("density")->value().toInt();
-    if(req->hasParam("speed"))   gSpeed = req->getParam("speed")->value().toInt();
-    if(req->hasParam("hue"))     gHueBase = req->getParam("hue")->value().toInt();
-    if(req->hasParam("sat"))     gSaturation = req->getParam("sat")->value().toInt();
-    if(req->hasParam("life"))    gLifespan = req->getParam("life")->value().toInt();
-    if(req->hasParam("fade"))    gFade     = req->getParam("fade")->value().toInt();
-    if(req->hasParam("drift"))   gAutoHueDrift = (req->getParam("drift")->value().toInt()!=0);
+    MET_HANDLER(MH_SET);
+    long mode = req->hasParam("mode") ? req->getParam("mode")->value().toInt() : 0;
+    if (mode < 0 || mode >= MODE_COUNT){ req->send(400, "text/plain", "bad mode"); return; }   // before any field changes
+    Params& p = paramsEdit();
+    if(req->hasParam("mode"))    p.mode = mode;
+    if(req->hasParam("bright"))  p.brightness = req->getParam("bright")->value().toInt();
+    if(req->hasParam("density")) p.density = req->getParam("density")->value().toInt();
+    if(req->hasParam("speed"))   p.speed = req->getParam("speed")->value().toInt();
+    if(req->hasParam("hue"))     p.hue = req->getParam("hue")->value().toInt();
+    if(req->hasParam("sat"))     p.sat = req->getParam("sat")->value().toInt();
+    if(req->hasParam("life"))    p.lifespan = req->getParam("life")->value().toInt();
+    if(req->hasParam("fade"))    p.fade = req->getParam("fade")->value().toInt();
+    if(req->hasParam("drift"))   p.drift = (req->getParam("drift")->value().toInt()!=0);
+    if(req->hasParam("pv"))      p.preview = req->getParam("pv")->value().toInt();
+    if(req->hasParam("fps"))     p.fps = req->getParam("fps")->value().toInt();
+    paramsPublish();
     req->send(200,"text/plain","ok");
   });
 
-  server.on("/ripple", HTTP_GET, [](AsyncWebServerRequest* r){ triggerRipple(); r->send(200,"text/plain","rip"); });
+  // Optional ?i=<pixel> picks the center; a full queue drops the trigger.
+  server.on("/ripple", HTTP_GET, [](AsyncWebServerRequest* r){
+    gRippleQ.push(r->hasParam("i") ? (int16_t)r->getParam("i")->value().toInt() : -1);
+    r->send(200,"text/plain","rip");
+  });
+
+  // Mode labels in mode-number order, for the UI's pickers (Modes in effects.h)
+  server.on("/modes", HTTP_GET, [](AsyncWebServerRequest* r){
+    String j = "[";
+    for (uint8_t m = 0; m < MODE_COUNT; m++) j += String(m ? ",\"" : "\"") + modeLabel(m) + "\"";
+    r->send(200, "application/json", j + "]");
+  });
 
-  // UI can detect AP mode
+  // UI can detect AP mode; the Wi-Fi page prefills the saved SSID from here
   server.on("/whoami", HTTP_GET, [](AsyncWebServerRequest* r){
-    String j = String("{\"ap\":") + (inApMode ? "true" : "false") + "}";
+    adoptBuiltin();
+    static const char* const kStates[] = { "idle", "fast", "scan", "connect", "up", "ap" };
+    String j = String("{\"ap\":") + (gWifi.state()==WS_AP ? "true" : "false")
+             + ",\"wifi\":\"" + kStates[gWifi.state()] + "\",\"ip\":\"" + WiFi.localIP().toString()
+             + "\",\"ssid\":\"" + (gNets.count ? gNets.net[0].ssid : "") + "\"}";
     r->send(200, "application/json", j);
   });
 
-  // Simple Wi-Fi config page (single entry)
-  server.on("/wifi", HTTP_GET, [](AsyncWebServerRequest* r){
-    String page = F("<!doctype html><html><head><meta name=viewport content='width=device-width,initial-scale=1'><title>Wi-Fi Setup</title><style>body{font-family:system-ui,-apple-system,Segoe UI,Roboto,Helvetica,Arial;padding:18px}input,button{font-size:16px;padding:10px;margin:6px 0;width:100%}label{display:block;margin-top:10px}</style></head><body>");
-    page += F("<h2>Fireflies Wi-Fi Setup</h2>");
-    page += F("<form method='POST' action='/wifi_save'>");
-    page += F("<label>SSID</label><input name='ssid' placeholder='Network name' value='");
-    page += savedSsid; page += F("'>");
-    page += F("<label>Password</label><input name='pass' type='password' placeholder='Password' value='");
-    page += savedPass; page += F("'>");
-    page += F("<button type='submit'>Save &amp; Reboot</button></form>");
-    page += F("<p style='opacity:.7'>Device will reboot and try to join the network you entered.</p>");
-    page += F("</body></html>");
-    r->send(200, "text/html; charset=utf-8", page);
-  });
+  // Simple Wi-Fi config page (single entry) is the /wifi asset above
   server.on("/wifi_save", HTTP_POST, [](AsyncWebServerRequest* req){
+    MET_HANDLER(MH_WIFI);
     String ssid = req->getParam("ssid", true)->value();
     String pass = req->getParam("pass", true)->value();
-    prefs.begin("wifi", false);
-    prefs.putString("ssid", ssid);
-    prefs.putString("pass", pass);
-    prefs.end();
-    savedSsid = ssid; savedPass = pass;
+    int known = findWifi(ssid);
+    if (pass.length()==0 && known>=0) pass = gNets.net[known].pass;  // the page never echoes it
+    addWifi(ssid, pass);
     req->send(200, "text/html", "<meta http-equiv='refresh' content='2;url=/' /><h3>Saved. Rebooting…</h3>");
     delay(500);
     ESP.restart();
@@ -576,116 +279,384 @@ void setupWeb(){
 
   // Saved networks management
   server.on("/wifi_list", HTTP_GET, [](AsyncWebServerRequest* r){
+    adoptBuiltin();
     String out="[";
-    for (int i=0;i<gNetCount;i++){ if(i) out+=","; out+="{\"ssid\":\""+gNets[i].ssid+"\"}"; }
+    for (int i=0;i<gNets.count;i++){ if(i) out+=","; out+=String("{\"ssid\":\"")+gNets.net[i].ssid+"\"}"; }
     out+="]";
     r->send(200,"application/json",out);
   });
   server.on("/wifi_add", HTTP_POST, [](AsyncWebServerRequest* req){
+    MET_HANDLER(MH_WIFI);
     String ssid = req->getParam("ssid", true)->value();
     String pass = req->getParam("pass", true)->value();
     bool ok = addWifi(ssid, pass);
     req->send(200,"application/json", String("{\"ok\":")+(ok?"true":"false")+"}");
   });
   server.on("/wifi_del", HTTP_GET, [](AsyncWebServerRequest* req){
+    MET_HANDLER(MH_WIFI);
     int idx = req->hasParam("i") ? req->getParam("i")->value().toInt() : -1;
     bool ok = delWifi(idx);
     req->send(200,"application/json", String("{\"ok\":")+(ok?"true":"false")+"}");
   });
+  // Asks loop()'s connection manager for a rescan; progress shows in /whoami
   server.on("/wifi_try", HTTP_GET, [](AsyncWebServerRequest* r){
-    bool ok=false;
-    for (int i=0;i<gNetCount && !ok;i++){
-      ok = tryConnectSTA(gNets[i].ssid.c_str(), gNets[i].pass.c_str(), 7000);
+    gWifiRetry = true;
+    r->send(200,"application/json","{\"started\":true}");
+  });
+
+  // Output segment map: GET shows it, POST segs=pin:count[:mA],... saves and reboots
+  server.on("/layout", HTTP_GET, [](AsyncWebServerRequest* r){
+    String out="{\"segs\":[";
+    for (int i=0;i<gLayout.count;i++){ if(i) out+=","; out+=String("{\"pin\":")+gLayout.seg[i].pin+",\"count\":"+gLayout.seg[i].count+",\"ma\":"+gLayout.seg[i].ma+"}"; }
+    out+=String("],\"max\":")+NUM_LEDS+",\"wire_us\":"+layoutWireUs(gLayout)+"}";
+    r->send(200,"application/json",out);
+  });
+  server.on("/layout", HTTP_POST, [](AsyncWebServerRequest* req){
+    Layout l;
+    if (!req->hasParam("segs", true) || !layoutParse(req->getParam("segs", true)->value().c_str(), l)){
+      req->send(400,"application/json","{\"ok\":false}");
+      return;
     }
-    if(!ok) startAP();
-    r->send(200,"application/json", String("{\"connected\":")+(ok?"true":"false")+"}");
+    layoutSave(l);
+    req->send(200,"application/json","{\"ok\":true,\"reboot\":true}");
+    delay(500);
+    ESP.restart();
   });
 
   // Receive schedule as JSON: {"items":[{"mode":0,"seconds":10}, ...]}
-  server.on("/schedule", HTTP_POST, [](AsyncWebServerRequest* req){}, NULL,
-    [](AsyncWebServerRequest* req, uint8_t* data, size_t len, size_t, size_t){
-      gScheduleCount = 0;
-      String body; body.reserve(len+1);
-      for(size_t i=0;i<len;i++) body += (char)data[i];
-      int pos = 0;
-      while (gScheduleCount < MAX_SCHEDULE_ITEMS){
-        int mPos = body.indexOf("\"mode\"", pos); if(mPos<0) break;
-        int colon = body.indexOf(':', mPos); if(colon<0) break;
-        int comma = body.indexOf(',', colon); int endBrace = body.indexOf('}', colon);
-        int stop = (comma<0? endBrace : min(comma,endBrace));
-        uint8_t mode = (uint8_t) body.substring(colon+1, stop).toInt();
-
-        // prefer "seconds", fallback to "minutes"
-        int tPos = body.indexOf("\"seconds\"", stop);
-        bool usedSeconds = true;
-        if (tPos < 0) { tPos = body.indexOf("\"minutes\"", stop); usedSeconds = false; }
-        if (tPos<0) break;
-        int tColon = body.indexOf(':', tPos); if(tColon<0) break;
-        int tComma = body.indexOf(',', tColon); int tEnd = body.indexOf('}', tColon);
-        int tStop = (tComma<0? tEnd : min(tComma,tEnd));
-        uint32_t amount = (uint32_t) body.substring(tColon+1, tStop).toInt();
-        uint32_t durMs = usedSeconds ? (amount*1000UL) : (amount*60UL*1000UL);
-
-        gSchedule[gScheduleCount++] = { mode, durMs };
-        pos = tStop;
+  // Body chunks go through the streaming parser as they arrive; the staging
+  // schedule is published only once the whole document has parsed. A new
+  // upload takes the parser over, and the one it displaced gets a 409.
+  server.on("/schedule", HTTP_POST, [](AsyncWebServerRequest* req){
+      MET_HANDLER(MH_SCHEDULE);
+      char out[48];
+      if (req != gSchedOwner){ req->send(gSchedOwner ? 409 : 400, "application/json", "{\"error\":\"no body\"}"); return; }
+      gSchedOwner = nullptr;
+      if (!gSchedOk){
+        snprintf(out, sizeof(out), "{\"error\":%u}", (unsigned)gSchedParser.errorAt());
+        req->send(400, "application/json", out);
+        return;
       }
-      gScheduleIndex = 0;
-      gSchedStart = millis();
-      gScheduleEnabled = (gScheduleCount>0);
-      req->send(200, "application/json", String("{\"count\":") + gScheduleCount + "}");
+      gSchedPub.write(gSchedParser.result());  // loop() restarts the timeline when it picks this up
+      snprintf(out, sizeof(out), "{\"count\":%u,\"dropped\":%u}", gSchedParser.result().count, gSchedParser.dropped());
+      req->send(200, "application/json", out);
+    }, NULL,
+    [](AsyncWebServerRequest* req, uint8_t* data, size_t len, size_t index, size_t total){
+      MET_HANDLER(MH_SCHEDULE);
+      if (index == 0){
+        gSchedOwner = req; gSchedParser.begin(); gSchedOk = true;
+        // an aborted upload must not leave a pointer to the freed request behind
+        req->onDisconnect([req]{ if (gSchedOwner == req) gSchedOwner = nullptr; });
+      }
+      if (req != gSchedOwner) return;
+      gSchedOk = gSchedParser.feed(data, len);
+      if (index + len >= total) gSchedOk = gSchedOk && gSchedParser.finish();
     }
   );
 
+  // Pixel positions, three integers per pixel in strip order, any unit and
+  // any separators: "x,y,z" lines or [[x,y,z],...]. Same streaming scheme as
+  // /schedule. The count must match the strip. DELETE goes back to 1D.
+  server.on("/map", HTTP_GET, [](AsyncWebServerRequest* r){
+    char out[48];
+    snprintf(out, sizeof(out), "{\"pixels\":%u,\"active\":%s}", gMap.count, mapActive() ? "true" : "false");
+    r->send(200, "application/json", out);
+  });
+  server.on("/map", HTTP_POST, [](AsyncWebServerRequest* req){
+      MET_HANDLER(MH_MAP);
+      char out[48];
+      if (req != gMapOwner){ req->send(gMapOwner ? 409 : 400, "application/json", "{\"error\":\"no body\"}"); return; }
+      gMapOwner = nullptr;
+      if (!gMapHeld){ req->send(409, "application/json", "{\"error\":\"busy\"}"); return; }
+      gMapHeld = false;
+      uint16_t n = 0;
+      if (!gMapOk || !gMapParser.finish(mapXyz(), n) || n != gNumLeds){
+        scratchGive();
+        snprintf(out, sizeof(out), "{\"error\":\"pixels\",\"got\":%u,\"want\":%u}", gMapParser.pixels(), gNumLeds);
+        req->send(400, "application/json", out);
+        return;
+      }
+      if (!mapSave(mapXyz(), n)){ scratchGive(); req->send(507, "application/json", "{\"error\":\"storage\"}"); return; }   // NVS full; the old map stays
+      gMapCount = n; gMapPending = true;
+      snprintf(out, sizeof(out), "{\"pixels\":%u}", n);
+      req->send(200, "application/json", out);
+    }, NULL,
+    [](AsyncWebServerRequest* req, uint8_t* data, size_t len, size_t index, size_t total){
+      MET_HANDLER(MH_MAP);
+      if (index == 0){
+        if (gMapOwner) return;   // one upload at a time
+        gMapOwner = req; gMapOk = true;
+        // busy while loop() still applies the last map or the preview is mid-frame
+        gMapHeld = !gMapPending && scratchTake(SCRATCH_MAP);
+        if (gMapHeld) gMapParser.begin((int16_t*)gScratch);
+        req->onDisconnect([req]{   // an upload cut off before the handler ran
+          if (gMapOwner != req) return;
+          gMapOwner = nullptr;
+          if (gMapHeld){ gMapHeld = false; scratchGive(); }
+        });
+      }
+      if (req != gMapOwner || !gMapHeld) return;
+      gMapOk = gMapOk && gMapParser.feed(data, len);
+    }
+  );
+  server.on("/map", HTTP_DELETE, [](AsyncWebServerRequest* r){
+    if (gMapPending || gMapOwner){ r->send(409, "application/json", "{\"error\":\"busy\"}"); return; }
+    if (!mapSave(mapXyz(), 0)){ r->send(500, "application/json", "{\"error\":\"storage\"}"); return; }
+    gMapCount = 0; gMapPending = true;
+    r->send(200, "application/json", "{\"pixels\":0}");
+  });
+
+  // Binary control channel (see ctrl_proto.h); single-frame messages only
+  ws.onEvent([](AsyncWebSocket*, AsyncWebSocketClient*, AwsEventType type, void* arg, uint8_t* data, size_t len){
+    if (type != WS_EVT_DATA) return;
+    AwsFrameInfo* info = (AwsFrameInfo*)arg;
+    if (!info->final || info->index != 0 || info->len != len || info->opcode != WS_BINARY) return;
+    MET_HANDLER(MH_CTRL);
+    // decoded into a copy: a frame that stops at a bad pair changes nothing
+    Params p = paramsEdit();
+    CtrlResult r = ctrlDecode(data, len, p);
+    if (!r.ok) return;
+    if (r.params){ paramsEdit() = p; paramsPublish(); }
+    while (r.ripples--) gRippleQ.push(-1);
+  });
+  server.addHandler(&ws);
+
+  // Live preview viewers; a new one needs a key frame to start from
+  preview.onEvent([](AsyncWebSocket*, AsyncWebSocketClient*, AwsEventType type, void*, uint8_t*, size_t){
+    if (type == WS_EVT_CONNECT) gPreviewKey = true;
+  });
+  server.addHandler(&preview);
+
+  // Estimated current after limiting, whole install and per segment
+  server.on("/power", HTTP_GET, [](AsyncWebServerRequest* r){
+    static PowerOut po = {};
+    static uint32_t seq = 0;
+    gPowerPub.read(po, seq);   // contended: the previous frame's numbers
+    String j = String("{\"ma\":") + po.totalMa + ",\"max_ma\":" + MAX_MA + ",\"clamped\":" + (po.clamped ? "true" : "false") + ",\"segs\":[";
+    for (uint8_t i = 0; i < gLayout.count; i++){
+      if (i) j += ",";
+      j += String("{\"ma\":") + po.ma[i] + ",\"budget\":" + gLayout.seg[i].ma + ",\"scale\":" + po.scale[i] + "}";
+    }
+    r->send(200, "application/json", j + "]}");
+  });
+
+  // Frame pacing over the last second: rendered and sent fps, loop() busy time
+  server.on("/pace", HTTP_GET, [](AsyncWebServerRequest* r){
+    static PaceStats ps = {};
+    static uint32_t seq = 0;
+    gPacePub.read(ps, seq);
+    char out[192];
+    snprintf(out, sizeof(out), "{\"target_fps\":%u,\"period_us\":%u,\"fps\":%u.%u,\"shown_fps\":%u.%u,\"duty_pct\":%u.%u,"
+             "\"frames\":%u,\"shown\":%u,\"unchanged\":%u,\"dropped\":%u}",
+             ps.targetFps, ps.periodUs, ps.fpsX10 / 10, ps.fpsX10 % 10, ps.shownX10 / 10, ps.shownX10 % 10,
+             ps.dutyX10 / 10, ps.dutyX10 % 10, ps.frames, ps.shown, ps.unchanged, ps.dropped);
+    r->send(200, "application/json", out);
+  });
+
+#if METRICS
+  // Instrumentation snapshot (metrics.h); built in a static buffer, no heap
+  server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest* r){
+    MET_HANDLER(MH_METRICS);
+    static char buf[METRICS_JSON_MAX];
+    MetSystem s = { ESP.getFreeHeap(), ESP.getMinFreeHeap(), ESP.getMaxAllocHeap(),
+                    uxTaskGetStackHighWaterMark(gLoopTask), uxTaskGetStackHighWaterMark(gTxTask),
+                    gPipe.published(), gPipe.transmitted(),
+                    gRt.stats.packets, gRt.stats.frames, gRt.stats.lost, gRt.stats.ignored, millis() };
+    size_t n = metricsJson(gMet, s, buf, sizeof(buf));
+    r->send(n ? 200 : 500, "application/json", n ? buf : "{}");
+  });
+#endif
+
+  gRt.begin();   // DDP :4048, E1.31 :5568
+
   server.begin();
 }
 
+// ---- Live preview ----
+// Encodes the last frame sent at gPreviewFps for /preview viewers. If any viewer
+// is still backed up the frame is dropped for everyone, which keeps the next
+// delta valid without per-client state; nothing here waits on the network.
+// Every PREVIEW_KEY_MS the frame is a key frame regardless (see preview.h).
+// Its buffers are the scratch block; while a map upload holds that, no frames.
+void previewTick(uint32_t now, const CRGB* shown){
+  static uint32_t last = 0, lastKey = 0;
+  CRGB* prev = (CRGB*)gScratch;
+  uint8_t* buf = gScratch + NUM_LEDS * 3;
+  if (!gPreviewFps || !preview.count() || now - last < 1000u / gPreviewFps) return;
+  last = now;
+  if (!preview.availableForWriteAll()){ MET_COUNT(previewDrops); return; }
+  if (!scratchTake(SCRATCH_PREVIEW)) return;   // a map upload has the block
+  bool key = gPreviewKey.exchange(false) || now - lastKey >= PREVIEW_KEY_MS;
+  if (key) lastKey = now;
+  size_t len = previewEncode(shown, prev, gNumLeds, key, buf);
+  preview.binaryAll(buf, len);   // copies buf into the socket's message
+  gScratchUse = SCRATCH_FREE;
+}
+
+// ---- Frame pacing ----
+// The frame rate in effect: the target, but no faster than the strip can be
+// clocked out. The compositor gets the same period as its budget.
+uint8_t paceFps(){ return !gTargetFps ? PACE_FPS : gTargetFps > PACE_MAX_FPS ? PACE_MAX_FPS : gTargetFps; }
+uint32_t pacePeriodUs(){ return max(layoutWireUs(gLayout), (uint32_t)(1000000 / paceFps())); }
+
+// Blocks loop() until the next frame is due. The idle task gets the core and
+// gates its clock. esp_light_sleep_start() would stop the web and transmit
+// tasks along with loop(), so light sleep is left to tickless idle: with
+// power management built in (CONFIG_PM_ENABLE), gAwake is let go while the
+// scene is unchanged and the last frame is off the wire. The clock scales
+// down between frames too: gFast holds it at the maximum from the start of a
+// render (paceWake) until the frame is off the wire.
+#if CONFIG_PM_ENABLE
+esp_pm_lock_handle_t gAwake = nullptr, gFast = nullptr;
+bool gFastHeld = true;
+#endif
+void paceWake(){
+#if CONFIG_PM_ENABLE
+  if (!gFastHeld){ esp_pm_lock_acquire(gFast); gFastHeld = true; }
+#endif
+}
+void paceSleep(uint32_t us){
+#if CONFIG_PM_ENABLE
+  static bool held = true;
+  const bool sent = gPipe.transmitted() == gPipe.published();
+  bool quiet = gPacer.idle() && sent;
+  if (quiet == held){ held = !quiet; if (held) esp_pm_lock_acquire(gAwake); else esp_pm_lock_release(gAwake); }
+  if (sent && gFastHeld){ esp_pm_lock_release(gFast); gFastHeld = false; }
+#endif
+  gPacer.sleeping(micros());
+  vTaskDelay(us >= 2000 ? pdMS_TO_TICKS(us / 1000) : 1);
+}
+
+// ---- LED transmit task ----
+// Runs on the core loop() is not on. It clocks published frames out over RMT
+// (all segments in parallel) while loop() renders the next one into the other
+// pipeline buffer.
+void ledTxTask(void*){
+  for(;;){
+    FramePipe::Frame f = gPipe.acquire();
+    layoutShow(f.px, f.scale);
+    gPipe.release();
+  }
+}
+
 void setup(){
   delay(200);
-  FastLED.addLeds<LED_TYPE, LED_PIN, COLOR_ORDER>(leds, NUM_LEDS);
+  layoutLoad();      // sets gNumLeds from the saved segment map
+  mapLoad(mapXyz());  // unused unless it covers the whole strip; the preview has the block after this
+  Params saved;
+  if (gScene.load(saved, gSched)){ paramsRestore(saved); gSchedPub.write(gSched); }  // loop() starts it
+  layoutAttach();
   FastLED.setCorrection(TypicalLEDStrip);
-  FastLED.setMaxPowerInVoltsAndMilliamps(5, MAX_MA);
   FastLED.setBrightness(gBrightness);
   fill_solid(leds, NUM_LEDS, CRGB::Black); FastLED.show();
-
-  setupFireflies();
-  for(auto &r:rip) r.on=false;
-
+  gLoopTask = xTaskGetCurrentTaskHandle();
+  xTaskCreatePinnedToCore(ledTxTask, "ledtx", 4096, nullptr, 2, &gTxTask, 1 - ARDUINO_RUNNING_CORE);
+#if METRICS
+  gMet.budget = layoutWireUs(gLayout) * MET_TICKS_PER_US;
+#endif
+#if CONFIG_PM_ENABLE
+  esp_pm_config_esp32_t pm = { 240, 80, true };   // MHz max, min; light sleep when idle
+  esp_pm_configure(&pm);
+  esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "frames", &gAwake);
+  esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "render", &gFast);
+  esp_pm_lock_acquire(gAwake);
+  esp_pm_lock_acquire(gFast);
+#endif
+
+  effectsReset(esp_random());   // the hardware RNG seeds the effect streams once
+
+  paramsInit();
   setupWiFi();
   setupWeb();
-  lastFrame = millis();
+  // rendering up to the frame period is free, the next frame is not due sooner
+  gPacer.begin(micros(), pacePeriodUs());
+  gComp.setBudget(gPacer.period());
 
   gScheduleEnabled = false;
-  gScheduleCount = 0;
   gScheduleIndex = 0;
   gSchedStart = millis();
 }
 
 void loop(){
+  // Sleep until the next step is due; realtime ingest is not paced, it goes
+  // out as packets land. Modes run on the pacer's clock and fixed dt.
+  const uint32_t us = micros();
+  const bool paced = !gRt.active();
+  if (!paced) gPacer.hold(us);
+  else if (uint32_t w = gPacer.wait(us)){ paceSleep(w); return; }
+  paceWake();
   tMs = millis();
-  float dt = (tMs - lastFrame) / 1000.0f; lastFrame = tMs;
+  float dt = paced ? gPacer.step() : 0;
+  gFrameMs = gPacer.clockMs();
+
+  // One consistent snapshot of web-side state per frame
+  if (paramsApply()){
+    gScene.touch(tMs);
+    if (gPacer.period() != pacePeriodUs()){ gPacer.setPeriod(pacePeriodUs()); gComp.setBudget(gPacer.period()); }
+  }
+  wifiTick(tMs);
+  int16_t rc;
+  while (gRippleQ.pop(rc)) triggerRipple(rc);
+  if (gSchedPub.read(gSched, gSchedSeq)){
+    gScheduleIndex = 0;
+    gSchedStart = tMs;
+    gScheduleEnabled = (gSched.count>0);
+    if (gScheduleEnabled){ gComp.crossfade(gSched.items[0].xfade_ms); schedEnter(gSched.items[0]); }
+    gScene.touch(tMs);
+  }
+  gScene.tick(tMs, paramsCurrent(), gSched);
+  if (gMapPending){
+    gMap.build(mapXyz(), gMapCount);
+    if (gMapCount) scratchGive();   // an upload's block; a delete holds none
+    gMapPending = false;
+  }
 
   // Scheduler: advance mode when duration expires
-  if (gScheduleEnabled && gScheduleCount > 0){
-    if (tMs - gSchedStart >= gSchedule[gScheduleIndex].duration_ms){
-      gScheduleIndex = (gScheduleIndex + 1) % gScheduleCount;
-      gMode = gSchedule[gScheduleIndex].mode;
+  if (gScheduleEnabled && gSched.count > 0){
+    if (tMs - gSchedStart >= gSched.items[gScheduleIndex].duration_ms){
+      gScheduleIndex = (gScheduleIndex + 1) % gSched.count;
+      gComp.crossfade(gSched.items[gScheduleIndex].xfade_ms);
+      schedEnter(gSched.items[gScheduleIndex]);
       gSchedStart = tMs;
     }
   }
 
-  // Base mode render
-  switch(gMode){
-    case 0: stepFireflies(dt); break;
-    case 1: stepSync(tMs/1000.0f); break;
-    case 2: stepWave(tMs/1000.0f); break;
-    case 3: stepTwinkle(dt); break;
-    case 4: stepSwarm(tMs/1000.0f); break;
-    case 5: stepRipples(dt); break; // standalone ripple mode
-  }
-
-  // Ripple overlay (works on any base mode)
-  stepRipplesOverlay(dt);
-
-  FastLED.setBrightness(gBrightness);
-  FastLED.show();
+  // Realtime ingest: while a show controller is streaming it owns leds[] and
+  // the built-in modes pause; a frame goes out when its last packet lands.
+  // Otherwise the compositor draws the modes and blends them straight into
+  // the pipeline buffer, which back() only waits for if the transmit task is
+  // a whole frame behind. leds[] keeps the base mode's state either way.
+  // Network frames bypass the effect kernels, so their power sums are taken
+  // during the copy, and they are marked lit for the fades that follow them.
+  static const CRGB* shown = leds;
+  CRGB* out = gPipe.back();
+  MET_T0(t0);
+  bool fresh = gRt.poll(leds, gNumLeds), rt = gRt.active();
+  static bool wasRt = false;
+  // Handed back (timeout or stream end): packets since the last whole frame
+  // wrote leds[] directly, so the lit set and sums are rebuilt before a mode
+  // fades what is there.
+  if (wasRt && !rt){ gLit.markAll(gNumLeds); powerScan(leds, gNumLeds); }
+  wasRt = rt;
+  if (!rt){ gComp.frame(out, dt); fresh = true; }
+  if (fresh) MET_FRAME(rt ? MET_RT : gMode, t0);
+
+  if (fresh){
+    if (rt){ powerCopy(out, leds, gNumLeds); gLit.markAll(gNumLeds); }
+    shown = out;
+    MET_T0(t1);
+    PowerOut po;
+    powerLimit(gLayout, gBrightness, MAX_MA, po);
+    MET_STAGE(MS_POWER, t1);
+    if (po.clamped) MET_COUNT(clamped);
+    gPowerPub.write(po);
+    // an unchanged frame stays off the wire; back() hands its buffer out again
+    if (gPacer.changed(frameHash(out, gNumLeds, gBrightness, po.scale, gLayout.count), tMs)) gPipe.publish(gBrightness, po.scale);
+  } else delay(1);   // streaming, between frames
+  PaceStats ps;
+  if (gPacer.report(micros(), paceFps(), ps)) gPacePub.write(ps);
+
+  previewTick(tMs, shown);
+  static uint32_t wsCleanup = 0;  // AsyncWebSocket keeps closed clients until asked
+  if (tMs - wsCleanup > 1000){ ws.cleanupClients(); preview.cleanupClients(); wsCleanup = tMs; }
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "metrics.h"
+#if METRICS
+#include <stdarg.h>
+#include <stdio.h>
+
+#if defined(ARDUINO) && CONFIG_PM_ENABLE
+#include <esp_timer.h>
+uint32_t metTicks(){ return (uint32_t)esp_timer_get_time(); }
+#elif defined(ARDUINO)
+#include <Arduino.h>
+uint32_t metTicks(){ return ESP.getCycleCount(); }
+#else
+#include <chrono>
+uint32_t metTicks(){
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+Metrics gMet;
+
+static const char* const kStages[MS_COUNT] = { "render", "power", "show" };
+static const char* const kHandlers[MH_COUNT] = { "asset", "set", "ctrl", "schedule", "wifi", "metrics", "map" };
+
+// Appends to a fixed buffer; once anything fails to fit the whole result is 0.
+struct Out {
+  char* p; size_t cap, len; bool full;
+  void add(const char* fmt, ...){
+    if (full) return;
+    va_list a; va_start(a, fmt);
+    int n = vsnprintf(p + len, cap - len, fmt, a);
+    va_end(a);
+    if (n < 0 || (size_t)n >= cap - len) full = true; else len += n;
+  }
+  void fields(const MetTimer& t){
+    add("\"n\":%u,\"avg_us\":%u,\"max_us\":%u", t.n, t.n ? (unsigned)(t.sum / t.n / MET_TICKS_PER_US) : 0u, t.max / MET_TICKS_PER_US);
+  }
+  void timer(const char* name, const MetTimer& t){ add("\"%s\":{", name); fields(t); add("}"); }
+};
+
+size_t metricsJson(const Metrics& m, const MetSystem& s, char* out, size_t cap){
+  Out o = { out, cap, 0, cap == 0 };
+  o.add("{\"uptime_ms\":%u,\"frames\":{", s.uptimeMs);
+  bool first = true;
+  for (uint8_t i = 0; i < MET_MODES; i++){
+    const MetHist& h = m.frame[i];
+    if (!h.t.n) continue;
+    o.add(first ? "" : ","); first = false;
+    o.add("\"%s\":{", i == MET_RT ? "realtime" : modeName(i));
+    o.fields(h.t);
+    o.add(",\"hist\":[");
+    uint8_t last = MET_BUCKETS;
+    while (last > 1 && !h.bucket[last - 1]) last--;
+    for (uint8_t b = 0; b < last; b++) o.add(b ? ",%u" : "%u", h.bucket[b]);
+    o.add("]}");
+  }
+  o.add("},\"stages\":{");
+  for (uint8_t i = 0; i < MS_COUNT; i++){ o.add(i ? "," : ""); o.timer(kStages[i], m.stage[i]); }
+  o.add("},\"handlers\":{");
+  for (uint8_t i = 0; i < MH_COUNT; i++){ o.add(i ? "," : ""); o.timer(kHandlers[i], m.handler[i]); }
+  o.add("},\"late\":%u,\"clamped\":%u,\"preview_drops\":%u,\"throttled\":%u,\"budget_us\":%u", m.late, m.clamped, m.previewDrops, m.throttled, m.budget / MET_TICKS_PER_US);
+  o.add(",\"pipe\":{\"published\":%u,\"transmitted\":%u}", s.published, s.transmitted);
+  o.add(",\"realtime\":{\"packets\":%u,\"frames\":%u,\"lost\":%u,\"ignored\":%u}", s.rtPackets, s.rtFrames, s.rtLost, s.rtIgnored);
+  o.add(",\"heap\":{\"free\":%u,\"min\":%u,\"max_alloc\":%u},\"stack_free\":{\"loop\":%u,\"ledtx\":%u}}",
+        s.heapFree, s.heapMin, s.heapMaxAlloc, s.stackLoop, s.stackTx);
+  return o.full ? 0 : o.len;
+}
+#endif
@@ -0,0 +1,104 @@
+#include "noise_row.h"
+#include "pixmap.h"
+
+uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z);   // FastLED's; its header clashes with the helpers below
+
+// Ken Perlin's permutation, as used by FastLED's noise.cpp (not exported there).
+static const uint8_t P_[] = {
+  151,160,137,91,90,15,131,13,201,95,96,53,194,233,7,225,140,36,103,30,69,142,8,99,37,240,21,10,23,
+  190,6,148,247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,57,177,33,88,237,149,56,87,174,
+  20,125,136,171,168,68,175,74,165,71,134,139,48,27,166,77,146,158,231,83,111,229,122,60,211,133,
+  230,220,105,92,41,55,46,245,40,244,102,143,54,65,25,63,161,1,216,80,73,209,76,132,187,208,89,18,
+  169,200,196,135,130,116,188,159,86,164,100,109,198,173,186,3,64,52,217,226,250,124,123,5,202,38,
+  147,118,126,255,82,85,212,207,206,59,227,47,16,58,17,182,189,28,42,223,183,170,213,119,248,152,2,
+  44,154,163,70,221,153,101,155,167,43,172,9,129,22,39,253,19,98,108,110,79,113,224,232,178,185,
+  112,104,218,246,97,228,251,34,242,193,238,210,144,12,191,179,162,241,81,51,145,235,249,14,239,
+  107,49,192,214,31,181,199,106,157,184,84,204,176,115,121,50,45,127,4,150,254,138,236,205,93,222,
+  114,67,29,24,72,243,141,128,195,78,66,215,61,156,180,151 };
+#define P(x) P_[(uint8_t)(x)]
+
+static inline uint8_t scale8(uint8_t i, uint8_t s){ return ((uint16_t)i * (1 + s)) >> 8; }
+static inline int8_t avg7(int8_t i, int8_t j){ return (i >> 1) + (j >> 1) + (i & 0x1); }
+static inline uint8_t ease8(uint8_t i){
+  uint8_t j = i; if (j & 0x80) j = 255 - j;
+  uint8_t jj2 = scale8(j, j) << 1;
+  if (i & 0x80) jj2 = 255 - jj2;
+  return jj2;
+}
+static inline int8_t lerp7by8(int8_t a, int8_t b, uint8_t frac){
+  if (b > a){ uint8_t d = b - a; return a + scale8(d, frac); }
+  uint8_t d = a - b; return a - scale8(d, frac);
+}
+static inline int8_t grad8(uint8_t hash, int8_t x, int8_t y){
+  int8_t u, v;
+  if (hash & 4){ u = y; v = x; } else { u = x; v = y; }
+  if (hash & 1) u = -u;
+  if (hash & 2) v = -v;
+  return avg7(u, v);
+}
+
+void noiseRow8(uint8_t* out, uint16_t n, uint16_t x0, uint16_t dx, uint16_t y){
+  const uint8_t Y = y >> 8, v = ease8((uint8_t)y);
+  const int8_t yy = ((uint8_t)y >> 1) & 0x7F, yyN = yy - 0x80;
+  uint16_t x = x0;
+  uint16_t i = 0;
+  while (i < n){
+    // hashes for the lattice cell containing x
+    const uint8_t X = x >> 8;
+    const uint8_t A = P(X) + Y, B = P(X + 1) + Y;
+    const uint8_t hAA = P(P(A)), hAB = P(P(A + 1)), hBA = P(P(B)), hBB = P(P(B + 1));
+    do {
+      const uint8_t u = ease8((uint8_t)x);
+      const int8_t xx = ((uint8_t)x >> 1) & 0x7F, xxN = xx - 0x80;
+      int8_t X1 = lerp7by8(grad8(hAA, xx, yy), grad8(hBA, xxN, yy), u);
+      int8_t X2 = lerp7by8(grad8(hAB, xx, yyN), grad8(hBB, xxN, yyN), u);
+      int8_t r = lerp7by8(X1, X2, v) + 64;
+      unsigned q = (unsigned)(uint8_t)r * 2;
+      out[i++] = q > 255 ? 255 : (uint8_t)q;
+      x += dx;
+    } while (i < n && (x >> 8) == X);
+  }
+}
+
+// Keyframes k and k+1 into a and b: both when rebuilding or jumping, one
+// row when time moved on by a single keyframe.
+template <typename Fill> void NoiseCache::advance(uint16_t k, bool rebuild, Fill fill){
+  if (rebuild){
+    fill(a, k); fill(b, k + NOISE_KEY_STEP);
+    key = k; valid = true;
+  } else if (k != key){
+    if (k == (uint16_t)(key + NOISE_KEY_STEP)){
+      for (uint16_t i = 0; i < n; i++) a[i] = b[i];
+      fill(b, k + NOISE_KEY_STEP);
+    } else {
+      fill(a, k); fill(b, k + NOISE_KEY_STEP);
+    }
+    key = k;
+  }
+}
+
+void NoiseCache::lerp(uint8_t* out, uint16_t count, uint16_t y, uint16_t k){
+  const uint8_t f = (uint8_t)((y - k) << (8 - NOISE_KEY_SHIFT));
+  for (uint16_t i = 0; i < count; i++){
+    int d = (int)b[i] - (int)a[i];
+    out[i] = a[i] + ((d * f) >> 8);
+  }
+}
+
+void NoiseCache::sample(uint8_t* out, uint16_t count, uint16_t x0_, uint16_t dx_, uint16_t y){
+  const uint16_t k = y & ~(NOISE_KEY_STEP - 1);
+  bool rebuild = !valid || map || count != n || x0_ != x0 || dx_ != dx;
+  if (rebuild){ n = count; x0 = x0_; dx = dx_; map = 0; }
+  advance(k, rebuild, [this](uint8_t* row, uint16_t ky){ noiseRow8(row, n, x0, dx, ky); });
+  lerp(out, count, y, k);
+}
+
+void NoiseCache::sampleMap(uint8_t* out, const PixMap& m, uint8_t s, uint16_t t){
+  const uint16_t k = t & ~(NOISE_KEY_STEP - 1);
+  bool rebuild = !valid || map != m.version || n != m.count || x0 != s;
+  if (rebuild){ n = m.count; x0 = s; dx = 0; map = m.version; }
+  advance(k, rebuild, [&m, s, this](uint8_t* row, uint16_t kt){
+    for (uint16_t i = 0; i < n; i++) row[i] = inoise8(m.x[i] * s, m.y[i] * s, (uint16_t)(m.z[i] * s + kt));
+  });
+  lerp(out, m.count, t, k);
+}
@@ -0,0 +1,82 @@
+#include <string.h>
+#include <FastLED.h>
+#include "pacer.h"
+
+uint8_t gTargetFps = PACE_FPS;
+FramePacer gPacer;
+SeqLock<PaceStats> gPacePub;
+
+void FramePacer::begin(uint32_t nowUs, uint32_t periodUs){
+  *this = FramePacer();
+  setPeriod(periodUs);
+  mLast = mWinStart = nowUs;
+  mAcc = mPeriod;   // the first frame is due at once
+}
+
+uint32_t FramePacer::wait(uint32_t nowUs){
+  if (mAsleep){ mSleptUs += nowUs - mSleepAt; mAsleep = false; }
+  mAcc += nowUs - mLast; mLast = nowUs;
+  const uint32_t cap = PACE_MAX_STEPS * mPeriod;
+  if (mAcc > cap){   // whole periods only: the remainder stays due
+    const uint32_t k = (mAcc - cap + mPeriod - 1) / mPeriod;
+    mDropped += k; mAcc -= k * mPeriod;
+  }
+  return mAcc >= mPeriod ? 0 : mPeriod - mAcc;
+}
+
+float FramePacer::step(){
+  mAcc = mAcc > mPeriod ? mAcc - mPeriod : 0;
+  mFrameUs = mClockUs; mClockUs += mPeriod;
+  mFrames++; mWinFrames++;
+  return mPeriod / 1000000.0f;
+}
+
+void FramePacer::hold(uint32_t nowUs){
+  if (mAsleep){ mSleptUs += nowUs - mSleepAt; mAsleep = false; }
+  mLast = nowUs; mAcc = 0;
+}
+
+bool FramePacer::changed(uint32_t hash, uint32_t nowMs){
+  if (mShownAny && hash == mHash && nowMs - mShownMs < PACE_REFRESH_MS){ mUnchanged++; mIdle = true; return false; }
+  mHash = hash; mShownMs = nowMs; mShownAny = true; mIdle = false;
+  mShown++; mWinShown++;
+  return true;
+}
+
+bool FramePacer::report(uint32_t nowUs, uint16_t targetFps, PaceStats& out){
+  const uint32_t span = nowUs - mWinStart;
+  if (span < PACE_WINDOW_US) return false;
+  const uint32_t slept = mSleptUs < span ? mSleptUs : span;
+  out.targetFps = targetFps;
+  out.fpsX10 = (uint16_t)((uint64_t)mWinFrames * 10000000 / span);
+  out.shownX10 = (uint16_t)((uint64_t)mWinShown * 10000000 / span);
+  out.dutyX10 = (uint16_t)((uint64_t)(span - slept) * 1000 / span);
+  if (mWinFrames){
+    const uint32_t busy = (span - slept) / mWinFrames;
+    uint32_t want = busy + busy / 16;
+    if (want < mTarget) want = mTarget;
+    if (want > mPeriod || want < mPeriod - mPeriod / 8) mPeriod = want;
+  }
+  out.periodUs = mPeriod;
+  out.frames = mFrames; out.shown = mShown; out.unchanged = mUnchanged; out.dropped = mDropped;
+  mWinStart = nowUs; mSleptUs = 0; mWinFrames = mWinShown = 0;
+  return true;
+}
+
+// xor, multiply by an odd constant, fold the top down: each step is a
+// bijection of h, so a frame differing in one word always hashes differently.
+static inline uint32_t mixWord(uint32_t h, uint32_t w){
+  h = (h ^ w) * 0x9E3779B1u;
+  return h ^ (h >> 15);
+}
+
+uint32_t frameHash(const CRGB* px, uint16_t n, uint8_t brightness, const uint8_t* scale, uint8_t segs){
+  const uint8_t* b = (const uint8_t*)__builtin_assume_aligned(px, 4);
+  const uint32_t bytes = (uint32_t)n * 3;
+  uint32_t h = 0x811C9DC5u ^ n, i = 0;
+  for (; i + 4 <= bytes; i += 4){ uint32_t w; memcpy(&w, b + i, 4); h = mixWord(h, w); }
+  for (; i < bytes; i++) h = mixWord(h, b[i]);
+  h = mixWord(h, brightness);
+  for (uint8_t s = 0; s < segs; s++) h = mixWord(h, scale[s]);
+  return h;
+}
@@ -0,0 +1,31 @@
+#include "palette.h"
+#include "effects.h"
+
+static CRGB valTab[256], hueTab[256], swarmTab[256];
+static int valKey = -1, hueKey = -1, swarmKey = -1;  // (hue<<8)|sat the table was built for
+
+const CRGB* palVal(){
+  int key = (gHueBase << 8) | gSaturation;
+  if (key != valKey){
+    for (int v = 0; v < 256; v++) valTab[v] = CHSV(gHueBase, gSaturation, v);
+    valKey = key;
+  }
+  return valTab;
+}
+
+const CRGB* palHue(){
+  if (gSaturation != hueKey){
+    for (int h = 0; h < 256; h++) hueTab[h] = CHSV(h, gSaturation, 255);
+    hueKey = gSaturation;
+  }
+  return hueTab;
+}
+
+const CRGB* palSwarm(){
+  int key = (gHueBase << 8) | gSaturation;
+  if (key != swarmKey){
+    for (int n = 0; n < 256; n++) swarmTab[n] = CHSV(gHueBase + scale8(n, 20), gSaturation, scale8(n, 220));
+    swarmKey = key;
+  }
+  return swarmTab;
+}
@@ -0,0 +1,61 @@
+#include "params.h"
+#include "effects.h"
+#include "pacer.h"
+#include "preview.h"
+
+SeqLock<Params>   gParamsPub;
+SeqLock<Schedule> gSchedPub;
+SpscQueue<int16_t, 16> gRippleQ;
+
+static Params   edit;       // web task's working copy
+static Params   applied;    // last snapshot loop() applied
+static uint32_t appliedSeq = 0;
+
+Params& paramsEdit(){ return edit; }
+void paramsPublish(){ gParamsPub.write(edit); }
+
+void paramsRestore(const Params& p){
+  gMode = p.mode; gBrightness = p.brightness; gDensity = p.density; gSpeed = p.speed;
+  gHueBase = p.hue; gSaturation = p.sat; gLifespan = p.lifespan; gFade = p.fade;
+  gAutoHueDrift = p.drift; gPreviewFps = p.preview; gTargetFps = p.fps;
+}
+
+Params paramsLive(){
+  return { gMode, gBrightness, gDensity, gSpeed, gHueBase, gSaturation, gLifespan, gFade, gAutoHueDrift, gPreviewFps, gTargetFps };
+}
+
+void paramsInit(){
+  edit = paramsLive();
+  applied = edit;
+  paramsPublish();
+  Params p; gParamsPub.read(p, appliedSeq);
+}
+
+bool paramsApply(){
+  Params p;
+  if (!gParamsPub.read(p, appliedSeq)) return false;
+  if (p.mode != applied.mode)             gMode = p.mode;
+  if (p.brightness != applied.brightness) gBrightness = p.brightness;
+  if (p.density != applied.density)       gDensity = p.density;
+  if (p.speed != applied.speed)           gSpeed = p.speed;
+  if (p.hue != applied.hue)               gHueBase = p.hue;
+  if (p.sat != applied.sat)               gSaturation = p.sat;
+  if (p.lifespan != applied.lifespan)     gLifespan = p.lifespan;
+  if (p.fade != applied.fade)             gFade = p.fade;
+  if (p.drift != applied.drift)           gAutoHueDrift = p.drift;
+  if (p.preview != applied.preview)       gPreviewFps = p.preview;
+  if (p.fps != applied.fps)               gTargetFps = p.fps;
+  applied = p;
+  return true;
+}
+
+const Params& paramsCurrent(){ return applied; }
+
+void schedEnter(const SchedItem& it){
+  gMode = it.mode;
+  uint8_t* dst[SF_COUNT] = { &gBrightness, &gDensity, &gSpeed, &gHueBase, &gSaturation, &gLifespan, &gFade, nullptr };
+  for (uint8_t f = 0; f < SF_COUNT; f++){
+    if (!(it.set & (1 << f))) continue;
+    if (dst[f]) *dst[f] = it.val[f]; else gAutoHueDrift = it.val[f];
+  }
+}
@@ -0,0 +1,84 @@
+#include "persist.h"
+#include <string.h>
+
+uint32_t crc32(const void* data, size_t len, uint32_t crc){
+  const uint8_t* p = (const uint8_t*)data;
+  crc = ~crc;
+  while (len--){
+    crc ^= *p++;
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+  }
+  return ~crc;
+}
+
+bool BlobSlot::load(KvStore& kv, void* buf, size_t len){
+  if (kv.get(key, buf, len) != len) return false;
+  crc = crc32(buf, len); known = true;
+  return true;
+}
+
+bool BlobSlot::save(KvStore& kv, const void* buf, size_t len){
+  uint32_t c = crc32(buf, len);
+  if (known && c == crc) return false;
+  if (!kv.put(key, buf, len)) return false;
+  crc = c; known = true;
+  return true;
+}
+
+static uint32_t sceneCrc(const SceneBlob& b){
+  return crc32(&b.params, sizeof(b) - offsetof(SceneBlob, params));
+}
+
+bool ScenePersist::load(Params& p, Schedule& s){
+  if (!mSlot.load(mKv, &mBlob, sizeof(mBlob))) return false;
+  if (mBlob.magic != SCENE_MAGIC || mBlob.version != SCENE_VERSION) return false;
+  if (mBlob.crc != sceneCrc(mBlob) || mBlob.schedule.count > MAX_SCHEDULE_ITEMS) return false;
+  p = mBlob.params;
+  s = mBlob.schedule;
+  return true;
+}
+
+void ScenePersist::touch(uint32_t now){
+  if (!mDirty) mFirst = now;
+  mDirty = true;
+  mLast = now;
+}
+
+bool ScenePersist::tick(uint32_t now, const Params& p, const Schedule& s){
+  if (!mDirty || (now - mLast < PERSIST_QUIET_MS && now - mFirst < PERSIST_MAX_MS)) return false;
+  mDirty = false;
+  // built from zero so padding and unused schedule slots never change the CRC
+  memset(&mBlob, 0, sizeof(mBlob));
+  mBlob.magic = SCENE_MAGIC; mBlob.version = SCENE_VERSION;
+  mBlob.params = p;
+  mBlob.schedule.count = s.count;
+  for (uint8_t i = 0; i < s.count && i < MAX_SCHEDULE_ITEMS; i++){
+    SchedItem& d = mBlob.schedule.items[i];
+    d.mode = s.items[i].mode; d.duration_ms = s.items[i].duration_ms; d.set = s.items[i].set; d.xfade_ms = s.items[i].xfade_ms;
+    memcpy(d.val, s.items[i].val, sizeof(d.val));
+  }
+  mBlob.crc = sceneCrc(mBlob);
+  if (mSlot.save(mKv, &mBlob, sizeof(mBlob))) return true;
+  if (!mSlot.known || mSlot.crc != crc32(&mBlob, sizeof(mBlob))) touch(now);   // not written: try again
+  return false;
+}
+
+#ifdef ARDUINO
+#include <Preferences.h>
+
+size_t NvsStore::get(const char* key, void* buf, size_t len){
+  Preferences p;
+  p.begin(mNs, true);
+  size_t n = p.getBytesLength(key) == len ? p.getBytes(key, buf, len) : 0;
+  p.end();
+  return n;
+}
+
+bool NvsStore::put(const char* key, const void* buf, size_t len){
+  Preferences p;
+  p.begin(mNs, false);
+  bool ok = p.putBytes(key, buf, len) == len;
+  p.end();
+  return ok;
+}
+#endif
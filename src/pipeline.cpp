@@ -0,0 +1,46 @@
+#include "pipeline.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+// Block on a task notification; the 1-tick timeout covers a wake that lands
+// between the counter check and the take.
+static void pipeWait(){ ulTaskNotifyTake(pdTRUE, 1); }
+static void pipeWake(void* task){ if (task) xTaskNotifyGive((TaskHandle_t)task); }
+static void* pipeSelf(){ return xTaskGetCurrentTaskHandle(); }
+#else
+#include <thread>
+static void pipeWait(){ std::this_thread::yield(); }
+static void pipeWake(void*){}
+static void* pipeSelf(){ return nullptr; }
+#endif
+
+FramePipe gPipe;
+
+CRGB* FramePipe::back(){
+  uint32_t k = mPublished.load(std::memory_order_relaxed);
+  if (!mRenderTask.load(std::memory_order_relaxed)) mRenderTask.store(pipeSelf());
+  // buffer k&1 last held frame k-2; it is free once that frame is released
+  while (k > mReleased.load(std::memory_order_acquire) + 1) pipeWait();
+  return mBuf[k & 1];
+}
+
+void FramePipe::publish(uint8_t brightness, const uint8_t* scale){
+  uint32_t k = mPublished.load(std::memory_order_relaxed);
+  mBright[k & 1] = brightness;
+  if (scale) memcpy(mScale[k & 1], scale, MAX_SEGMENTS); else memset(mScale[k & 1], brightness, MAX_SEGMENTS);
+  mPublished.store(k + 1, std::memory_order_release);
+  pipeWake(mTxTask.load());
+}
+
+FramePipe::Frame FramePipe::acquire(){
+  uint32_t k = mReleased.load(std::memory_order_relaxed);
+  if (!mTxTask.load(std::memory_order_relaxed)) mTxTask.store(pipeSelf());
+  while (mPublished.load(std::memory_order_acquire) == k) pipeWait();
+  return { mBuf[k & 1], mBright[k & 1], k, mScale[k & 1] };
+}
+
+void FramePipe::release(){
+  mReleased.store(mReleased.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  pipeWake(mRenderTask.load());
+}
@@ -0,0 +1,87 @@
+#include "pixmap.h"
+#include <string.h>
+#include "effects.h"
+
+PixMap gMap;
+
+bool mapActive(){ return gMap.count && gMap.count == gNumLeds; }
+
+void PixMap::build(const uint8_t* xyz, uint16_t n){
+  count = n;
+  if (!++version) version = 1;
+  // counting sort by cell: sizes, prefix sums, then place
+  memset(cellStart, 0, sizeof(cellStart));
+  for (uint16_t i = 0; i < n; i++){
+    x[i] = xyz[i * 3]; y[i] = xyz[i * 3 + 1]; z[i] = xyz[i * 3 + 2];
+    cellStart[cellOf(x[i], y[i], z[i]) + 1]++;
+  }
+  for (uint16_t c = 0; c < MAP_CELLS; c++) cellStart[c + 1] += cellStart[c];
+  uint16_t fill[MAP_CELLS];
+  memcpy(fill, cellStart, sizeof(fill));
+  for (uint16_t i = 0; i < n; i++) order[fill[cellOf(x[i], y[i], z[i])]++] = i;
+}
+
+// ---- Upload ----
+void MapParser::begin(int16_t* raw){
+  mRaw = raw;
+  mVals = 0; mCur = 0;
+  mIn = mNeg = mMinus = mFrac = mFracSeen = mRoundUp = mBad = false;
+}
+
+void MapParser::endNumber(){
+  if (!mIn) return;
+  mIn = false;
+  int32_t v = mCur + mRoundUp;
+  if (mNeg) v = -v;
+  if (v < -32768 || v > 32767 || mVals >= NUM_LEDS * 3){ mBad = true; return; }
+  mRaw[mVals++] = (int16_t)v;
+}
+
+bool MapParser::feed(const uint8_t* p, size_t n){
+  for (size_t i = 0; i < n && !mBad; i++){
+    uint8_t c = p[i];
+    if (c >= '0' && c <= '9'){
+      if (!mIn){ mIn = true; mCur = 0; mFrac = mFracSeen = mRoundUp = false; mNeg = mMinus; }
+      if (!mFrac){ if (mCur < 100000) mCur = mCur * 10 + (c - '0'); }
+      else if (!mFracSeen){ mRoundUp = c >= '5'; mFracSeen = true; }
+    } else if (c == '.' && mIn && !mFrac) mFrac = true;
+    else endNumber();
+    mMinus = c == '-';
+  }
+  return !mBad;
+}
+
+bool MapParser::finish(uint8_t* xyz, uint16_t& count){
+  endNumber();
+  if (mBad || !mVals || mVals % 3) return false;
+  count = mVals / 3;
+  int16_t lo[3] = { 32767, 32767, 32767 }, hi[3] = { -32768, -32768, -32768 };
+  for (uint32_t i = 0; i < mVals; i++){ int16_t v = mRaw[i]; if (v < lo[i % 3]) lo[i % 3] = v; if (v > hi[i % 3]) hi[i % 3] = v; }
+  int32_t span = 1;
+  for (int a = 0; a < 3; a++) if (hi[a] - lo[a] > span) span = hi[a] - lo[a];
+  // in place: byte i is written after value i is read, and before value i+1
+  for (uint32_t i = 0; i < mVals; i++) xyz[i] = (uint8_t)(((int32_t)(mRaw[i] - lo[i % 3]) * 255 + span / 2) / span);
+  return true;
+}
+
+#ifdef ARDUINO
+#include <Preferences.h>
+
+bool mapLoad(uint8_t* xyz){
+  Preferences p;
+  p.begin("map", true);
+  size_t len = p.getBytesLength("xyz");
+  bool ok = len && len % 3 == 0 && len <= NUM_LEDS * 3 && p.getBytes("xyz", xyz, len) == len;
+  p.end();
+  if (ok) gMap.build(xyz, len / 3); else gMap.count = 0;
+  return ok;
+}
+
+bool mapSave(const uint8_t* xyz, uint16_t n){
+  Preferences p;
+  if (!p.begin("map", false)) return false;
+  bool ok = n ? p.putBytes("xyz", xyz, n * 3) == (size_t)n * 3 : !p.isKey("xyz") || p.remove("xyz");
+  p.end();
+  return ok;
+}
+#endif
@@ -0,0 +1,67 @@
+#include "power.h"
+#include "litset.h"
+
+PowerAcct gPower = { {}, { NUM_LEDS }, 1 };   // until layoutLoad()
+
+void PowerAcct::setLayout(const Layout& l){
+  count = l.count;
+  uint16_t e = 0;
+  for (uint8_t s = 0; s < count; s++){ e += l.seg[s].count; end[s] = e; }
+  clear();
+}
+
+void powerAdd(CRGB* px, LitSet& lit, uint16_t i, const CRGB& c){
+  CRGB& p = px[i];
+  PowerSum& a = gPower.seg[gPower.segOf(i)];
+  a.r -= p.r; a.g -= p.g; a.b -= p.b;
+  p += c;
+  a.r += p.r; a.g += p.g; a.b += p.b;
+  lit.mark(i);
+}
+
+void powerFill(CRGB* px, uint16_t n, const CRGB& c){
+  fill_solid(px, n, c);
+  uint16_t start = 0;
+  for (uint8_t s = 0; s < gPower.count; s++){
+    uint16_t e = s + 1 < gPower.count && gPower.end[s] < n ? gPower.end[s] : n;
+    uint32_t k = e > start ? e - start : 0;
+    gPower.seg[s] = { c.r * k, c.g * k, c.b * k };
+    start = gPower.end[s];
+  }
+}
+
+void powerCopy(CRGB* dst, const CRGB* src, uint16_t n){
+  powerFillWith(dst, n, [src](uint16_t i){ return src[i]; });
+}
+
+void powerScan(const CRGB* px, uint16_t n){
+  uint16_t i = 0;
+  for (uint8_t s = 0; s < gPower.count; s++){
+    PowerSum a = {};
+    for (uint16_t e = s + 1 < gPower.count && gPower.end[s] < n ? gPower.end[s] : n; i < e; i++){ a.r += px[i].r; a.g += px[i].g; a.b += px[i].b; }
+    gPower.seg[s] = a;
+  }
+}
+
+uint32_t powerUnscaledMw(const PowerSum& s, uint16_t pixels){
+  return ((s.r * POWER_RED_MW) >> 8) + ((s.g * POWER_GREEN_MW) >> 8) + ((s.b * POWER_BLUE_MW) >> 8) + POWER_DARK_MW * pixels;
+}
+
+void powerLimit(const Layout& l, uint8_t brightness, uint32_t maxMa, PowerOut& out){
+  uint32_t mw[MAX_SEGMENTS], total = 0;
+  for (uint8_t s = 0; s < l.count; s++){ mw[s] = powerUnscaledMw(gPower.seg[s], l.seg[s].count); total += mw[s]; }
+  // whole install first, exactly as FastLED's limiter; then each segment's own budget
+  uint8_t b = brightness;
+  uint32_t req = total * brightness / 256;
+  if (req > POWER_VOLTS * maxMa) b = (uint32_t)brightness * (POWER_VOLTS * maxMa) / req;
+  out.clamped = b < brightness;
+  out.totalMa = 0;
+  for (uint8_t s = 0; s < l.count; s++){
+    uint8_t sb = b;
+    uint32_t sreq = mw[s] * b / 256, cap = POWER_VOLTS * (uint32_t)l.seg[s].ma;
+    if (cap && sreq > cap){ sb = (uint32_t)b * cap / sreq; out.clamped = true; }
+    out.scale[s] = sb;
+    out.ma[s] = mw[s] * sb / 256 / POWER_VOLTS;
+    out.totalMa += out.ma[s];
+  }
+}
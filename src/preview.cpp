@@ -0,0 +1,42 @@
+#include "preview.h"
+
+uint8_t gPreviewFps = 10;
+
+static uint8_t* putOp(uint8_t* o, uint32_t run, uint8_t op){
+  uint32_t v = (run << 2) | op;
+  while (v >= 0x80){ *o++ = (uint8_t)(v | 0x80); v >>= 7; }
+  *o++ = (uint8_t)v;
+  return o;
+}
+
+static inline uint8_t* putRGB(uint8_t* o, const CRGB& c){ o[0] = c.r; o[1] = c.g; o[2] = c.b; return o + 3; }
+
+size_t previewEncode(const CRGB* cur, CRGB* prev, uint16_t n, bool key, uint8_t* out){
+  if (key) for (uint16_t i = 0; i < n; i++) prev[i] = CRGB::Black;
+  uint8_t* o = out;
+  *o++ = key ? PV_FLAG_KEY : 0;
+  *o++ = n & 0xFF; *o++ = n >> 8;
+
+  uint16_t i = 0;
+  while (i < n){
+    uint16_t j = i;
+    while (j < n && cur[j] == prev[j]) j++;
+    if (j > i){ o = putOp(o, j - i, PV_SKIP); i = j; continue; }
+
+    while (j < n && cur[j] == cur[i]) j++;
+    if (j - i >= 3){ o = putOp(o, j - i, PV_REPEAT); o = putRGB(o, cur[i]); i = j; continue; }
+
+    // literal run: stop where a skip (>=2) or repeat (>=3) would be cheaper
+    j = i + 1;
+    while (j < n){
+      if (cur[j] == prev[j] && j + 1 < n && cur[j + 1] == prev[j + 1]) break;
+      if (j + 2 < n && cur[j] == cur[j + 1] && cur[j] == cur[j + 2]) break;
+      j++;
+    }
+    o = putOp(o, j - i, PV_LITERAL);
+    for (uint16_t k = i; k < j; k++) o = putRGB(o, cur[k]);
+    i = j;
+  }
+  for (uint16_t k = 0; k < n; k++) prev[k] = cur[k];
+  return o - out;
+}
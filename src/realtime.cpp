@@ -0,0 +1,177 @@
+#include "realtime.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <lwip/sockets.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+RtIngest gRt;
+
+// ---- DDP ----
+// [flags][seq][type][id][offset:4 BE][len:2 BE][timecode:4 if flagged] data
+#define DDP_VER_MASK 0xC0
+#define DDP_VER1     0x40
+#define DDP_TIMECODE 0x10
+#define DDP_QUERY    0x02
+#define DDP_PUSH     0x01
+#define DDP_ID_DISPLAY 1
+#define DDP_ID_ALL     255
+
+static inline uint16_t be16(const uint8_t* p){ return (uint16_t)(p[0] << 8 | p[1]); }
+static inline uint32_t be32(const uint8_t* p){ return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | p[2] << 8 | p[3]; }
+
+static RtSpan clip(RtSpan s, uint32_t off, uint32_t len, uint16_t n){
+  uint32_t cap = (uint32_t)n * 3;
+  s.off = off < cap ? off : cap;
+  s.len = off < cap ? (len < cap - off ? len : cap - off) : 0;
+  return s;
+}
+
+RtSpan rtParseDdp(const uint8_t* h, size_t got, uint16_t n){
+  RtSpan s = {};
+  s.drop = true;
+  if (got < 10 || (h[0] & DDP_VER_MASK) != DDP_VER1) return s;
+  s.hdr = (h[0] & DDP_TIMECODE) ? 14 : 10;
+  if (got < s.hdr || (h[0] & DDP_QUERY)) return s;
+  if (h[3] != DDP_ID_DISPLAY && h[3] != DDP_ID_ALL) return s;
+  s = clip(s, be32(h + 4), be16(h + 8), n);
+  s.drop = false; s.data = true;
+  s.push = h[0] & DDP_PUSH;
+  return s;
+}
+
+// ---- E1.31 ----
+#define E131_HDR          126   // root + framing + DMP layers, incl. start code
+#define E131_SYNC_LEN     49
+#define E131_ROOT_DATA    0x00000004
+#define E131_ROOT_EXT     0x00000008
+#define E131_FRAME_DATA   0x00000002
+#define E131_EXT_SYNC     0x00000001
+#define E131_OPT_PREVIEW  0x80
+#define E131_OPT_TERM     0x40
+static const uint8_t kAcnId[12] = { 'A','S','C','-','E','1','.','1','7',0,0,0 };
+
+RtSpan rtParseE131(const uint8_t* h, size_t got, uint16_t n){
+  RtSpan s = {};
+  s.drop = true;
+  if (got < E131_SYNC_LEN || be16(h) != 0x0010 || memcmp(h + 4, kAcnId, 12) != 0) return s;
+  uint32_t root = be32(h + 18), frame = be32(h + 40);
+  if (root == E131_ROOT_EXT && frame == E131_EXT_SYNC){
+    s.hdr = E131_SYNC_LEN; s.sync = true; s.drop = false;
+    s.universe = be16(h + 45);
+    return s;
+  }
+  if (root != E131_ROOT_DATA || frame != E131_FRAME_DATA || got < E131_HDR) return s;
+  if (h[117] != 0x02 || h[118] != 0xA1 || h[125] != 0) return s;  // DMP set-property, DMX start code 0
+  s.hdr = E131_HDR;
+  s.universe = be16(h + 113);
+  s.syncUniverse = be16(h + 109);
+  s.terminated = h[112] & E131_OPT_TERM;
+  if (h[112] & (E131_OPT_PREVIEW | E131_OPT_TERM)){ s.drop = false; return s; }  // visualiser data / stream end
+  if (s.universe < RT_E131_UNIVERSE) return s;
+  uint16_t slots = be16(h + 123);
+  uint32_t u = s.universe - RT_E131_UNIVERSE;
+  uint32_t len = slots > 1 ? slots - 1 : 0;
+  if (len > RT_E131_PIXELS * 3) len = RT_E131_PIXELS * 3;
+  s = clip(s, u * RT_E131_PIXELS * 3, len, n);
+  s.drop = false; s.data = true;
+  // without a sync address the universe holding the last pixel ends the frame
+  s.push = !s.syncUniverse && n && u == (uint32_t)(n - 1) / RT_E131_PIXELS;
+  return s;
+}
+
+// ---- Sockets ----
+static int openUdp(uint16_t port){
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) return -1;
+  sockaddr_in a = {};
+  a.sin_family = AF_INET; a.sin_port = htons(port); a.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(fd, (sockaddr*)&a, sizeof(a)) < 0){ close(fd); return -1; }
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  return fd;
+}
+
+bool RtIngest::begin(uint16_t ddpPort, uint16_t e131Port){
+  mDdp = openUdp(ddpPort);
+  mE131 = openUdp(e131Port);
+  // sACN multicast groups 239.255.<universe hi>.<universe lo>; unicast works
+  // regardless, so a failed join is not an error
+  for (uint16_t u = 0; mE131 >= 0 && u < RT_MAX_UNIVERSES; u++){
+    uint16_t uni = RT_E131_UNIVERSE + u;
+    ip_mreq m = {};
+    m.imr_multiaddr.s_addr = htonl(0xEFFF0000u | uni);
+    m.imr_interface.s_addr = htonl(INADDR_ANY);
+    setsockopt(mE131, IPPROTO_IP, IP_ADD_MEMBERSHIP, &m, sizeof(m));
+  }
+  return mDdp >= 0 && mE131 >= 0;
+}
+
+bool RtIngest::active() const {
+  return mHeard && millis() - mLastMs < RT_TIMEOUT_MS;
+}
+
+// Sequence check. Counts gaps as lost; E1.31 packets up to 20 behind the
+// last one are stale and dropped, as the spec asks.
+bool RtIngest::sequence(bool ddp, const uint8_t* h){
+  if (ddp){
+    uint8_t seq = h[1] & 0x0F;           // 1..15, 0 = sender does not number
+    if (seq && mDdpSeq) stats.lost += (seq - mDdpSeq + 14) % 15;
+    mDdpSeq = seq;
+    return true;
+  }
+  uint16_t u = be16(h + 113) - RT_E131_UNIVERSE;
+  if (u >= RT_MAX_UNIVERSES) return true;
+  int8_t d = (int8_t)(h[111] - (uint8_t)(mUniSeq[u] + 1));
+  if (d < 0 && d > -20) return false;
+  stats.lost += d > 0 ? d : 0;
+  mUniSeq[u] = h[111];
+  return true;
+}
+
+// One datagram: 1 = frame complete, 0 = consumed, -1 = nothing waiting.
+int RtIngest::recvOne(int fd, bool ddp, CRGB* px, uint16_t n){
+  uint8_t h[E131_HDR];
+  ssize_t got = recv(fd, h, ddp ? 14 : E131_HDR, MSG_PEEK | MSG_DONTWAIT);
+  if (got < 0) return -1;
+  RtSpan s = ddp ? rtParseDdp(h, got, n) : rtParseE131(h, got, n);
+  bool fresh = !s.drop && (s.sync || sequence(ddp, h));
+  if (!fresh || !s.len) s.len = 0;
+
+  iovec iov[2] = { { h, (size_t)(s.drop ? 1 : s.hdr) }, { (uint8_t*)px + s.off, s.len } };
+  msghdr m = {};
+  m.msg_iov = iov; m.msg_iovlen = s.len ? 2 : 1;
+  recvmsg(fd, &m, MSG_DONTWAIT);
+  stats.packets++;
+  if (!fresh){ stats.ignored++; return 0; }
+
+  if (s.terminated){ mHeard = false; return 0; }
+  if (s.sync){
+    if (!mSyncUniverse || s.universe != mSyncUniverse) return 0;
+  } else {
+    if (!s.data){ stats.ignored++; return 0; }
+    if (!ddp) mSyncUniverse = s.syncUniverse;
+    if (!s.push) { mHeard = true; mLastMs = millis(); return 0; }
+  }
+  mHeard = true; mLastMs = millis();
+  stats.frames++;
+  return 1;
+}
+
+bool RtIngest::poll(CRGB* px, uint16_t n){
+  // bounded so a flood cannot hold the loop; the rest waits in the socket
+  for (int budget = 64; budget > 0; budget--){
+    int a = mDdp >= 0 ? recvOne(mDdp, true, px, n) : -1;
+    if (a > 0) return true;
+    int b = mE131 >= 0 ? recvOne(mE131, false, px, n) : -1;
+    if (b > 0) return true;
+    if (a < 0 && b < 0) break;
+  }
+  return false;
+}
@@ -0,0 +1,232 @@
+#include "sched_json.h"
+#include <string.h>
+#include "effects.h"
+
+// Keys the parser understands inside an item; SF_* overrides follow K_PARAMS
+// in SchedField order.
+enum { K_MODE, K_SECONDS, K_MINUTES, K_MS, K_XFADE, K_PARAMS };
+static const char* const kKeys[] = { "mode", "seconds", "minutes", "ms", "xfade",
+                                     "bright", "density", "speed", "hue", "sat", "life", "fade", "drift" };
+static_assert(sizeof(kKeys) / sizeof(kKeys[0]) == K_PARAMS + SF_COUNT, "one key per SchedField");
+
+#define SJ_MAX_MILLI 1000000000000000LL   // saturation for number values (x1000)
+
+static inline bool isWs(uint8_t c){ return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+static inline bool isDigit(uint8_t c){ return c >= '0' && c <= '9'; }
+static inline bool isHex(uint8_t c){ return isDigit(c) || ((c | 0x20) >= 'a' && (c | 0x20) <= 'f'); }
+static inline int64_t clampI(int64_t v, int64_t lo, int64_t hi){ return v < lo ? lo : v > hi ? hi : v; }
+
+void SchedParser::begin(){
+  mSched.count = 0;
+  mDropped = 0;
+  mPos = 0;
+  mState = ST_VALUE;
+  mDepth = mItemsDepth = 0;
+  mObjBits = 0;
+  mKeyLen = 0; mKey[0] = 0;
+  mKeyItems = false;
+  mFirst = false;
+}
+
+bool SchedParser::feed(const uint8_t* p, size_t n){
+  size_t i = 0;
+  while (i < n && mState != ST_ERROR){
+    // string bodies are most of a document and need no state change per byte
+    if (mState == ST_STRING) while (i < n && p[i] != '"' && p[i] != '\\' && p[i] >= 0x20) i++;
+    if (i < n && step(p[i]) && mState != ST_ERROR) i++;
+  }
+  mPos += i;
+  return mState != ST_ERROR;
+}
+
+bool SchedParser::finish(){
+  // a bare top-level number has no terminator; anything else must be closed
+  if (mState == ST_NUMBER) step(' ');
+  return mState == ST_DONE;
+}
+
+uint8_t SchedParser::keyId() const {
+  if (mKeyLen >= KEY_LEN) return 0xFF;
+  for (uint8_t k = 0; k < K_PARAMS + SF_COUNT; k++) if (strcmp(mKey, kKeys[k]) == 0) return k;
+  return 0xFF;
+}
+
+bool SchedParser::open(bool object){
+  if (mDepth == MAX_DEPTH){ mState = ST_ERROR; return true; }
+  bool rootItems = mDepth == 0 || (mDepth == 1 && (mObjBits & 1) && mKeyItems);
+  if (!object && !mItemsDepth && rootItems) mItemsDepth = mDepth + 1;
+  if (object && mItemsDepth && mDepth == mItemsDepth){ memset(&mItem, 0, sizeof(mItem)); mItemTimed = false; }
+  if (object) mObjBits |= 1 << mDepth; else mObjBits &= ~(1 << mDepth);
+  mDepth++;
+  mFirst = true;
+  mState = object ? ST_KEY_OR_END : ST_VALUE;
+  return true;
+}
+
+bool SchedParser::close(bool object){
+  if (!mDepth || ((mObjBits >> (mDepth - 1)) & 1) != object){ mState = ST_ERROR; return true; }
+  mDepth--;
+  if (object && mItemsDepth && mDepth == mItemsDepth){
+    if (mItemTimed && mItem.mode < MODE_COUNT && mSched.count < MAX_SCHEDULE_ITEMS) mSched.items[mSched.count++] = mItem;
+    else mDropped++;
+  }
+  endValue();
+  return true;
+}
+
+void SchedParser::endValue(){ mState = mDepth ? ST_NEXT : ST_DONE; }
+
+void SchedParser::scalar(int64_t milli){
+  bool inItem = mItemsDepth && mDepth == mItemsDepth + 1 && ((mObjBits >> (mDepth - 1)) & 1);
+  if (!inItem) return;
+  uint8_t k = keyId();
+  int64_t ms;
+  switch (k){
+    case 0xFF: return;
+    case K_MODE: mItem.mode = (uint8_t)clampI(milli / 1000, 0, 255); return;
+    case K_XFADE: mItem.xfade_ms = (uint16_t)clampI(milli, 0, 60000); return;
+    case K_SECONDS: ms = milli; break;
+    case K_MINUTES: ms = clampI(milli, -SJ_MAX_MILLI, SJ_MAX_MILLI / 60) * 60; break;
+    case K_MS: ms = milli / 1000; break;
+    default:
+      mItem.val[k - K_PARAMS] = (uint8_t)clampI(milli / 1000, 0, 255);
+      mItem.set |= 1 << (k - K_PARAMS);
+      return;
+  }
+  mItem.duration_ms = (uint32_t)clampI(ms, 0, 0xFFFFFFFF);
+  mItemTimed = mItem.duration_ms > 0;
+}
+
+bool SchedParser::step(uint8_t c){
+  switch (mState){
+    case ST_VALUE:
+      if (isWs(c)) return true;
+      if (c == '{') return open(true);
+      if (c == '[') return open(false);
+      if (c == ']' && mFirst) return close(false);
+      if (c == '"'){ mInKey = false; mState = ST_STRING; return true; }
+      if (c == '-' || isDigit(c)){
+        mState = ST_NUMBER; mNumPart = 0; mNeg = false; mExpNeg = false;
+        mInt = 0; mFracMilli = 0; mFracDigits = 0; mExpVal = 0;
+        return false;
+      }
+      if (c == 't' || c == 'f' || c == 'n'){
+        mLit = c == 't' ? "true" : c == 'f' ? "false" : "null";
+        mLitIdx = 1; mState = ST_LITERAL;
+        return true;
+      }
+      break;
+
+    case ST_KEY_OR_END:
+      if (isWs(c)) return true;
+      if (c == '"'){ mKeyLen = 0; mKey[0] = 0; mState = ST_KEY; return true; }
+      if (c == '}' && mFirst) return close(true);
+      break;
+
+    case ST_KEY:
+      if (c == '"'){
+        if (mDepth == 1) mKeyItems = mKeyLen < KEY_LEN && strcmp(mKey, "items") == 0;
+        mState = ST_COLON;
+        return true;
+      }
+      if (c == '\\'){ mInKey = true; mKeyLen = KEY_LEN; mState = ST_STR_ESC; return true; }  // escaped keys are never ours
+      if (c < 0x20) break;
+      if (mKeyLen < KEY_LEN - 1){ mKey[mKeyLen++] = (char)c; mKey[mKeyLen] = 0; }
+      else mKeyLen = KEY_LEN;
+      return true;
+
+    case ST_COLON:
+      if (isWs(c)) return true;
+      if (c == ':'){ mFirst = false; mState = ST_VALUE; return true; }
+      break;
+
+    case ST_STRING:
+      if (c == '"'){ endValue(); return true; }
+      if (c == '\\'){ mState = ST_STR_ESC; return true; }
+      if (c < 0x20) break;
+      return true;
+
+    case ST_STR_ESC:
+      if (c == 'u'){ mHex = 4; mState = ST_HEX; return true; }
+      if (!strchr("\"\\/bfnrt", c) || !c) break;
+      mState = mInKey ? ST_KEY : ST_STRING;
+      return true;
+
+    case ST_HEX:
+      if (!isHex(c)) break;
+      if (--mHex == 0) mState = mInKey ? ST_KEY : ST_STRING;
+      return true;
+
+    case ST_NUMBER:
+      // -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?  parts: 0 start, 1 after
+      // '-', 2 int digits, 3 leading 0, 4 '.', 5 frac, 6 'e', 7 exp sign, 8 exp
+      switch (mNumPart){
+        case 0: if (c == '-'){ mNeg = true; mNumPart = 1; return true; }  // fallthrough
+        case 1:
+          if (c == '0'){ mNumPart = 3; return true; }
+          if (isDigit(c)){ mInt = c - '0'; mNumPart = 2; return true; }
+          break;
+        case 2:
+          if (isDigit(c)){ if (mInt < SJ_MAX_MILLI) mInt = mInt * 10 + (c - '0'); return true; }  // fallthrough
+        case 3:
+          if (c == '.'){ mNumPart = 4; return true; }
+          if (c == 'e' || c == 'E'){ mNumPart = 6; return true; }
+          goto number_end;
+        case 4: case 5:
+          if (isDigit(c)){
+            if (mFracDigits < 3){ mFracMilli = mFracMilli * 10 + (c - '0'); mFracDigits++; }
+            mNumPart = 5;
+            return true;
+          }
+          if (mNumPart == 4) break;
+          if (c == 'e' || c == 'E'){ mNumPart = 6; return true; }
+          goto number_end;
+        case 6:
+          if (c == '+' || c == '-'){ mExpNeg = c == '-'; mNumPart = 7; return true; }  // fallthrough
+        case 7:
+          if (isDigit(c)){ mExpVal = c - '0'; mNumPart = 8; return true; }
+          break;
+        case 8:
+          if (isDigit(c)){ if (mExpVal < 100) mExpVal = mExpVal * 10 + (c - '0'); return true; }
+          goto number_end;
+      }
+      break;
+    number_end: {
+      while (mFracDigits < 3){ mFracMilli *= 10; mFracDigits++; }
+      int64_t v = clampI(mInt, 0, SJ_MAX_MILLI) * 1000 + mFracMilli;
+      for (int16_t e = 0; e < mExpVal && v; e++){
+        if (mExpNeg) v /= 10; else if ((v = v * 10) > SJ_MAX_MILLI){ v = SJ_MAX_MILLI; break; }
+      }
+      scalar(mNeg ? -v : v);
+      endValue();
+      return false;   // the terminator belongs to whatever follows
+    }
+
+    case ST_LITERAL:
+      if (c != (uint8_t)mLit[mLitIdx]) break;
+      if (mLit[++mLitIdx]) return true;
+      if (mLit[0] != 'n') scalar(mLit[0] == 't' ? 1000 : 0);
+      endValue();
+      return true;
+
+    case ST_NEXT:
+      if (isWs(c)) return true;
+      if (c == ','){
+        mFirst = false;
+        mState = ((mObjBits >> (mDepth - 1)) & 1) ? ST_KEY_OR_END : ST_VALUE;
+        return true;
+      }
+      if (c == '}') return close(true);
+      if (c == ']') return close(false);
+      break;
+
+    case ST_DONE:
+      if (isWs(c)) return true;
+      break;
+
+    case ST_ERROR:
+      return true;
+  }
+  mState = ST_ERROR;
+  return true;
+}
@@ -0,0 +1,121 @@
+#include <stdlib.h>
+#include "segments.h"
+
+Layout gLayout = { 1, { { LED_PIN, NUM_LEDS, 0 } } };
+
+// Pins a segment may use. Each one instantiates a FastLED controller, so the
+// list is kept to the usual free output pins of an ESP32 devkit.
+#define LAYOUT_PINS(X) X(4) X(5) X(13) X(14) X(16) X(17) X(18) X(19) X(21) X(22) X(23) X(25) X(26) X(27) X(32) X(33)
+
+static bool pinSupported(uint8_t pin){
+  switch (pin){
+#define X(p) case p:
+    LAYOUT_PINS(X) return true;
+#undef X
+    default: return false;
+  }
+}
+
+uint16_t layoutTotal(const Layout& l){
+  uint32_t n = 0;
+  for (uint8_t i = 0; i < l.count; i++) n += l.seg[i].count;
+  return n > 0xFFFF ? 0xFFFF : (uint16_t)n;
+}
+
+bool layoutValid(const Layout& l){
+  if (l.count < 1 || l.count > MAX_SEGMENTS) return false;
+  uint32_t n = 0;
+  for (uint8_t i = 0; i < l.count; i++){
+    if (!l.seg[i].count || !pinSupported(l.seg[i].pin)) return false;
+    for (uint8_t j = 0; j < i; j++) if (l.seg[j].pin == l.seg[i].pin) return false;
+    n += l.seg[i].count;
+  }
+  return n <= NUM_LEDS;
+}
+
+bool layoutParse(const char* s, Layout& l){
+  l.count = 0;
+  while (*s && l.count < MAX_SEGMENTS){
+    char* end;
+    long pin = strtol(s, &end, 10);
+    if (end == s || *end != ':') return false;
+    s = end + 1;
+    long n = strtol(s, &end, 10);
+    if (end == s || pin < 0 || pin > 255 || n <= 0 || n > 0xFFFF) return false;
+    long ma = 0;
+    if (*end == ':'){
+      s = end + 1;
+      ma = strtol(s, &end, 10);
+      if (end == s || ma < 0 || ma > 0xFFFF) return false;
+    }
+    l.seg[l.count++] = { (uint8_t)pin, (uint16_t)n, (uint16_t)ma };
+    s = end;
+    if (*s == ',') s++;
+    else if (*s) return false;
+  }
+  return !*s && layoutValid(l);
+}
+
+uint32_t layoutWireUs(const Layout& l){
+  uint16_t longest = 0;
+  for (uint8_t i = 0; i < l.count; i++) if (l.seg[i].count > longest) longest = l.seg[i].count;
+  return (uint32_t)longest * WIRE_US_PER_PIXEL + WIRE_LATCH_US;
+}
+
+#ifdef ARDUINO
+#include <Preferences.h>
+#include "effects.h"
+#include "metrics.h"
+#include "power.h"
+
+static CLEDController* ctl[MAX_SEGMENTS];
+
+bool layoutLoad(){
+  Preferences p;
+  Layout l;
+  p.begin("layout", true);
+  bool ok = p.getBytesLength("segs") == sizeof(l) && p.getBytes("segs", &l, sizeof(l)) == sizeof(l) && layoutValid(l);
+  p.end();   // anything else keeps the default layout
+  if (ok) gLayout = l;
+  gNumLeds = layoutTotal(gLayout);
+  gPower.setLayout(gLayout);
+  return ok;
+}
+
+void layoutSave(const Layout& l){
+  Preferences p;
+  p.begin("layout", false);
+  p.putBytes("segs", &l, sizeof(l));
+  p.end();
+}
+
+static CLEDController* addSegment(uint8_t pin, CRGB* px, uint16_t n){
+  switch (pin){
+#define X(p) case p: return &FastLED.addLeds<LED_TYPE, p, COLOR_ORDER>(px, n);
+    LAYOUT_PINS(X)
+#undef X
+    default: return nullptr;
+  }
+}
+
+void layoutAttach(){
+  uint16_t start = 0;
+  for (uint8_t i = 0; i < gLayout.count; i++){
+    ctl[i] = addSegment(gLayout.seg[i].pin, leds + start, gLayout.seg[i].count);
+    start += gLayout.seg[i].count;
+  }
+}
+
+// Each controller shows at its segment's own scale (power.h). The RMT driver
+// only waits once every controller has started, so the segments still go
+// out in parallel.
+void layoutShow(const CRGB* px, const uint8_t* scale){
+  MET_T0(t0);
+  uint16_t start = 0;
+  for (uint8_t i = 0; i < gLayout.count; i++){
+    if (ctl[i]){ ctl[i]->setLeds((CRGB*)px + start, gLayout.seg[i].count); ctl[i]->showLeds(scale[i]); }
+    start += gLayout.seg[i].count;
+  }
+  MET_STAGE(MS_SHOW, t0);
+}
+#endif
@@ -0,0 +1,182 @@
+#include "wifi_manager.h"
+#include <string.h>
+
+static int findNet(const WifiList& l, const char* ssid){
+  for (int i = 0; i < l.count; i++) if (strcmp(l.net[i].ssid, ssid) == 0) return i;
+  return -1;
+}
+
+void WifiManager::enter(WifiState s, uint32_t now){ mState = s; mSince = now; }
+
+void WifiManager::begin(const WifiList& nets, const WifiFast* fast, uint32_t now){
+  mNets = nets;
+  int i = fast ? findNet(mNets, fast->ssid) : -1;
+  if (i >= 0 && fast->channel){
+    mFast = *fast; mCur = i;
+    mDrv.staMode(false);
+    mDrv.connect(mNets.net[i].ssid, mNets.net[i].pass, mFast.bssid, mFast.channel);
+    enter(WS_FAST, now);
+  } else if (mNets.count){
+    mDrv.staMode(false);
+    mDrv.scanStart();
+    enter(WS_SCAN, now);
+  } else {
+    mDrv.startAP();
+    enter(WS_AP, now);
+  }
+}
+
+void WifiManager::retry(uint32_t now){
+  if (mState == WS_SCAN || mState == WS_CONNECT || !mNets.count) return;
+  mDrv.staMode(mState == WS_AP);   // keep the AP up for whoever asked
+  mDrv.scanStart();
+  enter(WS_SCAN, now);
+}
+
+void WifiManager::connectNext(uint32_t now){
+  if (mCandNext < mCandCount){
+    const Cand& c = mCand[mCandNext++];
+    mCur = c.net;
+    mDrv.connect(mNets.net[c.net].ssid, mNets.net[c.net].pass, c.bssid, c.channel);
+    enter(WS_CONNECT, now);
+  } else {
+    mDrv.startAP();
+    enter(WS_AP, now);
+  }
+}
+
+void WifiManager::tick(uint32_t now){
+  uint32_t age = now - mSince;
+  switch (mState){
+    case WS_IDLE: break;
+
+    case WS_FAST: {
+      WifiLink l = mDrv.link();
+      if (l == WL_LINK_UP){ enter(WS_UP, now); break; }
+      if (l == WL_LINK_FAILED || age > WIFI_FAST_MS){
+        mDrv.disconnect();
+        mDrv.scanStart();
+        enter(WS_SCAN, now);
+      }
+      break;
+    }
+
+    case WS_SCAN: {
+      static WifiSeen seen[32];
+      int n = mDrv.scanResults(seen, 32);
+      if (n < 0 && age <= WIFI_SCAN_MS) break;
+      // saved networks that are on the air, strongest AP for each, best first
+      mCandCount = mCandNext = 0;
+      for (uint8_t i = 0; i < mNets.count; i++){
+        int best = -1;
+        for (int k = 0; k < n; k++)
+          if (strcmp(seen[k].ssid, mNets.net[i].ssid) == 0 && (best < 0 || seen[k].rssi > seen[best].rssi)) best = k;
+        if (best < 0) continue;
+        Cand c = { i, {}, seen[best].channel, seen[best].rssi };
+        memcpy(c.bssid, seen[best].bssid, 6);
+        uint8_t j = mCandCount++;
+        for (; j > 0 && mCand[j - 1].rssi < c.rssi; j--) mCand[j] = mCand[j - 1];
+        mCand[j] = c;
+      }
+      connectNext(now);
+      break;
+    }
+
+    case WS_CONNECT: {
+      WifiLink l = mDrv.link();
+      if (l == WL_LINK_UP){
+        const Cand& c = mCand[mCandNext - 1];
+        WifiFast f = {};
+        memcpy(f.ssid, mNets.net[mCur].ssid, sizeof(f.ssid));
+        memcpy(f.bssid, c.bssid, 6);
+        f.channel = c.channel;
+        if (memcmp(&f, &mFast, sizeof(f)) != 0){ mFast = f; fastChanged = true; }
+        mDrv.staMode(false);   // drops the fallback AP if it was up
+        enter(WS_UP, now);
+      } else if (l == WL_LINK_FAILED || age > WIFI_CONNECT_MS){
+        mDrv.disconnect();
+        connectNext(now);
+      }
+      break;
+    }
+
+    case WS_UP:
+      if (mDrv.link() == WL_LINK_UP) break;
+      // link lost: same AP first, it is usually a blip
+      if (mFast.channel && mCur < mNets.count){
+        mDrv.connect(mNets.net[mCur].ssid, mNets.net[mCur].pass, mFast.bssid, mFast.channel);
+        enter(WS_FAST, now);
+      } else {
+        mDrv.scanStart();
+        enter(WS_SCAN, now);
+      }
+      break;
+
+    case WS_AP:
+      if (mNets.count && age > WIFI_AP_RETRY_MS && mDrv.apClients() == 0) retry(now);
+      break;
+  }
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <WiFi.h>
+
+// Station/AP via WiFi.h. Disconnect events mark a join attempt as failed, so
+// a wrong password or a vanished AP ends the attempt without the timeout.
+class Esp32Wifi : public WifiDriver {
+public:
+  void staMode(bool keepAp) override {
+    if (!mHooked){
+      WiFi.onEvent([this](arduino_event_id_t, arduino_event_info_t info){
+        if (info.wifi_sta_disconnected.reason != WIFI_REASON_ASSOC_LEAVE) mFailed = true;  // not our own disconnect()
+      }, ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+      mHooked = true;
+    }
+    WiFi.mode(keepAp ? WIFI_AP_STA : WIFI_STA);
+  }
+  void scanStart() override {
+    WiFi.scanDelete();
+    WiFi.scanNetworks(true, false, false, 120);   // async, ~120 ms per channel
+  }
+  int scanResults(WifiSeen* out, int max) override {
+    int n = WiFi.scanComplete();
+    if (n == WIFI_SCAN_RUNNING) return -1;
+    int k = 0;
+    for (int i = 0; i < n && k < max; i++, k++){
+      strlcpy(out[k].ssid, WiFi.SSID(i).c_str(), sizeof(out[k].ssid));
+      out[k].rssi = WiFi.RSSI(i);
+      memcpy(out[k].bssid, WiFi.BSSID(i), 6);
+      out[k].channel = WiFi.channel(i);
+    }
+    WiFi.scanDelete();
+    return k;
+  }
+  void connect(const char* ssid, const char* pass, const uint8_t* bssid, uint8_t channel) override {
+    mFailed = false; mAnnounced = false;
+    Serial.printf("WiFi connect to '%s' (ch %u)\n", ssid, channel);
+    WiFi.begin(ssid, pass, channel, bssid, true);
+  }
+  WifiLink link() override {
+    if (WiFi.status() == WL_CONNECTED){
+      if (!mAnnounced){ Serial.print("IP: "); Serial.println(WiFi.localIP()); mAnnounced = true; }
+      return WL_LINK_UP;
+    }
+    return mFailed ? WL_LINK_FAILED : WL_LINK_CONNECTING;
+  }
+  void disconnect() override { WiFi.disconnect(false); }
+  void startAP() override {
+    if (WiFi.getMode() & WIFI_AP) return;
+    WiFi.mode(WIFI_AP_STA);   // STA stays available for the periodic rescan
+    WiFi.softAP(WIFI_AP_SSID, WIFI_AP_PASS);
+    Serial.printf("AP mode. Connect to %s then visit http://%s\n", WIFI_AP_SSID, WiFi.softAPIP().toString().c_str());
+  }
+  int apClients() override { return WiFi.softAPgetStationNum(); }
+
+private:
+  volatile bool mFailed = false;
+  bool mHooked = false, mAnnounced = false;
+};
+
+WifiDriver& wifiRadio(){ static Esp32Wifi radio; return radio; }
+#endif
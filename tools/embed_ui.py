@@ -0,0 +1,99 @@
+"""Minify and gzip ui/*.html into include/ui_assets.h.
+
+Runs as a PlatformIO pre-script (extra_scripts = pre:tools/embed_ui.py) or
+standalone: python3 tools/embed_ui.py. The header is only rewritten when its
+contents change, so unchanged UI does not trigger a rebuild.
+
+Each asset is served straight from flash with Content-Encoding: gzip and a
+strong ETag (content hash of the gzipped bytes), so a browser revalidating an
+unchanged page gets a bodiless 304.
+"""
+import gzip
+import hashlib
+import os
+import re
+
+ASSETS = [  # (source, url, content type)
+    ("ui/index.html", "/", "text/html; charset=utf-8"),
+    ("ui/wifi.html", "/wifi", "text/html; charset=utf-8"),
+]
+OUT = "include/ui_assets.h"
+
+
+def minify_css(css):
+    css = re.sub(r"/\*.*?\*/", "", css, flags=re.S)
+    css = re.sub(r"\s+", " ", css)
+    return re.sub(r"\s*([{};:,>])\s*", r"\1", css).replace(";}", "}").strip()
+
+
+def minify_js(js):
+    # Conservative: keep line breaks (ASI), drop indentation, blank lines and
+    # whole-line // comments. Nothing inside a line is touched, so strings
+    # such as 'ws://' are safe.
+    out = []
+    for line in js.split("\n"):
+        line = line.strip()
+        if line and not line.startswith("//"):
+            out.append(line)
+    return "\n".join(out)
+
+
+def minify_html(html):
+    html = re.sub(r"<!--.*?-->", "", html, flags=re.S)
+    parts = re.split(r"(<style>.*?</style>|<script>.*?</script>)", html, flags=re.S)
+    out = []
+    for p in parts:
+        if p.startswith("<style>"):
+            out.append("<style>" + minify_css(p[7:-8]) + "</style>")
+        elif p.startswith("<script>"):
+            out.append("<script>" + minify_js(p[8:-9]) + "</script>")
+        else:
+            p = re.sub(r">\s+<", "><", p)   # whitespace-only gaps between tags
+            out.append(re.sub(r"\s+", " ", p))
+    return "".join(out).strip()
+
+
+def c_name(url):
+    return "UI_" + (re.sub(r"\W", "_", url.strip("/")).upper() or "INDEX")
+
+
+def build(root):
+    lines = ["// Generated by tools/embed_ui.py from ui/; do not edit.", "#pragma once",
+             "#include <stdint.h>", "#ifdef ARDUINO", "#include <Arduino.h>  // PROGMEM", "#else",
+             "#define PROGMEM", "#endif", "",
+             "struct UiAsset { const char* url; const char* type; const uint8_t* gz;"
+             " uint32_t len, rawLen; const char* etag; };", ""]
+    table, report = [], []
+    for src, url, ctype in ASSETS:
+        raw = open(os.path.join(root, src), "rb").read()
+        mini = minify_html(raw.decode("utf-8")).encode("utf-8")
+        gz = gzip.compress(mini, 9, mtime=0)
+        etag = '\\"' + hashlib.sha256(gz).hexdigest()[:16] + '\\"'
+        name = c_name(url)
+        body = "\n".join("  " + ",".join("0x%02x" % b for b in gz[i:i + 16]) + ","
+                         for i in range(0, len(gz), 16))
+        lines += ["// %s: %d bytes raw, %d minified, %d gzipped" % (src, len(raw), len(mini), len(gz)),
+                  "static const uint8_t %s_GZ[] PROGMEM = {\n%s\n};" % (name, body), ""]
+        table.append('  { "%s", "%s", %s_GZ, %d, %d, "%s" },' % (url, ctype, name, len(gz), len(raw), etag))
+        report.append("%-14s %6d raw %6d min %6d gz" % (src, len(raw), len(mini), len(gz)))
+    lines += ["static const UiAsset kUiAssets[] = {"] + table + ["};", ""]
+    return "\n".join(lines), report
+
+
+def main(root):
+    text, report = build(root)
+    path = os.path.join(root, OUT)
+    old = open(path).read() if os.path.exists(path) else None
+    if old != text:
+        with open(path, "w") as f:
+            f.write(text)
+    for r in report:
+        print("embed_ui: " + r)
+
+
+try:
+    Import("env")  # noqa: F821  (PlatformIO)
+    main(env["PROJECT_DIR"])  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        main(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))